@@ -0,0 +1,55 @@
+#ifndef INC_ERRORS_EVENTS_H_
+#define INC_ERRORS_EVENTS_H_
+#include <stdint.h>
+
+#define EVENTS_NB_RECORDS	32U			///< Number of events kept in the ring (power of two)
+#define EVENTS_MAGIC		0x544E5645U	///< Value of eventLog.magic once the ring is initialised ("EVNT")
+
+/**
+ * @brief Enumeration of the types of events recorded
+ */
+typedef enum{
+    EVENT_ERROR = 0,		///< Error returned by a task (source : task, value : error code, with the task as module ID)
+    EVENT_TASK_OVERRUN,		///< Periodic run started a whole period late (source : task, value : lateness in ms)
+    EVENT_FIFO_OVERRUN,		///< ADXL345 FIFO overrun, samples were lost (value : interrupt sources)
+    EVENT_FRAMES_DROPPED,	///< Screen frames dropped while drawings were waiting (value : number of frames)
+    NB_EVENT_TYPES
+}eventType_e;
+
+/**
+ * @brief Structure defining an event record
+ */
+typedef struct{
+    uint32_t	timestamp_ms;	///< System tick at which the event was pushed
+    uint32_t	value;			///< Value of the event (see eventType_e)
+    uint8_t		type;			///< Type of the event (see eventType_e)
+    uint8_t		source;			///< Entity which raised the event (see eventType_e)
+}event_t;
+
+/**
+ * @brief Structure defining a slot of the events ring
+ */
+typedef struct{
+    volatile uint32_t	sequence;	///< Position of the slot once committed, minus 1 (position to reserve it otherwise)
+    event_t				event;		///< Event recorded
+}eventSlot_t;
+
+/**
+ * @brief Structure defining the events ring, readable in RAM by a debugger
+ */
+typedef struct{
+    uint32_t			magic;		///< EVENTS_MAGIC once initialised
+    volatile uint32_t	head;		///< Next position to be reserved by a producer
+    volatile uint32_t	tail;		///< Next position to be read by the consumer
+    volatile uint32_t	nbLost;		///< Number of events lost because the ring was full
+    eventSlot_t			slots[EVENTS_NB_RECORDS];	///< Ring of the events (consumed slots keep their latest event)
+}eventLog_t;
+
+//global variables
+extern eventLog_t eventLog;
+
+void eventsInitialise();
+void eventsPush(eventType_e type, uint8_t source, uint32_t value);
+uint8_t eventsPop(event_t* event);
+
+#endif /* INC_ERRORS_EVENTS_H_ */
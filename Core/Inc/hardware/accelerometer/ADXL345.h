@@ -2,9 +2,7 @@
 #define INC_ADXL345_H_
 #include "main.h"
 #include "errorstack.h"
-
-extern volatile uint16_t	adxlTimer_ms;
-extern volatile uint16_t	adxlSPITimer_ms;
+#include "spiBus.h"
 
 /**
  * @brief Enumeration of the axis of which to get measurements
@@ -16,11 +14,81 @@ typedef enum{
     NB_AXIS
 }axis_e;
 
-errorCode_u	ADXL345initialise(const SPI_TypeDef* handle);
+/**
+ * @brief Enumeration of the measurement profiles available
+ */
+typedef enum{
+    ADXL_PROFILE_PRECISE = 0,	///< 200Hz, 32 samples sliding window (~160ms), new measurement every 8 samples (~40ms)
+    ADXL_PROFILE_FAST,			///< 800Hz, 8 samples sliding window (~10ms), new measurement every 4 samples (~5ms)
+    ADXL_PROFILE_ADAPTIVE,		///< 200Hz, 8 samples sliding window (~40ms) and new measurement every 4 samples (~20ms) while moving, precise profile once settled
+    ADXL_NB_PROFILES
+}adxlProfile_e;
+
+/**
+ * @brief Enumeration of the start-up sequences available
+ */
+typedef enum{
+    ADXL_BOOT_COLD = 0,	///< Full start-up sequence, self-test included
+    ADXL_BOOT_WARM		///< Self-test skipped if it passed since the last power-on reset
+}adxlBootMode_e;
+
+/**
+ * @brief Enumeration of the orientations captured during a six-point calibration
+ */
+typedef enum{
+    ADXL_X_UP = 0,	///< X axis pointing up (opposite to gravity)
+    ADXL_X_DOWN,	///< X axis pointing down
+    ADXL_Y_UP,		///< Y axis pointing up
+    ADXL_Y_DOWN,	///< Y axis pointing down
+    ADXL_Z_UP,		///< Z axis pointing up (device lying flat)
+    ADXL_Z_DOWN,	///< Z axis pointing down (device upside down)
+    ADXL_NB_ORIENTATIONS
+}adxlOrientation_e;
+
+/**
+ * @brief Structure holding the calibration of the ADXL, to be persisted between power cycles
+ */
+typedef struct{
+    int8_t	offsets[NB_AXIS];		///< Hardware offsets programmed in the OFSX, OFSY and OFSZ registers (15.6 mg/LSB)
+    int16_t	zeroValues[NB_AXIS];	///< Values used to compensate measurements since last zeroing (0 in absolute mode)
+}adxlCalibration_t;
+
+/**
+ * @brief Structure holding the measurements computed once per filtered FIFO batch
+ */
+typedef struct{
+    int16_t		rollTenths;			///< Angle between the X and Z axis (in tenths of degrees, zeroing applied)
+    int16_t		pitchTenths;		///< Angle between the Y and Z axis (in tenths of degrees, zeroing applied)
+    int16_t		rollGradeTenths;	///< Tangent of the roll angle (in tenths of percent, zeroing applied, saturated)
+    int16_t		pitchGradeTenths;	///< Tangent of the pitch angle (in tenths of percent, zeroing applied, saturated)
+    int32_t		axes[NB_AXIS];		///< Averaged raw axis values
+    uint32_t	sequence;			///< Number of snapshots published since start-up
+    uint32_t	timestamp_ms;		///< System tick at which the snapshot has been published (in ms)
+    uint8_t		settled;			///< Flag indicating the device is still and the sliding window is full
+}adxlSnapshot_t;
+
+errorCode_u	ADXL345initialise(spiBus_e bus, TIM_TypeDef* timer, adxlBootMode_e bootMode);
 errorCode_u	ADXL345update();
-uint8_t		ADXL345hasChanged(axis_e axis);
-int16_t		getAngleDegreesTenths(axis_e axis);
+void		ADXL345watermarkInterrupt();
+void		ADXL345timerInterrupt();
+const adxlSnapshot_t* ADXL345getSnapshot();
+errorCode_u	ADXL345setProfile(adxlProfile_e profile);
+adxlProfile_e ADXL345getProfile();
+errorCode_u	ADXL345setMotionThresholds(uint16_t movingLSB, uint16_t settledLSB);
+uint8_t		ADXL345isInactive();
+errorCode_u	ADXL345suspend();
+errorCode_u	ADXL345resume();
+errorCode_u	ADXL345calibrateFlat();
+errorCode_u	ADXL345captureOrientation(adxlOrientation_e orientation);
+const adxlCalibration_t* ADXL345getCalibration();
+void		ADXL345setCalibration(const adxlCalibration_t* calibration);
+uint8_t		ADXL345isZeroed();
 void        ADXLzeroDown();
 void        ADXLcancelZeroing();
+#if defined(BENCHMARK)
+void		ADXL345benchmarkLoad(uint16_t step);
+void		ADXL345benchmarkStep(int16_t angles[2]);
+void		ADXL345benchmarkAccuracy(int16_t angleTenths);
+#endif
 
 #endif /* INC_ADXL345_H_ */
@@ -17,6 +17,10 @@
 #define ADXL_SAMPLES_32		0x20		///< 32 samples before triggering an interrupt (+1 to reuse at other places)
 #define ADXL_SAMPLES_16		0x10		///< 16 samples before triggering an interrupt (+1 to reuse at other places)
 #define ADXL_SAMPLES_8		0x08		///< 08 samples before triggering an interrupt (+1 to reuse at other places)
+#define ADXL_SAMPLES_4		0x04		///< 04 samples before triggering an interrupt (+1 to reuse at other places)
+
+// FIFO Status (register 0x39) values
+#define ADXL_FIFO_ENTRIES	0x3F		///< Mask of the number of entries stored in the FIFO
 
 // Interrupt Enable (register 0x2E) configuration values
 #define ADXL_INT_DATARDY	0x80		///< Enable the Data Ready interrupt
@@ -48,9 +52,18 @@
 // Data rate and power mode control (register 0x2C) configuration values
 #define ADXL_POWER_NORMAL	0x00		///< Disable low-power mode
 #define ADXL_POWER_LOW		0x10		///< Enable low-power mode (noisier)
+#define ADXL_RATE_800HZ		0x0D		///< Set the output data rate to 800Hz
+#define ADXL_RATE_400HZ		0x0C		///< Set the output data rate to 400Hz
 #define ADXL_RATE_200HZ		0x0B		///< Set the output data rate to 200Hz 
 #define ADXL_RATE_100HZ		0x0A		///< Set the output data rate to 100Hz
 #define ADXL_RATE_50HZ		0x09		///< Set the output data rate to 50Hz
+#define ADXL_RATE_12_5HZ	0x07		///< Set the output data rate to 12.5Hz
+
+// Activity/Inactivity control (register 0x27) configuration values
+#define ADXL_ACT_AC_COUPLED		0x80	///< Compare the activity to the acceleration at its detection start (DC-coupled otherwise)
+#define ADXL_ACT_XYZ			0x70	///< Detect activity on the X, Y and Z axis
+#define ADXL_INACT_AC_COUPLED	0x08	///< Compare the inactivity to the acceleration at its detection start (DC-coupled otherwise)
+#define ADXL_INACT_XYZ			0x07	///< Detect inactivity on the X, Y and Z axis
 
 // Power Control (register 0x2D) configuration values
 #define ADXL_STANDBY_MODE	0x00		///< Set the Standby mode
@@ -12,22 +12,26 @@ typedef enum{
 }button_e;
 
 /**
- * @brief Structure holding all the timers used by the buttons
+ * @brief Enumeration of the gestures recognised on a button
  */
-typedef struct{
-    volatile uint8_t debouncing_ms;     ///< Timer used for debouncing (in ms)
-    volatile uint16_t holding_ms;       ///< Timer used to detect if a button is held down (in ms)
-    volatile uint8_t risingEdge_ms;     ///< Timer used to detect a rising edge (in ms)
-    volatile uint8_t fallingEdge_ms;    ///< Timer used to detect a falling edge (in ms)
-}gpioTimer_t;
+typedef enum{
+    GESTURE_NONE = 0,		///< No gesture
+    GESTURE_CLICK,			///< Short press, not followed by another one within the double-click window
+    GESTURE_DOUBLE_CLICK,	///< Two short presses within the double-click window
+    GESTURE_LONG_PRESS		///< Press maintained until held down
+}buttonGesture_e;
 
-void buttonsUpdate();
+void buttonsInitialise();
+void buttonsInterrupt();
+uint8_t buttonsUpdate();
+void buttonsResume();
+uint8_t isAnyButtonDown();
 uint8_t isButtonReleased(button_e button);
 uint8_t isButtonPressed(button_e button);
 uint8_t isButtonHeldDown(button_e button);
 uint8_t buttonHasRisingEdge(button_e button);
 uint8_t buttonHasFallingEdge(button_e button);
+buttonGesture_e buttonPopGesture(button_e button);
 
-extern gpioTimer_t buttonsTimers[NB_BUTTONS];
 
 #endif
\ No newline at end of file
@@ -3,13 +3,17 @@
 #include <main.h>
 #include <stdint.h>
 #include "errorstack.h"
+#include "spiBus.h"
+
+#define SSD1306_GRAPH_NB_COLUMNS	62U	///< Number of columns plotted in each graph
 
 /**
  * @brief Enumeration of the printable rotation axis
  */
 typedef enum{
     ROLL = 0,
-    PITCH
+    PITCH,
+    NB_ROTATIONS
 }rotationAxis_e;
 
 /**
@@ -20,15 +24,45 @@ typedef enum{
     RELATIVE
 }referentialType_e;
 
-extern volatile uint16_t	screenTimer_ms;
-extern volatile uint16_t	ssd1306SPITimer_ms;
+/**
+ * @brief Enumeration of the units in which the angles can be printed
+ */
+typedef enum{
+    UNIT_DEGREES = 0,	///< Degrees
+    UNIT_PERCENT,		///< Percent grade (100 * tangent of the angle)
+    UNIT_TOPO,			///< Topo (66 * tangent of the angle, rise in feet over a 66 feet chain)
+    NB_UNITS
+}measureUnit_e;
+
+/**
+ * @brief Structure holding the frame scheduler statistics
+ */
+typedef struct{
+    uint32_t	nbFrames;			///< Number of frames flushed since start-up
+    uint32_t	nbDroppedFrames;	///< Number of frame periods elapsed while drawings were waiting to be flushed
+    uint16_t	framesPerSecond;	///< Frame rate achieved during the latest measurement window
+    uint16_t	cpuLoadPerMille;	///< CPU time spent in SSD1306update() during the latest measurement window (per mille, PROFILING builds only)
+}ssd1306FrameStats_t;
 
 uint8_t isScreenReady();
-errorCode_u SSD1306initialise(SPI_TypeDef* handle, DMA_TypeDef* dma, uint32_t dmaChannel);
+errorCode_u SSD1306initialise(spiBus_e bus);
 errorCode_u SSD1306update();
+errorCode_u SSD1306suspend();
+errorCode_u SSD1306resume();
 errorCode_u SSD1306drawBaseScreen();
-errorCode_u SSD1306_printAngleTenths(int16_t angle, rotationAxis_e rotationAxis);
+errorCode_u SSD1306drawGraphScreen();
+errorCode_u SSD1306_printMeasureTenths(int16_t valueTenths, rotationAxis_e rotationAxis, measureUnit_e unit);
+void SSD1306setAngleHysteresis(uint8_t hysteresisTenths);
+void SSD1306setFrameRate(uint8_t framesPerSecond, uint16_t minInterval_ms);
+const ssd1306FrameStats_t* SSD1306getFrameStats();
 errorCode_u SSD1306_printReferentialIcon(referentialType_e type);
 errorCode_u SSD1306_printHoldIcon(uint8_t status);
+errorCode_u SSD1306_printStabilityIcon(uint8_t settled);
+errorCode_u SSD1306_printBubble(int16_t rollTenths, int16_t pitchTenths);
+errorCode_u SSD1306_printGraphColumn(rotationAxis_e axis, int16_t minTenths, int16_t maxTenths);
+errorCode_u SSD1306_printGraphStats(rotationAxis_e axis, int16_t minTenths, int16_t maxTenths);
+#if defined(BENCHMARK)
+void SSD1306benchmarkRender(const int16_t angles[NB_ROTATIONS]);
+#endif
 
 #endif /* INC_HARDWARE_SCREEN_SSD1306_H_ */
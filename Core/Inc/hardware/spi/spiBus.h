@@ -0,0 +1,84 @@
+#ifndef INC_HARDWARE_SPI_SPIBUS_H_
+#define INC_HARDWARE_SPI_SPIBUS_H_
+#include "main.h"
+#include "errorstack.h"
+#include <stdint.h>
+
+#define SPI_NO_DMA_CHANNEL	0U	///< Value used as reception channel by a transmit-only bus
+
+/**
+ * @brief Enumeration of the SPI buses
+ */
+typedef enum{
+    SPI_BUS_1 = 0,	///< Bus used by the accelerometer
+    SPI_BUS_2,		///< Bus used by the screen
+    NB_SPI_BUSES
+}spiBus_e;
+
+/**
+ * @brief Enumeration of the statuses of a transaction
+ */
+typedef enum{
+    SPI_DONE = 0,		///< Transaction ended successfully (or never submitted)
+    SPI_QUEUED,			///< Transaction waiting for the bus
+    SPI_IN_PROGRESS,	///< Transaction being exchanged
+    SPI_TIMEOUT,		///< Transaction did not end in time
+    SPI_DMA_ERROR,		///< DMA error occurred during the transaction
+    SPI_ABORTED			///< Transaction aborted before its end
+}spiStatus_e;
+
+/**
+ * @brief Structure defining a GPIO pin driven by the bus during a transaction
+ */
+typedef struct{
+    GPIO_TypeDef*	port;	///< Port of the pin (null if the pin is not used)
+    uint32_t		pin;	///< Mask of the pin
+}spiPin_t;
+
+struct _spiTransaction_t;
+
+/**
+ * @brief Transaction end callback prototype
+ * @note Called from the context which ended the transaction (DMA interrupt handler or spiBusUpdate())
+ *
+ * @param transaction Transaction which ended (its status tells how)
+ */
+typedef void (*spiCallback)(struct _spiTransaction_t* transaction);
+
+/**
+ * @brief Structure defining a transaction, exchanged in a single DMA transfer
+ * @note A transaction must remain valid (not on the stack of a returned function) until it ended
+ */
+typedef struct _spiTransaction_t{
+    const uint8_t*	tx;					///< Bytes to send (null to send fillers)
+    uint8_t*		rx;					///< Buffer receiving the bytes (null to discard them)
+    uint16_t		length;				///< Number of bytes exchanged
+    spiPin_t		chipSelect;			///< Pin driven low during the transaction (unused if the SPI drives NSS itself)
+    spiPin_t		dataCommand;		///< Data/command pin set for the transaction (unused if the device has none)
+    uint8_t			dataCommandLevel;	///< Level of the data/command pin during the transaction
+    uint8_t			circular;			///< Flag indicating the transaction restarts forever, until aborted
+    spiCallback		callback;			///< Function called once the transaction ended (null if none)
+    volatile spiStatus_e		status;	///< Status of the transaction (managed by the bus)
+    struct _spiTransaction_t*	next;	///< Next transaction queued (managed by the bus)
+}spiTransaction_t;
+
+errorCode_u spiBusInitialise(spiBus_e bus, SPI_TypeDef* handle, DMA_TypeDef* dma, uint32_t channelTX, uint32_t channelRX);
+errorCode_u spiBusSubmit(spiBus_e bus, spiTransaction_t* transaction);
+errorCode_u spiBusTransfer(spiBus_e bus, spiTransaction_t* transaction);
+void spiBusUpdate(spiBus_e bus);
+void spiBusInterrupt(spiBus_e bus);
+void spiBusAbort(spiBus_e bus);
+uint8_t spiBusIsIdle(spiBus_e bus);
+
+/**
+ * @brief Check if a transaction has not ended yet
+ *
+ * @param transaction Transaction to check
+ * @retval 0 Transaction ended (or never submitted)
+ * @retval 1 Transaction queued or in progress
+ */
+static inline uint8_t spiIsPending(const spiTransaction_t* transaction){
+    return ((transaction->status == SPI_QUEUED) || (transaction->status == SPI_IN_PROGRESS));
+}
+
+#endif /* INC_HARDWARE_SPI_SPIBUS_H_ */
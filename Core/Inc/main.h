@@ -37,6 +37,7 @@ extern "C" {
 #include "stm32f1xx_ll_utils.h"
 #include "stm32f1xx_ll_pwr.h"
 #include "stm32f1xx_ll_spi.h"
+#include "stm32f1xx_ll_tim.h"
 #include "stm32f1xx_ll_gpio.h"
 
 #if defined(USE_FULL_ASSERT)
@@ -45,6 +46,8 @@ extern "C" {
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "stm32f1xx_ll_rtc.h"
+#include "stm32f1xx_ll_usart.h"
 
 /* USER CODE END Includes */
 
@@ -55,11 +58,19 @@ extern "C" {
 
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
+extern volatile uint32_t systemTick_ms;
 
 /* USER CODE END EC */
 
 /* Exported macro ------------------------------------------------------------*/
 /* USER CODE BEGIN EM */
+//execute a hot function from SRAM (copied at start-up) instead of flash, to avoid the wait states
+//	(long_call lets the callers in flash reach it without a veneer)
+#if defined(RAM_FUNCTIONS)
+#define RAMFUNC	__attribute__((section(".ramfunc"), noinline, long_call))
+#else
+#define RAMFUNC
+#endif
 
 /* USER CODE END EM */
 
@@ -113,6 +124,8 @@ void Error_Handler(void);
 #endif
 
 /* USER CODE BEGIN Private defines */
+#define ZERO_BUTTON_EXTI_LINE LL_EXTI_LINE_10
+#define HOLD_BUTTON_EXTI_LINE LL_EXTI_LINE_11
 
 /* USER CODE END Private defines */
 
@@ -0,0 +1,41 @@
+#ifndef INC_PROFILER_BENCHMARK_H_
+#define INC_PROFILER_BENCHMARK_H_
+#include "main.h"
+#include <stdint.h>
+
+#define BENCHMARK_NB_STEPS	64U		///< Number of steps of the tilt sweep replayed through the measurement path
+#define BENCHMARK_NB_PASSES	4U		///< Number of times the tilt sweep is replayed
+#define BENCHMARK_ANGLE_TOLERANCE	1U	///< Highest deviation of the angle kernel from its atanf() version accepted (tenths of degrees)
+
+/**
+ * @brief Enumeration of the metrics measured by the benchmark
+ */
+typedef enum{
+    BENCH_INTEGRATE_FIFO = 0,	///< integrateFIFO() over a watermark batch (cycles)
+    BENCH_ANGLE,				///< computeAngleDegreesTenths() of one axis (cycles)
+    BENCH_ANGLE_ERROR,			///< Deviation of the angle kernel from its atanf() version (tenths of degrees)
+    BENCH_RENDER_ANGLE,			///< renderAngle() of one angle (cycles)
+    BENCH_RENDER_BUBBLE,		///< Rendering of a bubble level drawing (cycles)
+    BENCH_RENDER_GRAPH,			///< renderGraphColumn() of one axis (cycles)
+    BENCH_SAMPLE_TO_PIXEL,		///< From a raw batch to the angles rendered in the framebuffer, stages measurements included (cycles)
+    BENCH_WATERMARK_TO_PIXEL,	///< From the watermark interrupt to the end of the flush displaying an angle (cycles, host traces replay only)
+    NB_BENCH_METRICS
+}benchmarkMetric_e;
+
+/**
+ * @brief Structure holding the statistics of a metric
+ */
+typedef struct{
+    uint32_t	nbSamples;	///< Number of values recorded
+    uint32_t	minimum;	///< Lowest value recorded
+    uint32_t	maximum;	///< Highest value recorded
+    uint64_t	total;		///< Sum of all the values recorded
+}benchmarkResult_t;
+
+void benchmarkReset();
+void benchmarkRecord(benchmarkMetric_e metric, uint32_t value);
+const benchmarkResult_t* benchmarkGetResult(benchmarkMetric_e metric);
+uint8_t benchmarkPassed();
+void benchmarkReport();
+
+#endif /* INC_PROFILER_BENCHMARK_H_ */
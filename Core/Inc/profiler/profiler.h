@@ -0,0 +1,72 @@
+#ifndef INC_PROFILER_PROFILER_H_
+#define INC_PROFILER_PROFILER_H_
+#include "main.h"
+#include <stdint.h>
+
+#define PROFILER_NB_PROBES		32U		///< Maximum number of functions profiled
+#define PROFILER_NB_BUCKETS		24U		///< Number of log2 buckets of the durations histograms (the last one is unbounded)
+
+/**
+ * @brief Structure holding the execution statistics of a profiled function (in CPU cycles)
+ */
+typedef struct{
+    uintptr_t	key;		///< Address of the function profiled (0 if the probe is free)
+    uint32_t	nbCalls;	///< Number of calls measured
+    uint32_t	minimum;	///< Shortest call
+    uint32_t	maximum;	///< Longest call
+    uint64_t	total;		///< Sum of all the calls durations
+    uint16_t	histogram[PROFILER_NB_BUCKETS];	///< Number of calls lasting [2^i ; 2^(i+1)[ cycles (saturated)
+}profilerProbe_t;
+
+/**
+ * @brief Structure holding the main loop statistics of the current report window (in CPU cycles)
+ */
+typedef struct{
+    uint32_t	nbIterations;	///< Number of iterations measured
+    uint32_t	minimum;		///< Shortest iteration
+    uint32_t	maximum;		///< Longest iteration
+    uint64_t	total;			///< Sum of all the iterations durations
+    uint64_t	idle;			///< Number of cycles spent sleeping
+}profilerLoop_t;
+
+void profilerInitialise();
+void profilerRecord(uintptr_t key, uint32_t start);
+void profilerIdle(uint32_t start);
+void profilerLoopIteration();
+const profilerProbe_t* profilerGetProbe(uintptr_t key);
+void profilerSendWord(uint8_t port, uint32_t word);
+
+/**
+ * @brief Get the current value of the CPU cycle counter
+ *
+ * @return Number of cycles elapsed since the profiler initialisation (wraps around)
+ */
+static inline uint32_t profilerNow(){
+    return (DWT->CYCCNT);
+}
+
+#if defined(PROFILING)
+/**
+ * @brief Measure the cycles spent in a call, and record them in the probe of a function
+ *
+ * @param key	Function profiled (evaluated before the call)
+ * @param call	Statement to measure
+ */
+#define PROFILE(key, call)	do{ \
+    uintptr_t profileKey = (uintptr_t)(key); \
+    uint32_t profileStart = profilerNow(); \
+    call; \
+    profilerRecord(profileKey, profileStart); \
+}while(0)
+
+#define PROFILE_IDLE(call)	do{ uint32_t profileStart = profilerNow(); call; profilerIdle(profileStart); }while(0)	///< Measure the cycles spent sleeping in a call
+#define PROFILE_LOOP()		profilerLoopIteration()	///< Mark the start of a main loop iteration
+#define PROFILE_INIT()		profilerInitialise()	///< Start the cycle counter and the ITM reports
+#else
+#define PROFILE(key, call)	do{ call; }while(0)
+#define PROFILE_IDLE(call)	do{ call; }while(0)
+#define PROFILE_LOOP()		do{ }while(0)
+#define PROFILE_INIT()		do{ }while(0)
+#endif
+
+#endif /* INC_PROFILER_PROFILER_H_ */
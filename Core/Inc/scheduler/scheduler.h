@@ -0,0 +1,44 @@
+#ifndef INC_SCHEDULER_SCHEDULER_H_
+#define INC_SCHEDULER_SCHEDULER_H_
+#include <stdint.h>
+#include "errorstack.h"
+
+/**
+ * @brief Enumeration of the tasks run by the scheduler, by decreasing priority
+ */
+typedef enum{
+    TASK_ACCELEROMETER = 0,	///< ADXL345 state machine
+    TASK_SCREEN,			///< SSD1306 state machine
+    TASK_BUTTONS,			///< Buttons state machines
+    TASK_APPLICATION,		///< Measurements printing and buttons actions
+    TASK_EVENTS,			///< Events ring draining
+    NB_TASKS
+}taskID_e;
+
+/**
+ * @brief Task function prototype
+ *
+ * @return Return code of the task
+ */
+typedef errorCode_u (*taskFunction)();
+
+/**
+ * @brief Structure holding the statistics of a task since start-up
+ */
+typedef struct{
+    uint32_t	nbRuns;			///< Number of times the task has been run
+    uint32_t	nbOverruns;		///< Number of runs started a whole period (or more) after they were due
+    uint16_t	maxLateness_ms;	///< Longest delay between the moment a periodic run was due and its start
+    uint16_t	maxDuration_ms;	///< Longest run
+    errorCode_u	lastError;		///< Latest error returned by the task (with the task as module ID)
+}taskStats_t;
+
+errorCode_u schedulerRegister(taskID_e task, taskFunction function, uint16_t period_ms);
+void schedulerSignal(taskID_e task);
+void schedulerSetPeriod(taskID_e task, uint16_t period_ms);
+void schedulerRealign();
+uint8_t schedulerRun();
+void schedulerIdle();
+const taskStats_t* schedulerGetStats(taskID_e task);
+
+#endif /* INC_SCHEDULER_SCHEDULER_H_ */
@@ -0,0 +1,18 @@
+#ifndef INC_SCHEDULER_TIMERS_H_
+#define INC_SCHEDULER_TIMERS_H_
+#include <stdint.h>
+
+/**
+ * @brief Structure defining a software timer, expiring a number of milliseconds after it has been started
+ * @note A timer which has never been started is elapsed
+ */
+typedef struct{
+    uint32_t	start_ms;		///< System tick at which the timer has been started
+    uint16_t	duration_ms;	///< Number of milliseconds after which the timer expires (0 once known as elapsed)
+}softTimer_t;
+
+void timerStart(softTimer_t* timer, uint16_t duration_ms);
+void timerStop(softTimer_t* timer);
+uint8_t timerIsRunning(softTimer_t* timer);
+
+#endif /* INC_SCHEDULER_TIMERS_H_ */
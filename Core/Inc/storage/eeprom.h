@@ -0,0 +1,12 @@
+#ifndef INC_STORAGE_EEPROM_H_
+#define INC_STORAGE_EEPROM_H_
+#include "main.h"
+#include "errorstack.h"
+
+#define EEPROM_MAX_RECORD_SIZE	32U		///< Maximum size of a record (in bytes)
+
+errorCode_u EEPROMinitialise();
+errorCode_u EEPROMread(void* record, uint8_t size);
+errorCode_u EEPROMwrite(const void* record, uint8_t size);
+
+#endif /* INC_STORAGE_EEPROM_H_ */
@@ -0,0 +1,42 @@
+#ifndef INC_STORAGE_HISTORY_H_
+#define INC_STORAGE_HISTORY_H_
+#include <stdint.h>
+#include "errorstack.h"
+
+#define HISTORY_NB_SPANS	64U		///< Number of spans kept in the history ring (power of two, at least one per graph column)
+
+/**
+ * @brief Enumeration of the angles recorded in the history
+ */
+typedef enum{
+    HISTORY_ROLL = 0,
+    HISTORY_PITCH,
+    HISTORY_NB_AXIS
+}historyAxis_e;
+
+/**
+ * @brief Structure holding the statistics of an angle, updated each time a sample is added
+ */
+typedef struct{
+    int16_t	minimum;	///< Lowest angle recorded since the latest reset (in tenths)
+    int16_t	maximum;	///< Highest angle recorded since the latest reset (in tenths)
+    int16_t	peak;		///< Angle the furthest from 0 recorded since the latest reset (in tenths, with sign)
+}historyStats_t;
+
+/**
+ * @brief Structure holding the envelope of the samples added during a span (e.g. a graph column)
+ */
+typedef struct{
+    int16_t	minimum[HISTORY_NB_AXIS];	///< Lowest angle of the span (in tenths)
+    int16_t	maximum[HISTORY_NB_AXIS];	///< Highest angle of the span (in tenths)
+    uint16_t	nbSamples;				///< Number of samples in the span
+}historySpan_t;
+
+void historyReset();
+void historyAdd(const int16_t samples[HISTORY_NB_AXIS]);
+uint16_t historyCount();
+errorCode_u historyGet(uint16_t age, historySpan_t* span);
+const historyStats_t* historyGetStats(historyAxis_e axis);
+historySpan_t historyTakeSpan();
+
+#endif /* INC_STORAGE_HISTORY_H_ */
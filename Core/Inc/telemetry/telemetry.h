@@ -0,0 +1,24 @@
+#ifndef INC_TELEMETRY_TELEMETRY_H_
+#define INC_TELEMETRY_TELEMETRY_H_
+#include "main.h"
+#include <stdint.h>
+
+#define TELEMETRY_NB_AXIS			3U		///< Number of axis in a sample (X, Y, Z)
+#define TELEMETRY_SAMPLES_PER_FRAME	16U		///< Number of samples carried by a frame
+
+/**
+ * @brief Structure holding the statistics of the telemetry stream since start-up
+ */
+typedef struct{
+    uint32_t	nbFrames;			///< Number of frames sent
+    uint32_t	nbDroppedFrames;	///< Number of frames dropped because the previous one was still being sent
+    uint32_t	nbErrors;			///< Number of DMA transfer errors
+    uint32_t	nbDroppedSamples;	///< Number of samples lost before being pushed, or discarded with the frame being filled (see telemetryDropSamples())
+}telemetryStats_t;
+
+void telemetryInitialise(USART_TypeDef* handle, DMA_TypeDef* dma, uint32_t dmaChannel);
+void telemetryPushSample(const int16_t sample[TELEMETRY_NB_AXIS]);
+void telemetryDropSamples(uint16_t nbSamples);
+const telemetryStats_t* telemetryGetStats();
+
+#endif /* INC_TELEMETRY_TELEMETRY_H_ */
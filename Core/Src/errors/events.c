@@ -0,0 +1,132 @@
+/**
+ * @file events.c
+ * @brief Implement a lock-free ring of timestamped events (errors and performance issues)
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * Events can be pushed from any context (main loop or interrupt handlers) without masking the interrupts,
+ * and are popped by a single consumer in the main loop.
+ *
+ * A producer reserves a position by incrementing the head with an exclusive access (LDREX/STREX),
+ * which fails and is retried whenever an interrupt reserved one in the meantime.
+ * It then writes its event in the slot, and commits it by updating the slot sequence.
+ * The consumer only reads slots committed, in order.
+ *
+ * When the ring is full, the newest events are dropped and counted, so that the oldest ones are kept.
+ *
+ * The ring is held in the global eventLog, so that a debugger can read it without the firmware map :
+ * the latest events are the ones before eventLog.head, even once they have been consumed.
+ */
+#include "main.h"
+#include "events.h"
+
+//definitions
+#define EVENTS_MASK	(EVENTS_NB_RECORDS - 1U)	///< Mask used to wrap a position in the ring
+
+//static assertions (ran at compile time)
+_Static_assert((EVENTS_NB_RECORDS & EVENTS_MASK) == 0, "EVENTS_NB_RECORDS must be a power of two.");
+
+//tool functions
+static void atomicIncrement(volatile uint32_t* counter);
+
+//global variables
+__attribute__((used)) eventLog_t eventLog;	///< Ring of the events
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Empty the ring
+ * @warning Must be called before any interrupt susceptible to push an event is enabled
+ */
+void eventsInitialise(){
+    eventLog.head = 0;
+    eventLog.tail = 0;
+    eventLog.nbLost = 0;
+    for(uint32_t i = 0 ; i < EVENTS_NB_RECORDS ; i++)
+        eventLog.slots[i].sequence = i;
+
+    eventLog.magic = EVENTS_MAGIC;
+}
+
+/**
+ * @brief Push an event in the ring
+ * @note Safe to call from interrupt handlers. The event is dropped (and counted) if the ring is full
+ *
+ * @param type		Type of the event
+ * @param source	Entity which raised the event
+ * @param value		Value of the event
+ */
+void eventsPush(eventType_e type, uint8_t source, uint32_t value){
+    eventSlot_t* slot;
+    uint32_t position;
+
+    //reserve a position, retrying if an interrupt reserved one in the meantime
+    do{
+        position = __LDREXW(&eventLog.head);
+        slot = &eventLog.slots[position & EVENTS_MASK];
+
+        //if the slot has not been consumed yet, the ring is full
+        if(slot->sequence != position){
+            __CLREX();
+            atomicIncrement(&eventLog.nbLost);
+            return;
+        }
+    }while(__STREXW(position + 1U, &eventLog.head));
+
+    //write the event, then commit it
+    slot->event = (event_t){
+        .timestamp_ms = systemTick_ms,
+        .value = value,
+        .type = (uint8_t)type,
+        .source = source,
+    };
+    __DMB();
+    slot->sequence = position + 1U;
+}
+
+/**
+ * @brief Pop the oldest event committed
+ * @warning Only one context (the main loop) can pop events
+ *
+ * @param[out] event Event popped
+ * @retval 0 No event committed
+ * @retval 1 Event popped
+ */
+uint8_t eventsPop(event_t* event){
+    uint32_t position = eventLog.tail;
+    eventSlot_t* slot = &eventLog.slots[position & EVENTS_MASK];
+
+    if(slot->sequence != (position + 1U))
+        return (0);
+
+    //read the event, then free the slot for its next turn in the ring
+    __DMB();
+    *event = slot->event;
+    __DMB();
+    slot->sequence = position + EVENTS_NB_RECORDS;
+    eventLog.tail = position + 1U;
+
+    return (1);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Increment a counter shared with interrupt handlers
+ *
+ * @param counter Counter to increment
+ */
+static void atomicIncrement(volatile uint32_t* counter){
+    uint32_t value;
+
+    do{
+        value = __LDREXW(counter);
+    }while(__STREXW(value + 1U, counter));
+}
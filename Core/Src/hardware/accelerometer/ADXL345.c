@@ -12,17 +12,59 @@
 #include "ADXL345.h"
 #include "ADXL345registers.h"
 #include "main.h"
+#include "timers.h"
+#include "profiler.h"
+#include "events.h"
+#include "telemetry.h"
+#include "spiBus.h"
+#if !defined(ADXL_FIXED_POINT_ATAN) || defined(BENCHMARK)
 #include <math.h>
+#endif
+#if defined(BENCHMARK)
+#include "benchmark.h"
+#endif
 
 //definitions
-#define SPI_TIMEOUT_MS		10U				///< SPI direct transmission timeout span in milliseconds
 #define INT_TIMEOUT_MS		1000U			///< Maximum number of milliseconds before watermark int. timeout
-#define NB_REG_INIT			6U				///< Number of registers configured at initialisation
-#define ADXL_AVG_SAMPLES	ADXL_SAMPLES_32	///< Amount of samples to integrate in the ADXL
+#define NB_REG_INIT			13U				///< Number of registers configured at initialisation
+#define NB_REG_SUSPEND		3U				///< Number of registers configured before entering low-power mode
+#define NB_REG_ACCESSES		6U				///< Maximum number of register accesses sequenced in the background
+#define ACT_THRESHOLD		0x03U			///< Activity threshold waking the device up (62.5 mg/LSB, ~190 mg)
+#define INACT_THRESHOLD		0x02U			///< Inactivity threshold (62.5 mg/LSB, ~125 mg)
+#define INACT_TIME_S		60U				///< Number of seconds below the inactivity threshold before signalling the inactivity
+#define ADXL_AVG_SAMPLES	ADXL_SAMPLES_32	///< Amount of samples averaged by the sliding-window filter (precise profile, and maximum)
 #define ADXL_AVG_SHIFT		5U				///< Number used to shift the samples sum in order to divide it during integration
+#define ADXL_AVG_WATERMARK	ADXL_SAMPLES_8	///< Amount of FIFO entries retrieved per batch (precise profile, and maximum)
+#define ADXL_FAST_SAMPLES	ADXL_SAMPLES_8	///< Amount of samples averaged by the sliding-window filter with the fast profile
+#define ADXL_FAST_SHIFT		3U				///< Number used to shift the samples sum with the fast profile
+#define ADXL_FAST_WATERMARK	ADXL_SAMPLES_4	///< Amount of FIFO entries retrieved per batch with the fast profile
+#define ADXL_TRACK_SAMPLES	ADXL_SAMPLES_8	///< Amount of samples averaged by the sliding-window filter with the adaptive profile, while moving
+#define ADXL_TRACK_SHIFT	3U				///< Number used to shift the samples sum with the adaptive profile, while moving
+#define ADXL_TRACK_WATERMARK	ADXL_SAMPLES_4	///< Amount of FIFO entries retrieved per batch with the adaptive profile, while moving
+#define MOTION_THRESHOLD_LSB	16U			///< Default peak-to-peak spread of a FIFO batch above which the device is moving (3.9 mg/LSB, ~62 mg)
+#define SETTLE_THRESHOLD_LSB	8U			///< Default peak-to-peak spread of a FIFO batch below which the device is still (3.9 mg/LSB, ~31 mg)
+#define SETTLE_NB_BATCHES	5U				///< Number of consecutive still FIFO batches before the device is considered settled
+#define ONE_G_LSB			256				///< Value measured for 1 g (full resolution, 3.9 mg/LSB)
+#define OFFSET_LSB_SHIFT	2U				///< Number used to shift between measurement LSBs and offset LSBs (15.6 mg/LSB)
+#define ST_PASSED_REGISTER	LL_RTC_BKP_DR1	///< Backup register in which the self-test record is stored
+#define ST_PASSED_RECORD	0xAD45U			///< Value stored in the backup register once the self-test passed
+#define ADXL_DMA_FRAME_SIZE	(ADXL_NB_DATA_REGISTERS + 1U)	///< Number of bytes exchanged to read one FIFO entry (read request + data registers)
+#define ATAN_TABLE_SIZE		32U				///< Number of intervals in the arctangent lookup table (between ratios 0 and 1)
+#define ATAN_RATIO_SHIFT	16U				///< Number of fractional bits used to compute the arctangent ratio
+#define ATAN_INDEX_SHIFT	11U				///< Number used to shift a ratio in order to get its lookup table interval
 
 //assertions
 static_assert((ADXL_AVG_SAMPLES >> ADXL_AVG_SHIFT) == 1, "ADXL_AVG_SHIFT does not divide all the samples configured with ADXL_AVG_SAMPLES");
+static_assert((ADXL_FAST_SAMPLES >> ADXL_FAST_SHIFT) == 1, "ADXL_FAST_SHIFT does not divide all the samples configured with ADXL_FAST_SAMPLES");
+static_assert(ADXL_FAST_SAMPLES <= ADXL_AVG_SAMPLES, "ADXL_FAST_SAMPLES does not fit in the sliding-window filter");
+static_assert(ADXL_FAST_WATERMARK <= ADXL_AVG_WATERMARK, "ADXL_FAST_WATERMARK does not fit in the FIFO entries buffer");
+static_assert((ADXL_TRACK_SAMPLES >> ADXL_TRACK_SHIFT) == 1, "ADXL_TRACK_SHIFT does not divide all the samples configured with ADXL_TRACK_SAMPLES");
+static_assert(ADXL_TRACK_SAMPLES <= ADXL_AVG_SAMPLES, "ADXL_TRACK_SAMPLES does not fit in the sliding-window filter");
+static_assert(ADXL_TRACK_WATERMARK <= ADXL_AVG_WATERMARK, "ADXL_TRACK_WATERMARK does not fit in the FIFO entries buffer");
+static_assert((ADXL_AVG_WATERMARK <= ADXL_AVG_SAMPLES) && (ADXL_FAST_WATERMARK <= ADXL_FAST_SAMPLES), "A FIFO batch must not exceed the sliding-window length");
+static_assert(ADXL_TRACK_WATERMARK <= ADXL_TRACK_SAMPLES, "A FIFO batch must not exceed the sliding-window length");
+static_assert(SETTLE_THRESHOLD_LSB <= MOTION_THRESHOLD_LSB, "The settled threshold must not exceed the moving one");
+static_assert(((1U << ATAN_RATIO_SHIFT) >> ATAN_INDEX_SHIFT) == ATAN_TABLE_SIZE, "ATAN_INDEX_SHIFT does not match the arctangent table size");
 
 //type definitions
 
@@ -42,9 +84,65 @@ typedef enum _ADXLfunctionCodes_e{
     GET_Y_ANGLE,		///< ADXL345getYangleDegrees()
     INTEGRATE,			///< integrateFIFO()
     POP_FIFO,			///< popAndAddFIFO()
-    STARTUP				///< stStartup()
+    STARTUP,			///< stStartup()
+    SET_PROFILE,		///< ADXL345setProfile()
+    APPLY_PROFILE,		///< applyProfile()
+    SUSPEND,			///< ADXL345suspend()
+    RESUME,				///< ADXL345resume()
+    CALIBRATE_FLAT,		///< ADXL345calibrateFlat()
+    CAPTURE_ORIENT,		///< ADXL345captureOrientation()
+    APPLY_OFFSETS,		///< applyOffsets()
+    SET_THRESHOLDS,		///< ADXL345setMotionThresholds()
+    ACCESSING_REGISTERS	///< stAccessingRegisters()
 }ADXLfunctionCodes_e;
 
+/**
+ * @brief Structure defining a measurement profile
+ */
+typedef struct{
+    uint8_t	dataRate;	///< Output data rate register value
+    uint8_t	nbSamples;	///< Amount of samples averaged by the sliding-window filter (power of two)
+    uint8_t	avgShift;	///< Number used to shift the samples sum in order to divide it during integration
+    uint8_t	watermark;	///< Amount of FIFO entries retrieved per batch (FIFO watermark)
+}adxlProfile_t;
+
+/**
+ * @brief Structure defining the sliding-window (moving average) filter
+ * @details Each sample entering the filter replaces the oldest one of the window in the running sums,
+ *          so the output is updated in O(1) per FIFO entry.
+ *          The ring always keeps the latest ADXL_AVG_SAMPLES samples, whatever the window length of the profile,
+ *          so that the window can be resized without losing the samples already filtered.
+ */
+typedef struct{
+    int16_t	samples[ADXL_AVG_SAMPLES][NB_AXIS];	///< Ring buffer of the latest samples
+    int32_t	sums[NB_AXIS];						///< Running sums of the samples within the window
+    uint8_t	index;								///< Index of the oldest sample of the ring (next one to be replaced)
+    uint8_t	count;								///< Number of samples within the ring
+}slidingFilter_t;
+
+/**
+ * @brief Structure defining the motion detection, based on the peak-to-peak spread of the samples of each FIFO batch
+ * @details The gap between both thresholds acts as a hysteresis : a spread in-between changes nothing
+ */
+typedef struct{
+    int16_t		minimum[NB_AXIS];	///< Lowest sample of each axis within the current batch
+    int16_t		maximum[NB_AXIS];	///< Highest sample of each axis within the current batch
+    uint16_t	movingThreshold;	///< Spread above which the device is moving (in LSB)
+    uint16_t	settledThreshold;	///< Spread below which the device is still (in LSB)
+    uint8_t		stillBatches;		///< Number of consecutive still batches (saturated at SETTLE_NB_BATCHES)
+}motionTracker_t;
+
+/**
+ * @brief Enumeration of the FIFO retrieval (DMA drain) statuses
+ */
+typedef enum{
+    FIFO_IDLE = 0,		///< No FIFO retrieval in progress
+    FIFO_CHECKING_SOURCES,	///< INT1 interrupt sources being read via DMA
+    FIFO_DRAINING,		///< FIFO entries are being retrieved via DMA
+    FIFO_BATCH_READY,	///< All FIFO entries have been retrieved
+    FIFO_DRAIN_ERROR	///< A DMA error occurred while retrieving the FIFO entries
+}fifoDrainStatus_e;
+
 /**
  * @brief State machine state prototype
  *
@@ -59,33 +157,99 @@ static errorCode_u stMeasuringST_OFF();
 static errorCode_u stWaitingForSTenabled();
 static errorCode_u stMeasuringST_ON();
 static errorCode_u stMeasuring();
+static errorCode_u stAccessingRegisters();
+static errorCode_u stSuspended();
 static errorCode_u stError();
 
 //manipulation functions
 static errorCode_u writeRegister(adxl345Registers_e registerNumber, uint8_t value);
 static errorCode_u readRegisters(adxl345Registers_e firstRegister, uint8_t value[], uint8_t size);
 static errorCode_u integrateFIFO(int32_t values[]);
+static void queueRegisterWrite(adxl345Registers_e registerNumber, uint8_t value);
+static uint8_t queueRegisterRead(adxl345Registers_e registerNumber);
+static void applyProfile(uint8_t restart);
+static void applyOffsets();
+static void startFIFOdrain();
+static void checkInterruptSources();
+static void interruptSourcesRead(spiTransaction_t* transaction);
+static void startFIFOentryRead();
+static void fifoEntryRead(spiTransaction_t* transaction);
 
 //tool functions
 static inline uint8_t isFIFOdataReady();
+static uint8_t isFIFObatchReady();
 static inline int16_t twoComplement(const uint8_t bytes[2]);
-
-// Default DATA FORMAT (register 0x31) and FIFO CONTROL (register 0x38) register values
+static inline uint8_t fifoControlValue();
+static void resetFilter();
+static void resizeFilter();
+static void filterSample(const uint8_t entry[]);
+static inline uint8_t isFilterFull();
+static void resetMotionSpan();
+static void updateMotion();
+static inline uint8_t isSettled();
+static int16_t atanDegreesTenths(int32_t numerator, int32_t denominator);
+#if !defined(ADXL_FIXED_POINT_ATAN) || defined(BENCHMARK)
+static int16_t atanfDegreesTenths(int32_t numerator, int32_t denominator);
+#endif
+static int16_t computeAngleDegreesTenths(axis_e axis);
+static int16_t computeGradeTenths(axis_e axis);
+static void publishSnapshot();
+static int8_t computeOffset(int32_t bias);
+
+// Default DATA FORMAT (register 0x31) register value
 static const uint8_t DATA_FORMAT_DEFAULT = (ADXL_NO_SELF_TEST | ADXL_SPI_4WIRE | ADXL_INT_ACTIV_LOW | ADXL_13BIT_RESOL | ADXL_RIGHT_JUSTIFY | ADXL_RANGE_16G);
-static const uint8_t FIFO_CONTROL_DEFAULT = (ADXL_MODE_FIFO | ADXL_INT_MAP_INT1 | (ADXL_AVG_SAMPLES - 1));
+
+// Interrupts enabled (register 0x2E) while measuring (all mapped to INT1)
+static const uint8_t INTERRUPTS_MEASURING = (ADXL_INT_WATERMARK | ADXL_INT_INACTIVITY);
+
+// Read request sent for each FIFO entry (first byte), followed by fillers to keep the SPI clock running
+static const uint8_t FIFO_READ_REQUEST[ADXL_DMA_FRAME_SIZE] = {ADXL_READ | ADXL_MULTIPLE | DATA_X0, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU};
+
+// Read request sent for the INT1 interrupt sources (first byte), followed by a filler
+static const uint8_t SOURCES_READ_REQUEST[2] = {ADXL_READ | ADXL_SINGLE | INTERRUPT_SOURCE, 0xFFU};
+
+// Measurement profiles (power-of-two averaging only)
+static const adxlProfile_t PROFILES[ADXL_NB_PROFILES] = {
+    [ADXL_PROFILE_PRECISE]	= {ADXL_RATE_200HZ, ADXL_AVG_SAMPLES, ADXL_AVG_SHIFT, ADXL_AVG_WATERMARK},
+    [ADXL_PROFILE_FAST]		= {ADXL_RATE_800HZ, ADXL_FAST_SAMPLES, ADXL_FAST_SHIFT, ADXL_FAST_WATERMARK},
+    [ADXL_PROFILE_ADAPTIVE]	= {ADXL_RATE_200HZ, ADXL_TRACK_SAMPLES, ADXL_TRACK_SHIFT, ADXL_TRACK_WATERMARK},	//while moving only (precise once settled)
+};
 
 //global variables
-volatile uint16_t			adxlTimer_ms = INT_TIMEOUT_MS;	///< Timer used in various states of the ADXL (in ms)
-volatile uint16_t			adxlSPITimer_ms = 0;			///< Timer used to make sure SPI does not time out (in ms)
+static softTimer_t			_timer;						///< Timer used in various states of the ADXL
 
 //state variables
-static SPI_TypeDef*		_spiHandle = NULL;			///< SPI handle used with the ADXL345
+static spiBus_e			_bus = NB_SPI_BUSES;		///< SPI bus used with the ADXL345
+static TIM_TypeDef*		_timerHandle = NULL;		///< Timer used to wait between two FIFO entries reads
 static adxlState		_state = stStartup;			///< State machine current state
-static uint8_t			_measurementsUpdated = 0;	///< Flag used to indicate new integrated measurements are ready within the ADXL345
 static int32_t			_latestValues[NB_AXIS];		///< Array of latest axis values
-static int32_t			_previousValues[NB_AXIS];	///< Array of values previously compared to latest
-static int32_t			_zeroValues[NB_AXIS];	    ///< Array of values used to compensate measurements since last zeroing
+static adxlCalibration_t	_calibration;				///< Hardware offsets and zeroing values currently used
+static uint8_t			_offsetsPending = 0;		///< Flag indicating new hardware offsets must be written as soon as possible
+static int32_t			_orientationValues[ADXL_NB_ORIENTATIONS];	///< Values of the axis aligned with gravity in each orientation captured
+static uint8_t			_orientationsCaptured = 0;	///< Bit field of the orientations captured so far
 static errorCode_u 		_result;					///< Variables used to store error codes
+static uint8_t			_fifoEntries[ADXL_AVG_WATERMARK][ADXL_DMA_FRAME_SIZE];	///< Buffer in which the DMA stores the FIFO entries
+static volatile uint8_t	_fifoEntriesRead = 0;		///< Number of FIFO entries retrieved since the last watermark interrupt
+static volatile fifoDrainStatus_e _fifoStatus = FIFO_IDLE;	///< Status of the FIFO retrieval
+static volatile uint8_t	_watermarkFired = 0;		///< Flag set by the watermark interrupt, cleared when the FIFO retrieval starts
+static spiTransaction_t	_fifoTransaction;			///< SPI transaction retrieving one FIFO entry
+static spiTransaction_t	_sourcesTransaction;		///< SPI transaction reading the INT1 interrupt sources
+static uint8_t			_sourcesReply[sizeof(SOURCES_READ_REQUEST)];	///< Buffer in which the DMA stores the interrupt sources (after the reply to the read request)
+static spiTransaction_t	_registerTransaction;		///< SPI transaction exchanging one of the register accesses sequenced
+static uint8_t			_registerAccesses[NB_REG_ACCESSES][2];	///< Register accesses sequenced in the background (instruction and value)
+static uint8_t			_registerReplies[NB_REG_ACCESSES][2];	///< Bytes received during each register access (value read in the second one)
+static uint8_t			_fifoEntriesAccess = NB_REG_ACCESSES;	///< Index of the FIFO STATUS read done before clearing the FIFOs (NB_REG_ACCESSES if none)
+static uint8_t			_nbRegisterAccesses = 0;	///< Number of register accesses sequenced
+static uint8_t			_registerAccessesSent = 0;	///< Number of register accesses already submitted
+static adxlSnapshot_t	_snapshots[2];				///< Double buffer of snapshots (one published, one being computed)
+static uint8_t			_publishedSnapshot = 0;		///< Index of the snapshot currently published
+static const adxlProfile_t*	_profile = &PROFILES[ADXL_PROFILE_PRECISE];				///< Measurement profile currently applied
+static const adxlProfile_t*	_requestedProfile = &PROFILES[ADXL_PROFILE_PRECISE];	///< Measurement profile to apply as soon as possible
+static slidingFilter_t	_filter;					///< Sliding-window filter averaging the FIFO entries
+static motionTracker_t	_motion = {.movingThreshold = MOTION_THRESHOLD_LSB, .settledThreshold = SETTLE_THRESHOLD_LSB};	///< Motion detection of the FIFO batches
+static uint8_t			_adaptive = 0;				///< Flag indicating the profile is switched automatically between the adaptive and the precise ones
+static uint8_t			_skipSelfTest = 0;			///< Flag indicating the self-test already passed and can be skipped
+static uint8_t			_inactivityDetected = 0;	///< Flag indicating the ADXL signalled an inactivity interrupt
 
 
 /********************************************************************************************************************************************/
@@ -95,19 +259,56 @@ static errorCode_u 		_result;					///< Variables used to store error codes
 /**
  * @brief Initialise the ADXL345
  *
- * @param handle	SPI handle used
- * @returns 		Success
+ * @param bus			SPI bus used (DMA reception channel required)
+ * @param timer			Timer used to wait between two FIFO entries reads (one-pulse mode, update event after 5 us)
+ * @param bootMode		Start-up sequence to use (backup registers must be writable)
+ * @returns 			Success
  */
-errorCode_u ADXL345initialise(const SPI_TypeDef* handle){
-    _spiHandle = (SPI_TypeDef*)handle;
-    LL_SPI_Disable(_spiHandle);
+errorCode_u ADXL345initialise(spiBus_e bus, TIM_TypeDef* timer, adxlBootMode_e bootMode){
+    _bus = bus;
+    _timerHandle = timer;
+
+    //set the FIFO entry transaction fields which never change (RX buffer is set for each FIFO entry)
+    _fifoTransaction = (spiTransaction_t){
+        .tx = FIFO_READ_REQUEST,
+        .length = ADXL_DMA_FRAME_SIZE,
+        .callback = fifoEntryRead,
+    };
+    _sourcesTransaction = (spiTransaction_t){
+        .tx = SOURCES_READ_REQUEST,
+        .rx = _sourcesReply,
+        .length = sizeof(SOURCES_READ_REQUEST),
+        .callback = interruptSourcesRead,
+    };
+    _registerTransaction = (spiTransaction_t){
+        .length = sizeof(_registerAccesses[0]),
+    };
+    _nbRegisterAccesses = _registerAccessesSent = 0;
+    _fifoEntriesAccess = NB_REG_ACCESSES;
+
+    //enable the interrupt signalling the end of the inter-reads delay
+    LL_TIM_ClearFlag_UPDATE(_timerHandle);
+    LL_TIM_EnableIT_UPDATE(_timerHandle);
+
+    //start the timeout of the start-up sequence
+    timerStart(&_timer, INT_TIMEOUT_MS);
 
     //reset all values
-    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++){
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++)
         _latestValues[axis] = 0;
-        _previousValues[axis] = 0;
-        _zeroValues[axis] = 0;
-    }
+    _calibration = (adxlCalibration_t){0};
+    _offsetsPending = 0;
+    _orientationsCaptured = 0;
+    _snapshots[0] = _snapshots[1] = (adxlSnapshot_t){0};
+    _publishedSnapshot = 0;
+    resetFilter();
+    _motion.stillBatches = 0;
+    resetMotionSpan();
+
+    //skip the self-test only if a warm boot is requested and it passed before, otherwise invalidate its record
+    _skipSelfTest = ((bootMode == ADXL_BOOT_WARM) && (LL_RTC_BKP_GetRegister(BKP, ST_PASSED_REGISTER) == ST_PASSED_RECORD));
+    if(!_skipSelfTest)
+        LL_RTC_BKP_SetRegister(BKP, ST_PASSED_REGISTER, 0);
 
     return (ERR_SUCCESS);
 }
@@ -118,123 +319,287 @@ errorCode_u ADXL345initialise(const SPI_TypeDef* handle){
  * @return Current machine state return value
  */
 errorCode_u ADXL345update(){
-    return ( (*_state)() );
+    errorCode_u result;
+
+    spiBusUpdate(_bus);
+    PROFILE(_state, result = (*_state)());
+    return (result);
+}
+
+/**
+ * @brief Handle the watermark interrupt (falling edge on INT1)
+ * @note To be called from the INT1 EXTI line interrupt handler
+ */
+void ADXL345watermarkInterrupt(){
+    _watermarkFired = 1;
+}
+
+/**
+ * @brief Handle the end of the delay between two FIFO entries reads
+ * @note To be called from the timer interrupt handler
+ */
+void ADXL345timerInterrupt(){
+    LL_TIM_ClearFlag_UPDATE(_timerHandle);
+
+    if(_fifoStatus == FIFO_DRAINING)
+        startFIFOentryRead();
+}
+
+/**
+ * @brief Request a new measurement profile (output data rate and averaging depth)
+ * @note The profile is applied as soon as the current FIFO batch is processed, without restarting the ADXL
+ * @note With the adaptive profile, the window is then lengthened to the precise profile once the device settles,
+ *       and shortened back as soon as it moves
+ *
+ * @param profile Profile to apply
+ * @return Success
+ * @retval 1 Unknown profile
+ */
+errorCode_u ADXL345setProfile(adxlProfile_e profile){
+    if(profile >= ADXL_NB_PROFILES)
+        return (createErrorCode(SET_PROFILE, 1, ERR_WARNING));
+
+    _adaptive = (profile == ADXL_PROFILE_ADAPTIVE);
+    if(_adaptive && isSettled())
+        profile = ADXL_PROFILE_PRECISE;
+
+    _requestedProfile = &PROFILES[profile];
+    return (ERR_SUCCESS);
 }
 
 /**
- * @brief Check if new measurements have been updated
+ * @brief Get the measurement profile requested
  *
- * @retval 0 No new values available
- * @retval 1 New values are available
+ * @return Profile requested (may not be applied yet)
+ */
+adxlProfile_e ADXL345getProfile(){
+    if(_adaptive)
+        return (ADXL_PROFILE_ADAPTIVE);
+
+    return ((adxlProfile_e)(_requestedProfile - PROFILES));
+}
+
+/**
+ * @brief Set the thresholds of the motion detection telling whether the device is moving or settled
+ * @details Each threshold is compared to the largest peak-to-peak spread of the axis within a FIFO batch.
+ *          The device is moving as soon as a batch spreads above the moving threshold,
+ *          and settled once SETTLE_NB_BATCHES consecutive batches spread below the settled threshold.
+ *
+ * @param movingLSB		Spread above which the device is moving (3.9 mg/LSB)
+ * @param settledLSB	Spread below which the device is still (3.9 mg/LSB)
+ * @return Success
+ * @retval 1 Settled threshold above the moving one
+ */
+errorCode_u ADXL345setMotionThresholds(uint16_t movingLSB, uint16_t settledLSB){
+    if(settledLSB > movingLSB)
+        return (createErrorCode(SET_THRESHOLDS, 1, ERR_WARNING));
+
+    _motion.movingThreshold = movingLSB;
+    _motion.settledThreshold = settledLSB;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Get the latest measurements snapshot
+ * @note The snapshot remains valid until the next call to ADXL345update()
+ *
+ * @return Latest snapshot published (sequence 0 if no measurements integrated yet)
+ */
+const adxlSnapshot_t* ADXL345getSnapshot(){
+    return (&_snapshots[_publishedSnapshot]);
+}
+
+/**
+ * @brief Check if the ADXL signalled the device has been still for long enough
+ *
+ * @retval 0 Device moving
+ * @retval 1 Device still for at least INACT_TIME_S seconds
+ */
+uint8_t ADXL345isInactive(){
+    return (_inactivityDetected && (_state == stMeasuring));
+}
+
+/**
+ * @brief Put the ADXL345 in low-power mode, from which it only signals an activity (on INT1)
+ * @note The measurements are stopped until ADXL345resume() is called
+ *
+ * @retval 0 Success
+ * @retval 1 ADXL not measuring, or FIFO retrieval in progress
+ * @retval 2 Error while writing a register
+ * @retval 3 Error while clearing the interrupt sources
+ * @retval 4 Error while enabling the activity interrupt
+ */
+errorCode_u ADXL345suspend(){
+    static const uint8_t suspendArray[NB_REG_SUSPEND][2] = {
+        {INTERRUPT_ENABLE,		ADXL_INT_DISABLED},
+        {FIFO_CONTROL,			ADXL_MODE_BYPASS},
+        {BANDWIDTH_POWERMODE,	ADXL_POWER_LOW | ADXL_RATE_12_5HZ},
+    };
+    uint8_t sources;
+
+    //if not measuring or FIFO entries still being retrieved, exit
+    if((_state != stMeasuring) || (_fifoStatus != FIFO_IDLE))
+        return (createErrorCode(SUSPEND, 1, ERR_WARNING));
+
+    //stop the measurements and lower the output data rate
+    for(uint8_t i = 0 ; i < NB_REG_SUSPEND ; i++){
+        _result = writeRegister(suspendArray[i][0], suspendArray[i][1]);
+        if(isError(_result)){
+            _state = stError;
+            return (pushErrorCode(_result, SUSPEND, 2));
+        }
+    }
+
+    //clear the latched interrupts, so that INT1 is released
+    _result = readRegisters(INTERRUPT_SOURCE, &sources, 1);
+    if(isError(_result)){
+        _state = stError;
+        return (pushErrorCode(_result, SUSPEND, 3));
+    }
+    _watermarkFired = 0;
+    _inactivityDetected = 0;
+
+    //only signal activities from now on
+    _result = writeRegister(INTERRUPT_ENABLE, ADXL_INT_ACTIVITY);
+    if(isError(_result)){
+        _state = stError;
+        return (pushErrorCode(_result, SUSPEND, 4));
+    }
+
+    _state = stSuspended;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Get the ADXL345 out of low-power mode and restart the measurements
+ * @details The registers are accessed in the background (see stAccessingRegisters()),
+ *          the measurements restart once they are all written
+ * @note The self-test is not run again
+ *
+ * @retval 0 Success
+ * @retval 1 ADXL not suspended
+ */
+errorCode_u ADXL345resume(){
+    //if not suspended, exit
+    if(_state != stSuspended)
+        return (createErrorCode(RESUME, 1, ERR_WARNING));
+
+    //disable the interrupts, then clear the activity one
+    queueRegisterWrite(INTERRUPT_ENABLE, ADXL_INT_DISABLED);
+    queueRegisterRead(INTERRUPT_SOURCE);
+
+    //woken up by an activity, the device is moving
+    _motion.stillBatches = 0;
+    if(_adaptive)
+        _requestedProfile = &PROFILES[ADXL_PROFILE_ADAPTIVE];
+
+    //restore the output data rate and the FIFO watermark (also empties the filter), then the measurement interrupts
+    applyProfile(1);
+    queueRegisterWrite(INTERRUPT_ENABLE, INTERRUPTS_MEASURING);
+
+    //get back to measurements once the registers are written
+    //	(SysTick timers are frozen in Stop mode, the timeout is restarted then)
+    _inactivityDetected = 0;
+    _state = stAccessingRegisters;
+    return (stAccessingRegisters());
+}
+
+/**
+ * @brief Compute the angles from the latest values and publish them in a new snapshot
  */
-uint8_t ADXL345hasChanged(axis_e axis){
-    uint8_t tmp = (_latestValues[axis] != _previousValues[axis]);
-    _previousValues[axis] = _latestValues[axis];
+static void publishSnapshot(){
+    const adxlSnapshot_t* previous = &_snapshots[_publishedSnapshot];
+    adxlSnapshot_t* next = &_snapshots[_publishedSnapshot ^ 1U];
+
+    //compute all the values in the unpublished snapshot
+    PROFILE(computeAngleDegreesTenths, next->rollTenths = computeAngleDegreesTenths(X_AXIS));
+    PROFILE(computeAngleDegreesTenths, next->pitchTenths = computeAngleDegreesTenths(Y_AXIS));
+    next->rollGradeTenths = computeGradeTenths(X_AXIS);
+    next->pitchGradeTenths = computeGradeTenths(Y_AXIS);
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++)
+        next->axes[axis] = _latestValues[axis];
+    next->sequence = previous->sequence + 1;
+    next->timestamp_ms = systemTick_ms;
+    next->settled = (isSettled() && isFilterFull());
 
-    return (tmp);
+    //publish it
+    _publishedSnapshot ^= 1U;
 }
 
 /**
- * @brief Write a single register on the ADXL345
+ * @brief Write a single register on the ADXL345, and wait for the end of the transaction
+ * @note Blocking : only used by the start-up sequence and before entering Stop mode,
+ *       the measurements access the registers in the background (see stAccessingRegisters())
  *
  * @param registerNumber Register number
  * @param value Register value
  * @return	 Success
  * @retval 1 Register number out of range
- * @retval 2 Timeout
+ * @retval 2 SPI transaction error
  */
 static errorCode_u writeRegister(adxl345Registers_e registerNumber, uint8_t value){
-    //assertions
-    assert(_spiHandle);
-
     //if register number above known or within the reserved range, error
     if((registerNumber > ADXL_REGISTER_MAXNB) || ((uint8_t)(registerNumber - 1) < ADXL_HIGH_RESERVED_REG))
         return (createErrorCode(WRITE_REGISTER, 1, ERR_WARNING));
 
-    //set timeout timer and enable SPI
-    adxlSPITimer_ms = SPI_TIMEOUT_MS;
-    LL_SPI_Enable(_spiHandle);
-
-    //send the write instruction
-    LL_SPI_TransmitData8(_spiHandle, ADXL_WRITE | ADXL_SINGLE | registerNumber);
-
-    //wait for TX buffer to be ready and send value to write
-    while(!LL_SPI_IsActiveFlag_TXE(_spiHandle) && adxlSPITimer_ms);
-    if(adxlSPITimer_ms)
-        LL_SPI_TransmitData8(_spiHandle, value);
-
-    //wait for transaction to be finished and clear Overrun flag
-    while(LL_SPI_IsActiveFlag_BSY(_spiHandle) && adxlSPITimer_ms);
-    LL_SPI_ClearFlag_OVR(_spiHandle);
-
-    //disable SPI
-    LL_SPI_Disable(_spiHandle);
+    //send the write instruction, followed by the value to write
+    const uint8_t frame[2] = {ADXL_WRITE | ADXL_SINGLE | registerNumber, value};
+    spiTransaction_t transaction = {
+        .tx = frame,
+        .length = sizeof(frame),
+    };
 
-    //if timeout, error
-    if(!adxlSPITimer_ms)
-        return (createErrorCode(WRITE_REGISTER, 2, ERR_WARNING));
+    errorCode_u result = spiBusTransfer(_bus, &transaction);
+    if(isError(result))
+        return (pushErrorCode(result, WRITE_REGISTER, 2));
 
     return (ERR_SUCCESS);
 }
 
 /**
- * @brief Read several registers on the ADXL345
+ * @brief Read several registers on the ADXL345, and wait for the end of the transaction
+ * @note Blocking : only used by the start-up sequence and before entering Stop mode,
+ *       the INT1 sources are read in the background while measuring (see checkInterruptSources())
  *
  * @param firstRegister Number of the first register to read
  * @param[out] value Registers value array
  * @param size Number of registers to read
  * @return   Success
- * @retval 1 Register number out of range
- * @retval 2 Timeout
+ * @retval 1 Register number out of range, or too many registers
+ * @retval 2 SPI transaction error
  */
 static errorCode_u readRegisters(adxl345Registers_e firstRegister, uint8_t value[], uint8_t size){
-    static const uint8_t SPI_RX_FILLER = 0xFFU;	///< Value to send as a filler while receiving multiple bytes
-
     //if no bytes to read, success
     if(!size)
         return ERR_SUCCESS;
 
     //assertions
-    assert(_spiHandle);
     assert(value);
 
-    //if register numbers above known, error
-    if(firstRegister > ADXL_REGISTER_MAXNB)
+    //if register numbers above known or too many registers to read at once, error
+    if((firstRegister > ADXL_REGISTER_MAXNB) || (size > ADXL_NB_DATA_REGISTERS))
         return (createErrorCode(READ_REGISTERS, 1, ERR_WARNING));
 
-    //set timeout timer and enable SPI
-    adxlSPITimer_ms = SPI_TIMEOUT_MS;
-    LL_SPI_Enable(_spiHandle);
-    uint8_t* iterator = value;
-
-    //send the read request and ignore the first byte received (reply to the write request)
-    LL_SPI_TransmitData8(_spiHandle, ADXL_READ | ADXL_MULTIPLE | firstRegister);
-    while((!LL_SPI_IsActiveFlag_RXNE(_spiHandle)) && adxlSPITimer_ms);
-    *iterator = LL_SPI_ReceiveData8(_spiHandle);
-
-    //receive the bytes to read
-    do{
-        //send a filler byte to keep the SPI clock running, to receive the next byte
-        LL_SPI_TransmitData8(_spiHandle, SPI_RX_FILLER);
-
-        //wait for data to be available, and read it
-        while((!LL_SPI_IsActiveFlag_RXNE(_spiHandle)) && adxlSPITimer_ms);
-        *iterator = LL_SPI_ReceiveData8(_spiHandle);
-        
-        iterator++;
-        size--;
-    }while(size && adxlSPITimer_ms);
-
-    //wait for transaction to be finished and clear Overrun flag
-    while(LL_SPI_IsActiveFlag_BSY(_spiHandle) && adxlSPITimer_ms);
-    LL_SPI_ClearFlag_OVR(_spiHandle);
+    //send the read request followed by fillers to keep the SPI clock running
+    //	(the first byte received is the reply to the read request, and is ignored)
+    uint8_t frameTX[ADXL_DMA_FRAME_SIZE];
+    uint8_t frameRX[ADXL_DMA_FRAME_SIZE];
+    frameTX[0] = ADXL_READ | ADXL_MULTIPLE | firstRegister;
+    for(uint8_t i = 1 ; i <= size ; i++)
+        frameTX[i] = 0xFFU;
+
+    spiTransaction_t transaction = {
+        .tx = frameTX,
+        .rx = frameRX,
+        .length = (uint16_t)(size + 1U),
+    };
 
-    //disable SPI
-    LL_SPI_Disable(_spiHandle);
+    errorCode_u result = spiBusTransfer(_bus, &transaction);
+    if(isError(result))
+        return (pushErrorCode(result, READ_REGISTERS, 2));
 
-    //if timeout, error
-    if(!adxlSPITimer_ms)
-        return (createErrorCode(READ_REGISTERS, 2, ERR_WARNING));
+    for(uint8_t i = 0 ; i < size ; i++)
+        value[i] = frameRX[i + 1U];
 
     return (ERR_SUCCESS);
 }
@@ -245,28 +610,314 @@ static errorCode_u readRegisters(adxl345Registers_e firstRegister, uint8_t value
  * @param axis Axis for which get the angle with the Z axis
  * @return Angle with the Z axis
  */
-int16_t getAngleDegreesTenths(axis_e axis){
-    static const float RADIANS_TO_DEGREES_TENTHS = 180.0f * 10.0f * (float)M_1_PI;
-
+static RAMFUNC int16_t computeAngleDegreesTenths(axis_e axis){
     if(!_latestValues[Z_AXIS])
         return (0);
 
     //compute the angle between Z axis and the requested one
-    //	then transform radians to 0.1 degrees
+    return (atanDegreesTenths(_latestValues[axis] + _calibration.zeroValues[axis], _latestValues[Z_AXIS]));
+}
+
+/**
+ * @brief Transpose a measurement to a percent grade (tangent of the angle with the Z axis) with integer operations only
+ * @note The grade is saturated when the angle gets close to 90°
+ *
+ * @param axis Axis for which get the grade with the Z axis
+ * @return Grade with the Z axis in tenths of percent, truncated towards 0
+ */
+static int16_t computeGradeTenths(axis_e axis){
+    static const int32_t GRADE_TENTHS_RATIO = 1000;	///< Number of tenths of percent in a ratio of 1
+    int32_t opposite = _latestValues[axis] + _calibration.zeroValues[axis];
+    int32_t adjacent = _latestValues[Z_AXIS];
+
+    //saturate the grade if the ratio would exceed the 16 bits range (or if Z is 0)
+    //	(values remain within +/- 2^15, so the products fit in 32 bits)
+    int32_t scaled = opposite * GRADE_TENTHS_RATIO;
+    if((scaled < 0 ? -scaled : scaled) >= ((adjacent < 0 ? -adjacent : adjacent) * INT16_MAX))
+        return (((opposite < 0) != (adjacent < 0)) ? -INT16_MAX : INT16_MAX);
+
+    return ((int16_t)(scaled / adjacent));
+}
+
+#if defined(ADXL_FIXED_POINT_ATAN)
+/**
+ * @brief Compute the arctangent of a ratio in tenths of degrees, with integer operations only
+ * @details A lookup table holds the arctangent of ratios between 0 and 1, which is then linearly interpolated.
+ *          Ratios above 1 use the identity arctan(x) = 90° - arctan(1/x).
+ *          Maximum deviation from the atanf() version : 0.1°
+ * @note Both values must remain within +/- 2^15 to avoid overflowing the ratio computation
+ *
+ * @param numerator		Numerator of the ratio (opposite side)
+ * @param denominator	Denominator of the ratio (adjacent side, not 0)
+ * @return Angle in tenths of degrees, truncated towards 0
+ */
+static RAMFUNC int16_t atanDegreesTenths(int32_t numerator, int32_t denominator){
+    //arctangent of (i / 32) in thousandths of degrees, for i in [0 ; 32]
+    //	generated with : [round(math.degrees(math.atan(i / 32)) * 1000) for i in range(33)]
+    static const uint16_t ATAN_TABLE[ATAN_TABLE_SIZE + 1] = {
+            0,  1790,  3576,  5356,  7125,  8881, 10620, 12339,
+        14036, 15709, 17354, 18970, 20556, 22109, 23629, 25115,
+        26565, 27979, 29358, 30700, 32005, 33275, 34509, 35707,
+        36870, 37999, 39094, 40156, 41186, 42184, 43152, 44091,
+        45000,
+    };
+    static const uint32_t RIGHT_ANGLE_MILLIDEGREES = 90000U;	///< 90° in thousandths of degrees
+    static const uint32_t MILLIDEGREES_PER_TENTH = 100U;		///< Number of thousandths of degrees in a tenth
+    static const uint32_t FRACTION_MASK = (1U << ATAN_INDEX_SHIFT) - 1U;
+
+    uint32_t opposite = (uint32_t)(numerator < 0 ? -numerator : numerator);
+    uint32_t adjacent = (uint32_t)(denominator < 0 ? -denominator : denominator);
+    uint8_t inverted = (opposite > adjacent);
+    uint32_t millidegrees;
+
+    //make sure the ratio remains between 0 and 1
+    if(inverted){
+        uint32_t tmp = opposite;
+        opposite = adjacent;
+        adjacent = tmp;
+    }
+
+    //get the interval in which the ratio lies, then interpolate within it
+    uint32_t ratio = (opposite << ATAN_RATIO_SHIFT) / adjacent;
+    uint32_t index = ratio >> ATAN_INDEX_SHIFT;
+    if(index >= ATAN_TABLE_SIZE)
+        millidegrees = ATAN_TABLE[ATAN_TABLE_SIZE];
+    else
+        millidegrees = ATAN_TABLE[index] + (((uint32_t)(ATAN_TABLE[index + 1] - ATAN_TABLE[index]) * (ratio & FRACTION_MASK)) >> ATAN_INDEX_SHIFT);
+
+    if(inverted)
+        millidegrees = RIGHT_ANGLE_MILLIDEGREES - millidegrees;
+
+    //apply the sign of the ratio
+    int16_t tenths = (int16_t)(millidegrees / MILLIDEGREES_PER_TENTH);
+    return (((numerator < 0) != (denominator < 0)) ? (int16_t)-tenths : tenths);
+}
+#else
+/**
+ * @brief Compute the arctangent of a ratio in tenths of degrees, with the libm atanf()
+ *
+ * @param numerator		Numerator of the ratio (opposite side)
+ * @param denominator	Denominator of the ratio (adjacent side, not 0)
+ * @return Angle in tenths of degrees, truncated towards 0
+ */
+static int16_t atanDegreesTenths(int32_t numerator, int32_t denominator){
+    return (atanfDegreesTenths(numerator, denominator));
+}
+#endif
+
+#if !defined(ADXL_FIXED_POINT_ATAN) || defined(BENCHMARK)
+/**
+ * @brief Compute the arctangent of a ratio in tenths of degrees, with the libm atanf()
+ * @note Also the reference of the lookup table version in the benchmark (see ADXL345benchmarkAccuracy())
+ *
+ * @param numerator		Numerator of the ratio (opposite side)
+ * @param denominator	Denominator of the ratio (adjacent side, not 0)
+ * @return Angle in tenths of degrees, truncated towards 0
+ */
+static int16_t atanfDegreesTenths(int32_t numerator, int32_t denominator){
+    static const float RADIANS_TO_DEGREES_TENTHS = 180.0f * 10.0f * (float)M_1_PI;
+
+    //transform radians to 0.1 degrees
     //	formula : degrees_tenths = (arctan(axis/Z) * 180° * 10) / PI
-    float angle = atanf((float)(_latestValues[axis] + _zeroValues[axis]) / (float)_latestValues[Z_AXIS]);
+    float angle = atanf((float)numerator / (float)denominator);
     angle *= RADIANS_TO_DEGREES_TENTHS;
     return ((int16_t)angle);
 }
+#endif
 
 /**
- * @brief Check the status of the ADXL Data Ready interrupt
+ * @brief Check if the ADXL watermark interrupt fired
  * 
  * @retval 0 Data is not ready yet
  * @retval 1 Data is ready
  */
 static inline uint8_t isFIFOdataReady(){
-    return !LL_GPIO_IsInputPinSet(ADXL_INT1_GPIO_Port, ADXL_INT1_Pin);
+    return (_watermarkFired);
+}
+
+/**
+ * @brief Check if a full batch of FIFO entries has been retrieved
+ * @note If the INT1 interrupt fired and no retrieval is in progress, its sources are checked
+ * 
+ * @retval 0 Batch is not ready yet
+ * @retval 1 Batch is ready (or its retrieval failed)
+ */
+static uint8_t isFIFObatchReady(){
+    //if INT1 interrupt fired, check whether it was for a watermark or an inactivity
+    if((_fifoStatus == FIFO_IDLE) && isFIFOdataReady())
+        checkInterruptSources();
+
+    return ((_fifoStatus == FIFO_BATCH_READY) || (_fifoStatus == FIFO_DRAIN_ERROR));
+}
+
+/**
+ * @brief Start reading the sources of the INT1 interrupt in the background
+ * @note The transaction is ended in the RX DMA channel interrupt, which calls interruptSourcesRead()
+ */
+static void checkInterruptSources(){
+    //if unable to start reading the sources, signal it as a retrieval failure
+    _watermarkFired = 0;
+    _fifoStatus = FIFO_CHECKING_SOURCES;
+    if(isError(spiBusSubmit(_bus, &_sourcesTransaction)))
+        _fifoStatus = FIFO_DRAIN_ERROR;
+}
+
+/**
+ * @brief Handle the sources of the INT1 interrupt read, and start retrieving the FIFO entries if the watermark is reached
+ * @note Called from the RX DMA channel interrupt handler (or spiBusUpdate() on timeout)
+ * @note Reading the sources also clears the latched inactivity interrupt
+ *
+ * @param transaction Transaction which ended
+ */
+static void interruptSourcesRead(spiTransaction_t* transaction){
+    //if the transaction failed, signal it as a retrieval failure
+    if(transaction->status != SPI_DONE){
+        _fifoStatus = FIFO_DRAIN_ERROR;
+        return;
+    }
+
+    //the first byte received is the reply to the read request
+    uint8_t sources = _sourcesReply[1];
+    if(sources & ADXL_INT_INACTIVITY)
+        _inactivityDetected = 1;
+
+    //if the FIFO overran before being retrieved, samples were lost
+    if(sources & ADXL_INT_OVERRUN)
+        eventsPush(EVENT_FIFO_OVERRUN, 0, sources);
+
+    //if watermark interrupt fired, start retrieving the FIFO entries in the background
+    if(sources & ADXL_INT_WATERMARK)
+        startFIFOdrain();
+    else
+        _fifoStatus = FIFO_IDLE;
+}
+
+/**
+ * @brief Start retrieving all the FIFO entries in the background
+ */
+static void startFIFOdrain(){
+    _watermarkFired = 0;
+    _fifoEntriesRead = 0;
+    _fifoStatus = FIFO_DRAINING;
+    startFIFOentryRead();
+}
+
+/**
+ * @brief Submit the SPI transaction retrieving the next FIFO entry
+ * @note The transaction is ended in the RX DMA channel interrupt, which calls fifoEntryRead()
+ */
+static void startFIFOentryRead(){
+    _fifoTransaction.rx = _fifoEntries[_fifoEntriesRead];
+    if(isError(spiBusSubmit(_bus, &_fifoTransaction)))
+        _fifoStatus = FIFO_DRAIN_ERROR;
+}
+
+/**
+ * @brief Handle the end of the SPI transaction retrieving a FIFO entry
+ * @note Called from the RX DMA channel interrupt handler (or spiBusUpdate() on timeout)
+ *
+ * @param transaction Transaction which ended
+ */
+static void fifoEntryRead(spiTransaction_t* transaction){
+    //if the transaction failed, flag it
+    if(transaction->status != SPI_DONE){
+        _fifoStatus = FIFO_DRAIN_ERROR;
+        return;
+    }
+
+    //if all entries retrieved, signal the batch is ready
+    _fifoEntriesRead++;
+    if(_fifoEntriesRead >= _profile->watermark){
+        _fifoStatus = FIFO_BATCH_READY;
+        return;
+    }
+
+    //wait for 5 us to pass between two reads before reading the next entry
+    //	as stated in the datasheet, section "Retrieving data from the FIFO"
+    LL_TIM_EnableCounter(_timerHandle);
+}
+
+/**
+ * @brief Get the FIFO CONTROL (register 0x38) value matching the current profile
+ *
+ * @return FIFO CONTROL register value
+ */
+static inline uint8_t fifoControlValue(){
+    return (ADXL_MODE_FIFO | ADXL_INT_MAP_INT1 | (uint8_t)(_profile->watermark - 1));
+}
+
+/**
+ * @brief Queue a register write, to be sent in the background by stAccessingRegisters()
+ *
+ * @param registerNumber	Register number
+ * @param value				Register value
+ */
+static void queueRegisterWrite(adxl345Registers_e registerNumber, uint8_t value){
+    assert(_nbRegisterAccesses < NB_REG_ACCESSES);
+
+    _registerAccesses[_nbRegisterAccesses][0] = ADXL_WRITE | ADXL_SINGLE | registerNumber;
+    _registerAccesses[_nbRegisterAccesses][1] = value;
+    _nbRegisterAccesses++;
+}
+
+/**
+ * @brief Queue a register read, to be sent in the background by stAccessingRegisters()
+ * @note The value read is the second byte of _registerReplies at the index returned, once the accesses are done
+ *
+ * @param registerNumber Register number
+ * @return Index of the access
+ */
+static uint8_t queueRegisterRead(adxl345Registers_e registerNumber){
+    assert(_nbRegisterAccesses < NB_REG_ACCESSES);
+
+    _registerAccesses[_nbRegisterAccesses][0] = ADXL_READ | ADXL_SINGLE | registerNumber;
+    _registerAccesses[_nbRegisterAccesses][1] = 0xFFU;
+    return (_nbRegisterAccesses++);
+}
+
+/**
+ * @brief Queue the writes reprogramming the output data rate and the FIFO watermark with the requested profile
+ * @details If the output data rate does not change, only the watermark is written :
+ *          the FIFO entries are kept, and the filter window slides over the samples already filtered.
+ *          Otherwise, the FIFOs are cleared and the entries discarded are counted as samples lost by the telemetry stream.
+ * @note No FIFO retrieval must be in progress
+ *
+ * @param restart Flag indicating the output data rate is written and the FIFOs cleared, even if the rate does not change
+ */
+static void applyProfile(uint8_t restart){
+    restart |= (_requestedProfile->dataRate != _profile->dataRate);
+    _profile = _requestedProfile;
+
+    //if only the watermark and the window length change, keep the samples
+    if(!restart){
+        resizeFilter();
+        queueRegisterWrite(FIFO_CONTROL, fifoControlValue());
+        return;
+    }
+
+    queueRegisterWrite(BANDWIDTH_POWERMODE, ADXL_POWER_NORMAL | _profile->dataRate);
+
+    //clear the FIFOs (samples gathered with the previous profile are discarded)
+    _fifoEntriesAccess = queueRegisterRead(FIFO_STATUS);
+    queueRegisterWrite(FIFO_CONTROL, ADXL_MODE_BYPASS);
+    _watermarkFired = 0;
+    resetFilter();
+
+    queueRegisterWrite(FIFO_CONTROL, fifoControlValue());
+}
+
+/**
+ * @brief Queue the writes of the hardware offsets in the ADXL, then discard the samples measured with the previous ones
+ * @note No FIFO retrieval must be in progress
+ */
+static void applyOffsets(){
+    static const adxl345Registers_e OFFSET_REGISTERS[NB_AXIS] = {OFFSET_X, OFFSET_Y, OFFSET_Z};
+
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++)
+        queueRegisterWrite(OFFSET_REGISTERS[axis], (uint8_t)_calibration.offsets[axis]);
+    _offsetsPending = 0;
+
+    applyProfile(1);
 }
 
 /**
@@ -281,42 +932,150 @@ static inline int16_t twoComplement(const uint8_t bytes[2]){
 }
 
 /**
- * @brief Retrieve and average the values held in the ADXL FIFOs
+ * @brief Empty the sliding-window filter
+ */
+static void resetFilter(){
+    _filter = (slidingFilter_t){0};
+}
+
+/**
+ * @brief Recompute the running sums over the latest samples fitting in the window of the current profile
+ * @note To be called when the window length changes, the samples of the ring being kept
+ */
+static void resizeFilter(){
+    uint8_t nbSamples = (isFilterFull() ? _profile->nbSamples : _filter.count);
+
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++)
+        _filter.sums[axis] = 0;
+
+    for(uint8_t i = 1 ; i <= nbSamples ; i++){
+        const int16_t* sample = _filter.samples[(_filter.index - i) & (ADXL_AVG_SAMPLES - 1U)];
+
+        for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++)
+            _filter.sums[axis] += sample[axis];
+    }
+}
+
+/**
+ * @brief Push a FIFO entry in the sliding-window filter, and stream it as is
+ * @note Once the window is full, the oldest sample of the window is removed from the running sums
  *
- * @param[out] values Integrated X, Y and Z axis values
- * @retval 0 Success
- * @retval 1 Error while retrieving values from the FIFO
+ * @param entry FIFO entry retrieved via DMA (first byte is the reply to the read request)
  */
-static errorCode_u integrateFIFO(int32_t values[]){
-    uint8_t buffer[ADXL_NB_DATA_REGISTERS];
-    uint8_t axis;
+static void filterSample(const uint8_t entry[]){
+    int16_t* slot = _filter.samples[_filter.index];
+    const int16_t* oldest = _filter.samples[(_filter.index - _profile->nbSamples) & (ADXL_AVG_SAMPLES - 1U)];
+
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++){
+        int16_t sample = twoComplement(&entry[(axis << 1) + 1]);
+
+        //with the longest window, the oldest sample is the one replaced (read before being overwritten)
+        if(isFilterFull())
+            _filter.sums[axis] -= oldest[axis];
+        _filter.sums[axis] += sample;
+        slot[axis] = sample;
+
+        //widen the span of the current batch
+        if(sample < _motion.minimum[axis])
+            _motion.minimum[axis] = sample;
+        if(sample > _motion.maximum[axis])
+            _motion.maximum[axis] = sample;
+    }
 
-    //set the axis values to 0 before integrating
-    values[X_AXIS] = values[Y_AXIS] = values[Z_AXIS] = 0;
+    //stream the raw sample
+    telemetryPushSample(slot);
 
-    //for each of the samples to read
-    for(uint8_t i = 0 ; i < ADXL_AVG_SAMPLES ; i++){
-        //read all data registers for 1 sample
-        _result = readRegisters(DATA_X0, buffer, ADXL_NB_DATA_REGISTERS);
-        if(isError(_result)){
-            _state = stError;
-            return (pushErrorCode(_result, INTEGRATE, 1));
-        }
+    //ring length is a power of two
+    _filter.index = (uint8_t)((_filter.index + 1U) & (ADXL_AVG_SAMPLES - 1U));
+    if(_filter.count < ADXL_AVG_SAMPLES)
+        _filter.count++;
+}
 
-        //add the measurements (formatted from a two's complement) to their final value buffer
-        for(axis = 0 ; axis < NB_AXIS ; axis++)
-            values[axis] += twoComplement(&buffer[axis << 1]);
+/**
+ * @brief Check if the sliding-window filter holds enough samples to be averaged
+ *
+ * @retval 0 Window not full yet
+ * @retval 1 Window full
+ */
+static inline uint8_t isFilterFull(){
+    return (_filter.count >= _profile->nbSamples);
+}
 
-        //wait for a while to make sure 5 us pass between two reads
-        //	as stated in the datasheet, section "Retrieving data from the FIFO"
-        volatile uint8_t tempo = 0x0FU;
-        while(tempo--);
+/**
+ * @brief Start the span of a new FIFO batch, without any sample
+ */
+static void resetMotionSpan(){
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++){
+        _motion.minimum[axis] = INT16_MAX;
+        _motion.maximum[axis] = INT16_MIN;
     }
+}
+
+/**
+ * @brief Compare the peak-to-peak spread of the FIFO batch filtered to the motion thresholds, then start a new batch span
+ */
+static void updateMotion(){
+    uint16_t spread = 0;
+
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++){
+        uint16_t axisSpread = (uint16_t)(_motion.maximum[axis] - _motion.minimum[axis]);
+        if(axisSpread > spread)
+            spread = axisSpread;
+    }
+    resetMotionSpan();
+
+    if(spread > _motion.movingThreshold)
+        _motion.stillBatches = 0;
+    else if((spread <= _motion.settledThreshold) && (_motion.stillBatches < SETTLE_NB_BATCHES))
+        _motion.stillBatches++;
+}
+
+/**
+ * @brief Check if enough consecutive still FIFO batches have been filtered for the device to be settled
+ *
+ * @retval 0 Device moving, or settling
+ * @retval 1 Device settled
+ */
+static inline uint8_t isSettled(){
+    return (_motion.stillBatches >= SETTLE_NB_BATCHES);
+}
+
+/**
+ * @brief Feed the FIFO entries retrieved via DMA to the sliding-window filter, and get its output
+ * @note The batch must have been signalled ready by isFIFObatchReady()
+ * @note While the window is not full yet (see isFilterFull()), the values are averaged over the samples gathered so far
+ *
+ * @param[out] values Averaged X, Y and Z axis values
+ * @retval 0 Success
+ * @retval 1 Error while retrieving values from the FIFO
+ */
+static RAMFUNC errorCode_u integrateFIFO(int32_t values[]){
+    //if the DMA retrieval failed, error
+    if(_fifoStatus == FIFO_DRAIN_ERROR){
+        _fifoStatus = FIFO_IDLE;
+        _state = stError;
+        return (createErrorCode(INTEGRATE, 1, ERR_ERROR));
+    }
+
+    //push each of the entries retrieved in the filter
+    for(uint8_t i = 0 ; i < _profile->watermark ; i++)
+        filterSample(_fifoEntries[i]);
+    updateMotion();
 
-    //divide the buffers to average out (Tested : compiler does divide negatives correctly)
-    values[X_AXIS] >>= ADXL_AVG_SHIFT;
-    values[Y_AXIS] >>= ADXL_AVG_SHIFT;
-    values[Z_AXIS] >>= ADXL_AVG_SHIFT;
+    //release the buffer for the next batch
+    //	(if the FIFO refilled above the watermark in the meantime, no new edge will come)
+    _fifoStatus = FIFO_IDLE;
+    if(!LL_GPIO_IsInputPinSet(ADXL_INT1_GPIO_Port, ADXL_INT1_Pin))
+        _watermarkFired = 1;
+
+    //divide the sums to average out (Tested : compiler does divide negatives correctly)
+    //	while the window is filling up, divide by the number of samples gathered so far
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++){
+        if(isFilterFull())
+            values[axis] = _filter.sums[axis] >> _profile->avgShift;
+        else
+            values[axis] = _filter.sums[axis] / _filter.count;
+    }
 
     return (ERR_SUCCESS);
 }
@@ -325,8 +1084,9 @@ static errorCode_u integrateFIFO(int32_t values[]){
  * @brief Set the measurements in relative mode and zero down the values
  */
 void ADXLzeroDown(){
-    _zeroValues[X_AXIS] = -_latestValues[X_AXIS];
-    _zeroValues[Y_AXIS] = -_latestValues[Y_AXIS];
+    _calibration.zeroValues[X_AXIS] = (int16_t)-_latestValues[X_AXIS];
+    _calibration.zeroValues[Y_AXIS] = (int16_t)-_latestValues[Y_AXIS];
+    publishSnapshot();
 }
 
 /**
@@ -334,7 +1094,127 @@ void ADXLzeroDown(){
  */
 void ADXLcancelZeroing(){
     for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++)
-        _zeroValues[axis] = 0;
+        _calibration.zeroValues[axis] = 0;
+    publishSnapshot();
+}
+
+/**
+ * @brief Check if the measurements are in relative mode
+ *
+ * @retval 0 Absolute mode
+ * @retval 1 Relative mode (zeroed down)
+ */
+uint8_t ADXL345isZeroed(){
+    return (_calibration.zeroValues[X_AXIS] || _calibration.zeroValues[Y_AXIS] || _calibration.zeroValues[Z_AXIS]);
+}
+
+/**
+ * @brief Calibrate the hardware offsets with the device lying flat (Z axis pointing up)
+ * @details The biases are corrected by the ADXL itself, which costs no MCU cycles per sample.
+ *          The zeroing is cancelled, as it was computed with the previous offsets.
+ * @note The offsets are applied as soon as no FIFO retrieval is in progress
+ *
+ * @retval 0 Success
+ * @retval 1 ADXL not measuring, filter window not full yet or offsets not applied yet
+ */
+errorCode_u ADXL345calibrateFlat(){
+    static const int32_t FLAT_VALUES[NB_AXIS] = {0, 0, ONE_G_LSB};	///< Values expected with the device lying flat
+
+    if((_state != stMeasuring) || !isFilterFull() || _offsetsPending)
+        return (createErrorCode(CALIBRATE_FLAT, 1, ERR_WARNING));
+
+    //remove the offsets currently applied from the measurements to get the raw biases
+    for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++){
+        int32_t raw = _latestValues[axis] - ((int32_t)_calibration.offsets[axis] * (1 << OFFSET_LSB_SHIFT));
+        _calibration.offsets[axis] = computeOffset(raw - FLAT_VALUES[axis]);
+        _calibration.zeroValues[axis] = 0;
+    }
+
+    _orientationsCaptured = 0;
+    _offsetsPending = 1;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Capture one of the six orientations of a factory calibration
+ * @details Once all six orientations are captured, the bias of each axis is computed as
+ *          the mean between the values measured pointing up and pointing down, then applied as hardware offsets.
+ *          This compensates the biases without depending on the device lying perfectly flat.
+ * @note The device must be kept still in the orientation for the filter window duration before capturing
+ *
+ * @param orientation Orientation in which the device currently lies
+ * @retval 0 Success
+ * @retval 1 Unknown orientation
+ * @retval 2 ADXL not measuring, filter window not full yet or offsets not applied yet
+ */
+errorCode_u ADXL345captureOrientation(adxlOrientation_e orientation){
+    static const uint8_t ALL_ORIENTATIONS = (1U << ADXL_NB_ORIENTATIONS) - 1U;
+
+    if(orientation >= ADXL_NB_ORIENTATIONS)
+        return (createErrorCode(CAPTURE_ORIENT, 1, ERR_WARNING));
+
+    if((_state != stMeasuring) || !isFilterFull() || _offsetsPending)
+        return (createErrorCode(CAPTURE_ORIENT, 2, ERR_WARNING));
+
+    //store the raw value of the axis aligned with gravity (orientations go by pairs for each axis)
+    axis_e axis = (axis_e)(orientation >> 1);
+    _orientationValues[orientation] = _latestValues[axis] - ((int32_t)_calibration.offsets[axis] * (1 << OFFSET_LSB_SHIFT));
+    _orientationsCaptured |= (uint8_t)(1U << orientation);
+
+    //if all orientations captured, compute the biases
+    if(_orientationsCaptured != ALL_ORIENTATIONS)
+        return (ERR_SUCCESS);
+
+    for(uint8_t i = 0 ; i < NB_AXIS ; i++){
+        int32_t bias = (_orientationValues[(i << 1)] + _orientationValues[(i << 1) + 1]) / 2;
+        _calibration.offsets[i] = computeOffset(bias);
+        _calibration.zeroValues[i] = 0;
+    }
+
+    _orientationsCaptured = 0;
+    _offsetsPending = 1;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Get the calibration currently used, to be persisted
+ *
+ * @return Calibration (hardware offsets and zeroing values)
+ */
+const adxlCalibration_t* ADXL345getCalibration(){
+    return (&_calibration);
+}
+
+/**
+ * @brief Restore a calibration previously persisted
+ * @note The hardware offsets are applied at configuration, or as soon as no FIFO retrieval is in progress
+ *
+ * @param calibration Calibration to restore
+ */
+void ADXL345setCalibration(const adxlCalibration_t* calibration){
+    assert(calibration);
+
+    _calibration = *calibration;
+    _orientationsCaptured = 0;
+    _offsetsPending = 1;
+}
+
+/**
+ * @brief Compute the hardware offset compensating a bias
+ *
+ * @param bias Bias to compensate (3.9 mg/LSB)
+ * @return Hardware offset, rounded to the nearest and saturated (15.6 mg/LSB)
+ */
+static int8_t computeOffset(int32_t bias){
+    static const int32_t HALF_OFFSET_LSB = (1 << OFFSET_LSB_SHIFT) >> 1;
+
+    int32_t offset = (bias >= 0 ? -(bias + HALF_OFFSET_LSB) : (HALF_OFFSET_LSB - bias)) / (1 << OFFSET_LSB_SHIFT);
+    if(offset > INT8_MAX)
+        offset = INT8_MAX;
+    else if(offset < INT8_MIN)
+        offset = INT8_MIN;
+
+    return ((int8_t)offset);
 }
 
 
@@ -353,7 +1233,7 @@ static errorCode_u stStartup(){
     uint8_t deviceID = 0;
 
     //if 1s elapsed without reading the correct vendor ID, go error
-    if(!adxlTimer_ms){
+    if(!timerIsRunning(&_timer)){
         _state = stError;
         return (createErrorCode(STARTUP, 1, ERR_CRITICAL));
     }
@@ -379,13 +1259,21 @@ static errorCode_u stStartup(){
  * @retval 1 Error while writing a register
  */
 static errorCode_u stConfiguring(){
-    static const uint8_t initialisationArray[NB_REG_INIT][2] = {
+    _profile = _requestedProfile;
+    const uint8_t initialisationArray[NB_REG_INIT][2] = {
         {DATA_FORMAT,			DATA_FORMAT_DEFAULT},
-        {BANDWIDTH_POWERMODE,	ADXL_POWER_NORMAL | ADXL_RATE_200HZ},
+        {BANDWIDTH_POWERMODE,	ADXL_POWER_NORMAL | _profile->dataRate},
+        {ACTIVITY_THRESHOLD,	ACT_THRESHOLD},
+        {INACTIVITY_THRESHOLD,	INACT_THRESHOLD},
+        {INACTIVITY_TIME,		INACT_TIME_S},
+        {ACTIVITY_CONTROL,		ADXL_ACT_AC_COUPLED | ADXL_ACT_XYZ | ADXL_INACT_AC_COUPLED | ADXL_INACT_XYZ},
+        {OFFSET_X,				(uint8_t)_calibration.offsets[X_AXIS]},
+        {OFFSET_Y,				(uint8_t)_calibration.offsets[Y_AXIS]},
+        {OFFSET_Z,				(uint8_t)_calibration.offsets[Z_AXIS]},
         {FIFO_CONTROL,			ADXL_MODE_BYPASS},		//clear the FIFOs first (blocks otherwise)
-        {FIFO_CONTROL,			FIFO_CONTROL_DEFAULT},
+        {FIFO_CONTROL,			fifoControlValue()},
         {POWER_CONTROL,			ADXL_MEASURE_MODE},		///
-        {INTERRUPT_ENABLE,		ADXL_INT_WATERMARK},	///must come at the end
+        {INTERRUPT_ENABLE,		INTERRUPTS_MEASURING},	///must come at the end
     };
 
     //write all registers values from the initialisation array
@@ -397,9 +1285,10 @@ static errorCode_u stConfiguring(){
         }
     }
 
-    //reset the timer and get to next state
-    adxlTimer_ms = INT_TIMEOUT_MS;
-    _state = stMeasuringST_OFF;
+    //reset the timer and get to next state (skip the self-test if it already passed)
+    _offsetsPending = 0;
+    timerStart(&_timer, INT_TIMEOUT_MS);
+    _state = (_skipSelfTest ? stMeasuring : stMeasuringST_OFF);
     return (_result);
 }
 
@@ -415,22 +1304,26 @@ static errorCode_u stConfiguring(){
  */
 static errorCode_u stMeasuringST_OFF(){
     //if timeout, go error
-    if(!adxlTimer_ms){
+    if(!timerIsRunning(&_timer)){
         _state = stError;
         return (createErrorCode(SELF_TESTING_OFF, 1, ERR_ERROR));
     }
 
-    //if watermark interrupt not fired, exit
-    if(!isFIFOdataReady())
+    //if FIFO entries not retrieved yet, exit
+    if(!isFIFObatchReady())
         return (ERR_SUCCESS);
 
     //retrieve the integrated measurements (to be used with self-testing)
-    _result = integrateFIFO(_latestValues);
+    PROFILE(integrateFIFO, _result = integrateFIFO(_latestValues));
     if(isError(_result)){
         _state = stError;
         return (pushErrorCode(_result, SELF_TESTING_OFF, 2));
     }
 
+    //if not enough samples to fill the filter window yet, exit
+    if(!isFilterFull())
+        return (ERR_SUCCESS);
+
     //Enable the self-test
     _result = writeRegister(DATA_FORMAT, DATA_FORMAT_DEFAULT | ADXL_SELF_TEST);
     if(isError(_result)){
@@ -444,10 +1337,12 @@ static errorCode_u stMeasuringST_OFF(){
         _state = stError;
         return (pushErrorCode(_result, SELF_TESTING_OFF, 4));
     }
+    _watermarkFired = 0;
+    resetFilter();
 
     //set timer to wait for 25ms and get to next state
     static const uint8_t ST_WAIT_MS = 25U;  ///< Number of milliseconds to wait for self-testing to be operating
-    adxlTimer_ms = ST_WAIT_MS;
+    timerStart(&_timer, ST_WAIT_MS);
     _state = stWaitingForSTenabled;
     return (ERR_SUCCESS);
 }
@@ -460,18 +1355,18 @@ static errorCode_u stMeasuringST_OFF(){
  */
 static errorCode_u stWaitingForSTenabled(){
     //if timer not elapsed yet, exit
-    if(!adxlTimer_ms)
+    if(timerIsRunning(&_timer))
         return (ERR_SUCCESS);
 
     //enable FIFOs
-    _result = writeRegister(FIFO_CONTROL, FIFO_CONTROL_DEFAULT);
+    _result = writeRegister(FIFO_CONTROL, fifoControlValue());
     if(isError(_result)){
         _state = stError;
         return (pushErrorCode(_result, SELF_TEST_WAIT, 1)); 	// @suppress("Avoid magic numbers")
     }
 
     //reset timer and get to next state
-    adxlTimer_ms = INT_TIMEOUT_MS;
+    timerStart(&_timer, INT_TIMEOUT_MS);
     _state = stMeasuringST_ON;
     return (ERR_SUCCESS);
 }
@@ -497,22 +1392,26 @@ static errorCode_u stMeasuringST_ON(){
     int32_t STdeltas[NB_AXIS];
 
     //if timeout, go error
-    if(!adxlTimer_ms){
+    if(!timerIsRunning(&_timer)){
         _state = stError;
         return (createErrorCode(SELF_TESTING_ON, 1, ERR_ERROR));
     }
 
-    //if watermark interrupt not fired, exit
-    if(!isFIFOdataReady())
+    //if FIFO entries not retrieved yet, exit
+    if(!isFIFObatchReady())
         return (ERR_SUCCESS);
 
     //integrate the FIFOs
-    _result = integrateFIFO(STdeltas);
+    PROFILE(integrateFIFO, _result = integrateFIFO(STdeltas));
     if(isError(_result)){
         _state = stError;
         return (pushErrorCode(_result, SELF_TESTING_ON, 2));
     }
 
+    //if not enough samples to fill the filter window yet, exit
+    if(!isFilterFull())
+        return (ERR_SUCCESS);
+
     //compute the self-test deltas
     STdeltas[X_AXIS] -= _latestValues[X_AXIS];
     STdeltas[Y_AXIS] -= _latestValues[Y_AXIS];
@@ -523,6 +1422,7 @@ static errorCode_u stMeasuringST_ON(){
         || (STdeltas[Y_AXIS] <= ST_MAXDELTAS[Y_AXIS][0]) || (STdeltas[Y_AXIS] >= ST_MAXDELTAS[Y_AXIS][1])
         || (STdeltas[Z_AXIS] <= ST_MAXDELTAS[Z_AXIS][0]) || (STdeltas[Z_AXIS] >= ST_MAXDELTAS[Z_AXIS][1]))
     {
+        LL_RTC_BKP_SetRegister(BKP, ST_PASSED_REGISTER, 0);
         _state = stError;
         return (pushErrorCode(_result, SELF_TESTING_ON, 3));
     }
@@ -533,9 +1433,13 @@ static errorCode_u stMeasuringST_ON(){
         _state = stError;
         return (pushErrorCode(_result, SELF_TESTING_ON, 4));
     }
+    resetFilter();
+
+    //record the self-test success so that it can be skipped after a warm reset
+    LL_RTC_BKP_SetRegister(BKP, ST_PASSED_REGISTER, ST_PASSED_RECORD);
 
     //reset timer and get to next state
-    adxlTimer_ms = INT_TIMEOUT_MS;
+    timerStart(&_timer, INT_TIMEOUT_MS);
     _state = stMeasuring;
     return (ERR_SUCCESS);
 }
@@ -549,26 +1453,100 @@ static errorCode_u stMeasuringST_ON(){
  */
 static errorCode_u stMeasuring(){
     //if timeout, go error
-    if(!adxlTimer_ms){
+    if(!timerIsRunning(&_timer)){
         _state = stError;
         return (createErrorCode(MEASURE, 1, ERR_ERROR));
     }
 
-    //if watermark interrupt not fired, exit
-    if(!isFIFOdataReady())
+    //if a new profile is requested and no FIFO retrieval is in progress, apply it in the background
+    if((_requestedProfile != _profile) && (_fifoStatus == FIFO_IDLE)){
+        applyProfile(0);
+        _state = stAccessingRegisters;
+        return (stAccessingRegisters());
+    }
+
+    //if new hardware offsets are requested and no FIFO retrieval is in progress, apply them in the background
+    if(_offsetsPending && (_fifoStatus == FIFO_IDLE)){
+        applyOffsets();
+        _state = stAccessingRegisters;
+        return (stAccessingRegisters());
+    }
+
+    //if FIFO entries not retrieved yet, exit
+    if(!isFIFObatchReady())
         return (ERR_SUCCESS);
 
     //reset flags
-    adxlTimer_ms = INT_TIMEOUT_MS;
+    timerStart(&_timer, INT_TIMEOUT_MS);
 
     //integrate the FIFOs
-    _result = integrateFIFO(_latestValues);
+    PROFILE(integrateFIFO, _result = integrateFIFO(_latestValues));
     if(isError(_result)){
         _state = stError;
         return (pushErrorCode(_result, MEASURE, 2));
     }
 
-    _measurementsUpdated = 1;
+    publishSnapshot();
+
+    //with the adaptive profile, shorten the window while moving and lengthen it once settled
+    if(_adaptive)
+        _requestedProfile = &PROFILES[isSettled() ? ADXL_PROFILE_PRECISE : ADXL_PROFILE_ADAPTIVE];
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief State in which the register accesses queued are exchanged one after the other, before getting back to measurements
+ * @details Each access is submitted once the previous one ended, so that the main loop never waits for the SPI bus
+ *
+ * @retval 0 Success
+ * @retval 1 Timeout while accessing a register
+ * @retval 2 Error occurred during the DMA transfer
+ * @retval 3 Error while submitting the next access
+ */
+static errorCode_u stAccessingRegisters(){
+    //if the access in progress has not ended yet, exit
+    if(spiIsPending(&_registerTransaction))
+        return (ERR_SUCCESS);
+
+    //if timeout or DMA error, go error
+    if(_registerTransaction.status != SPI_DONE){
+        _state = stError;
+        return (createErrorCode(ACCESSING_REGISTERS, (_registerTransaction.status == SPI_TIMEOUT ? 1 : 2), ERR_ERROR));
+    }
+
+    //if accesses remain, submit the next one
+    if(_registerAccessesSent < _nbRegisterAccesses){
+        _registerTransaction.tx = _registerAccesses[_registerAccessesSent];
+        _registerTransaction.rx = _registerReplies[_registerAccessesSent];
+        _registerAccessesSent++;
+
+        _result = spiBusSubmit(_bus, &_registerTransaction);
+        if(isError(_result)){
+            _state = stError;
+            return (pushErrorCode(_result, ACCESSING_REGISTERS, 3));
+        }
+        return (ERR_SUCCESS);
+    }
+
+    //all accesses done, count the FIFO entries discarded as samples lost by the telemetry stream
+    if(_fifoEntriesAccess < _nbRegisterAccesses)
+        telemetryDropSamples(_registerReplies[_fifoEntriesAccess][1] & ADXL_FIFO_ENTRIES);
+
+    //reset the timer and get back to measurements
+    _nbRegisterAccesses = _registerAccessesSent = 0;
+    _fifoEntriesAccess = NB_REG_ACCESSES;
+    timerStart(&_timer, INT_TIMEOUT_MS);
+    _state = stMeasuring;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief State in which the ADXL is in low-power mode, waiting for ADXL345resume()
+ *
+ * @return Success
+ */
+static errorCode_u stSuspended(){
     return (ERR_SUCCESS);
 }
 
@@ -580,3 +1558,80 @@ static errorCode_u stMeasuring(){
 static errorCode_u stError(){
     return (ERR_SUCCESS);
 }
+
+#if defined(BENCHMARK)
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Fill the FIFO entries buffer with a step of a simulated tilt sweep, as if retrieved via DMA
+ * @details The sweep tilts the device from -80° to +80° around the roll axis, and half as much around the pitch axis,
+ *          with a deterministic jitter of a few LSB on each entry
+ * @note To be called before ADXL345initialise(), which resets the filter
+ *
+ * @param step Step of the sweep (0 to BENCHMARK_NB_STEPS - 1)
+ */
+void ADXL345benchmarkLoad(uint16_t step){
+    static const float SWEEP_RADIANS = 80.0f * (float)(M_PI / 180.0);	///< Largest roll angle of the sweep
+    float roll = ((2.0f * (float)step / (float)(BENCHMARK_NB_STEPS - 1U)) - 1.0f) * SWEEP_RADIANS;
+    float pitch = roll * 0.5f;
+    const int16_t axes[NB_AXIS] = {
+        (int16_t)((float)ONE_G_LSB * sinf(roll)),
+        (int16_t)((float)ONE_G_LSB * sinf(pitch)),
+        (int16_t)((float)ONE_G_LSB * cosf(roll) * cosf(pitch)),
+    };
+
+    for(uint8_t entry = 0 ; entry < _profile->watermark ; entry++){
+        int16_t jitter = (int16_t)((int16_t)((step + entry) % 5U) - 2);
+
+        //entries are stored after the reply to the read request, LSB first
+        for(uint8_t axis = 0 ; axis < NB_AXIS ; axis++){
+            uint16_t value = (uint16_t)(axes[axis] + jitter);
+            _fifoEntries[entry][(axis << 1) + 1] = (uint8_t)value;
+            _fifoEntries[entry][(axis << 1) + 2] = (uint8_t)(value >> 8);
+        }
+    }
+
+    _fifoStatus = FIFO_BATCH_READY;
+}
+
+/**
+ * @brief Run the FIFO entries loaded through the sample-to-angle path, recording the duration of each stage
+ *
+ * @param[out] angles Roll and pitch angles computed (in tenths of degrees)
+ */
+void ADXL345benchmarkStep(int16_t angles[2]){
+    uint32_t start = profilerNow();
+    integrateFIFO(_latestValues);
+    benchmarkRecord(BENCH_INTEGRATE_FIFO, profilerNow() - start);
+
+    start = profilerNow();
+    angles[0] = computeAngleDegreesTenths(X_AXIS);
+    benchmarkRecord(BENCH_ANGLE, profilerNow() - start);
+    angles[1] = computeAngleDegreesTenths(Y_AXIS);
+
+    //the INT1 pin read by integrateFIFO() means nothing before the start-up
+    _watermarkFired = 0;
+}
+
+/**
+ * @brief Record the deviation of the angle kernel from the atanf() version, for gravity tilted by an angle
+ * @details Both versions get the same axis values (measured at full resolution, ONE_G_LSB per g)
+ *          and truncate their result the same way, so the deviation only comes from the lookup table.
+ *          It is 0 when the kernel is the atanf() version itself (ADXL_FIXED_POINT_ATAN not defined).
+ *
+ * @param angleTenths Tilt angle (in tenths of degrees, within +/- 89°)
+ */
+void ADXL345benchmarkAccuracy(int16_t angleTenths){
+    static const float TENTHS_TO_RADIANS = (float)(M_PI / 1800.0);
+    int32_t numerator = (int32_t)lroundf((float)ONE_G_LSB * sinf((float)angleTenths * TENTHS_TO_RADIANS));
+    int32_t denominator = (int32_t)lroundf((float)ONE_G_LSB * cosf((float)angleTenths * TENTHS_TO_RADIANS));
+
+    if(!denominator)
+        return;
+
+    int16_t deviation = (int16_t)(atanDegreesTenths(numerator, denominator) - atanfDegreesTenths(numerator, denominator));
+    benchmarkRecord(BENCH_ANGLE_ERROR, (uint32_t)(deviation < 0 ? -deviation : deviation));
+}
+#endif
@@ -1,62 +1,165 @@
 /**
- * @brief Implement the GPIO buttons state and debouncing
+ * @brief Implement the GPIO buttons state, debouncing and gestures
  * @author Gilles Henrard
  * @date 08/03/2024
+ *
+ * @details
+ * Each edge on a button pin triggers its EXTI line, which only timestamps it.
+ * The debouncing, holding and gestures are then worked out lazily from the timestamps, when the state machines run.
+ * A button is debounced once its pin has not changed for DEBOUNCE_TIME_MS.
+ *
+ * The state machines only need to be run again while a button is busy (see buttonsUpdate()),
+ * so nothing is polled while all the buttons are idle, pressed down or held down.
+ *
+ * Buttons are described in the BUTTONS table : adding one only requires a new entry,
+ * and its pin configured as an EXTI on both edges (see the .ioc) with its interrupt routed to buttonsInterrupt().
  */
 #include <main.h>
 #include "buttons.h"
+#include "timers.h"
+#include "profiler.h"
 
-#define DEBOUNCE_TIME_MS        50U;    ///< Number of milliseconds to wait for debouncing
-#define HOLDING_TIME_MS         1000U;  ///< Number of milliseconds to wait before considering a button is held down
-#define EDGEDETECTION_TIME_MS   40U;    ///< Number of milliseconds during which a falling/rising edge can be detected
-
-//machine state
-static void stReleased(button_e button);
-static void stPressed(button_e button);
-static void stHeldDown(button_e button);
+#define DEBOUNCE_TIME_MS        50U     ///< Number of milliseconds a pin must remain unchanged to be debounced
+#define HOLDING_TIME_MS         1000U   ///< Number of milliseconds to wait before considering a button is held down
+#define EDGEDETECTION_TIME_MS   40U     ///< Number of milliseconds during which a falling/rising edge can be detected
+#define DOUBLECLICK_TIME_MS     300U    ///< Number of milliseconds after a click during which a second one makes a double-click
 
 /**
  * @brief State machine state prototype
  *
- * @return Error code of the state
+ * @param button    Button for which run the state
+ * @param now       Current system tick
  */
-typedef void (*gpioState)(button_e button);
+typedef void (*gpioState)(button_e button, uint32_t now);
 
 /**
  * @brief Structure defining a button GPIO
  */
 typedef struct{
-    GPIO_TypeDef*   port;   ///< GPIO port used
-    uint32_t        pin;    ///< GPIO pin used
-    gpioState       state;  ///< Current button state
+    GPIO_TypeDef*   port;       ///< GPIO port used
+    uint32_t        pin;        ///< GPIO pin used
+    uint32_t        extiLine;   ///< EXTI line triggered by the pin edges
 }button_t;
 
-gpioTimer_t buttonsTimers[NB_BUTTONS];  ///< Array of timers used by the buttons
+/**
+ * @brief Structure holding the state of a button
+ */
+typedef struct{
+    gpioState           state;          ///< Current button state
+    volatile uint32_t   lastEdge_ms;    ///< System tick of the latest edge on the pin (set by the EXTI interrupt)
+    uint32_t            pressed_ms;     ///< System tick at which the current press has been debounced
+    uint32_t            released_ms;    ///< System tick at which the latest click has been debounced
+    uint8_t             nbClicks;       ///< Number of clicks waiting for the double-click window to close
+    buttonGesture_e     gesture;        ///< Latest gesture recognised, not popped yet
+    softTimer_t         risingEdge;     ///< Timer used to detect a rising edge
+    softTimer_t         fallingEdge;    ///< Timer used to detect a falling edge
+}buttonState_t;
+
+//machine state
+static void stReleased(button_e button, uint32_t now);
+static void stPressed(button_e button, uint32_t now);
+static void stHeldDown(button_e button, uint32_t now);
+static void stWaitingRelease(button_e button, uint32_t now);
+
+//tool functions
+static inline uint8_t isPinDown(button_e button);
+static inline uint8_t isDebounced(button_e button, uint32_t now);
+static uint8_t isBusy(button_e button, uint32_t now);
 
 /**
- * @brief Buttons initialisation array
+ * @brief Buttons description table
  */
-static button_t buttons[NB_BUTTONS] = {
-    [ZERO] = {ZERO_BUTTON_GPIO_Port, ZERO_BUTTON_Pin, stReleased},
-    [HOLD] = {HOLD_BUTTON_GPIO_Port, HOLD_BUTTON_Pin, stReleased},
+static const button_t BUTTONS[NB_BUTTONS] = {
+    [ZERO] = {ZERO_BUTTON_GPIO_Port, ZERO_BUTTON_Pin, ZERO_BUTTON_EXTI_LINE},
+    [HOLD] = {HOLD_BUTTON_GPIO_Port, HOLD_BUTTON_Pin, HOLD_BUTTON_EXTI_LINE},
 };
 
+static buttonState_t _buttons[NB_BUTTONS];  ///< State of each button
+
 
 /********************************************************************************************************************************************/
 /********************************************************************************************************************************************/
 
 
+/**
+ * @brief Drop the edges pending, and start the state machines
+ * @note The EXTI lines must already be configured on both edges (see MX_GPIO_Init())
+ * @note A button pushed at start-up is signalled once debounced
+ */
+void buttonsInitialise(){
+    for(uint8_t i = 0 ; i < NB_BUTTONS ; i++){
+        _buttons[i] = (buttonState_t){.state = stReleased, .lastEdge_ms = systemTick_ms, .gesture = GESTURE_NONE};
+        LL_EXTI_ClearFlag_0_31(BUTTONS[i].extiLine);
+    }
+}
+
+/**
+ * @brief Timestamp the edges on the buttons pins
+ * @note To be called from the EXTI lines interrupt handlers (also wakes the MCU up from Stop mode)
+ */
+void buttonsInterrupt(){
+    for(uint8_t i = 0 ; i < NB_BUTTONS ; i++){
+        if(LL_EXTI_IsActiveFlag_0_31(BUTTONS[i].extiLine)){
+            LL_EXTI_ClearFlag_0_31(BUTTONS[i].extiLine);
+            _buttons[i].lastEdge_ms = systemTick_ms;
+        }
+    }
+}
+
 /**
  * @brief Run each button's state machine
+ *
+ * @retval 0 All buttons idle, nothing to do until the next edge
+ * @retval 1 At least one button busy (debouncing, waiting to be held down or for a double-click), to be run again shortly
  */
-void buttonsUpdate(){
-    for(uint8_t i = 0 ; i < NB_BUTTONS ; i++)
-        (*buttons[i].state)(i);
+uint8_t buttonsUpdate(){
+    uint32_t now = systemTick_ms;
+    uint8_t busy = 0;
+
+    for(uint8_t i = 0 ; i < NB_BUTTONS ; i++){
+        PROFILE(_buttons[i].state, (*_buttons[i].state)(i, now));
+        busy |= isBusy(i, now);
+    }
+
+    return (busy);
+}
+
+/**
+ * @brief Restart the state machines after the Stop mode
+ * @note The press which woke the MCU up is ignored until the button is released
+ */
+void buttonsResume(){
+    //SysTick is frozen in Stop mode, so the edges which woke the MCU up may be timestamped before it
+    uint32_t now = systemTick_ms;
+
+    for(uint8_t i = 0 ; i < NB_BUTTONS ; i++){
+        _buttons[i].lastEdge_ms = now;
+        _buttons[i].nbClicks = 0;
+        _buttons[i].gesture = GESTURE_NONE;
+        timerStop(&_buttons[i].risingEdge);
+        timerStop(&_buttons[i].fallingEdge);
+        _buttons[i].state = stWaitingRelease;
+    }
+}
+
+/**
+ * @brief Check if any of the buttons is physically pushed down (no debouncing)
+ *
+ * @retval 0 All buttons released
+ * @retval 1 At least one button pushed
+ */
+uint8_t isAnyButtonDown(){
+    for(uint8_t i = 0 ; i < NB_BUTTONS ; i++){
+        if(isPinDown(i))
+            return 1;
+    }
+
+    return 0;
 }
 
 /**
  * @brief Check if a button is released
- * 
+ *
  * @param button    Button to check
  * @retval 0        Button is pressed
  * @retval 1        Button is released
@@ -65,12 +168,12 @@ uint8_t isButtonReleased(button_e button){
     if(button >= NB_BUTTONS)
         return 0;
 
-    return (buttons[button].state == stReleased);
+    return (_buttons[button].state == stReleased);
 }
 
 /**
  * @brief Check if a button is pressed or held down
- * 
+ *
  * @param button    Button to check
  * @retval 0        Button is released
  * @retval 1        Button is pressed
@@ -79,13 +182,13 @@ uint8_t isButtonPressed(button_e button){
     if(button >= NB_BUTTONS)
         return 0;
 
-    return ((buttons[button].state == stPressed)
-            || (buttons[button].state == stHeldDown));
+    return ((_buttons[button].state == stPressed)
+            || (_buttons[button].state == stHeldDown));
 }
 
 /**
  * @brief Check if a button is held down
- * 
+ *
  * @param button    Button to check
  * @retval 0        Button is released or not yet held down
  * @retval 1        Button is held down
@@ -94,13 +197,13 @@ uint8_t isButtonHeldDown(button_e button){
     if(button >= NB_BUTTONS)
         return 0;
 
-    return (buttons[button].state == stHeldDown);
+    return (_buttons[button].state == stHeldDown);
 }
 
 /**
  * @brief Check if a button has recently had a rising edge
  * @details Rising edge occurrs when a button goes from released to pressed
- * 
+ *
  * @param button    Button to check
  * @retval 0        Button has not had a rising edge
  * @retval 1        Button has had a rising edge
@@ -109,8 +212,8 @@ uint8_t buttonHasRisingEdge(button_e button){
     if(button >= NB_BUTTONS)
         return 0;
 
-    uint8_t tmp = buttonsTimers[button].risingEdge_ms;
-    buttonsTimers[button].risingEdge_ms = 0;
+    uint8_t tmp = timerIsRunning(&_buttons[button].risingEdge);
+    timerStop(&_buttons[button].risingEdge);
 
     return (tmp > 0);
 }
@@ -118,7 +221,7 @@ uint8_t buttonHasRisingEdge(button_e button){
 /**
  * @brief Check if a button has recently had a falling edge
  * @details Rising edge occurrs when a button goes from pressed to released
- * 
+ *
  * @param button    Button to check
  * @retval 0        Button has not had a falling edge
  * @retval 1        Button has had a falling edge
@@ -127,12 +230,29 @@ uint8_t buttonHasFallingEdge(button_e button){
     if(button >= NB_BUTTONS)
         return 0;
 
-    uint8_t tmp = buttonsTimers[button].fallingEdge_ms;
-    buttonsTimers[button].fallingEdge_ms = 0;
+    uint8_t tmp = timerIsRunning(&_buttons[button].fallingEdge);
+    timerStop(&_buttons[button].fallingEdge);
 
     return (tmp > 0);
 }
 
+/**
+ * @brief Get the latest gesture recognised on a button, and forget it
+ * @note A click is only recognised once the double-click window closed
+ *
+ * @param button    Button to check
+ * @return Latest gesture (GESTURE_NONE if none since the latest call)
+ */
+buttonGesture_e buttonPopGesture(button_e button){
+    if(button >= NB_BUTTONS)
+        return (GESTURE_NONE);
+
+    buttonGesture_e gesture = _buttons[button].gesture;
+    _buttons[button].gesture = GESTURE_NONE;
+
+    return (gesture);
+}
+
 
 /********************************************************************************************************************************************/
 /********************************************************************************************************************************************/
@@ -140,63 +260,133 @@ uint8_t buttonHasFallingEdge(button_e button){
 
 /**
  * @brief State in which the button is released
- * 
- * @param button Button for which run the state
+ *
+ * @param button    Button for which run the state
+ * @param now       Current system tick
  */
-static void stReleased(button_e button){
-    //if button released, restart debouncing timer
-    if(LL_GPIO_IsInputPinSet(buttons[button].port, buttons[button].pin))
-        buttonsTimers[button].debouncing_ms = DEBOUNCE_TIME_MS;
+static void stReleased(button_e button, uint32_t now){
+    buttonState_t* current = &_buttons[button];
+
+    //if the double-click window closed on a single click, signal it
+    if(current->nbClicks && ((now - current->released_ms) >= DOUBLECLICK_TIME_MS)){
+        current->gesture = GESTURE_CLICK;
+        current->nbClicks = 0;
+    }
 
     //if button not pressed for long enough, exit
-    if(buttonsTimers[button].debouncing_ms)
+    if(!isPinDown(button) || !isDebounced(button, now))
         return;
 
     //set the timer during which rising edge can be read, and get to pressed state
-    buttonsTimers[button].risingEdge_ms = EDGEDETECTION_TIME_MS;
-    buttonsTimers[button].holding_ms = HOLDING_TIME_MS;
-    buttons[button].state = stPressed;
+    timerStart(&current->risingEdge, EDGEDETECTION_TIME_MS);
+    current->pressed_ms = now;
+    current->state = stPressed;
 }
 
 /**
  * @brief State in which the button is pressed, but not yet held
- * 
- * @param button Button for which run the state
+ *
+ * @param button    Button for which run the state
+ * @param now       Current system tick
  */
-static void stPressed(button_e button){
-    //if button pressed, restart debouncing timer
-    if(!LL_GPIO_IsInputPinSet(buttons[button].port, buttons[button].pin)){
-        buttonsTimers[button].debouncing_ms = DEBOUNCE_TIME_MS;
-
-        //if button maintained for long enough, get to held down state
-        if(!buttonsTimers[button].holding_ms)
-            buttons[button].state = stHeldDown;
+static void stPressed(button_e button, uint32_t now){
+    buttonState_t* current = &_buttons[button];
+
+    //if button maintained for long enough, get to held down state (no click then)
+    if(isPinDown(button)){
+        if((now - current->pressed_ms) >= HOLDING_TIME_MS){
+            current->gesture = GESTURE_LONG_PRESS;
+            current->nbClicks = 0;
+            current->state = stHeldDown;
+        }
+        return;
     }
 
     //if button not released for long enough, exit
-    if(buttonsTimers[button].debouncing_ms)
+    if(!isDebounced(button, now))
         return;
 
-    //set the timer during which falling edge can be read, and get to pressed state
-    buttonsTimers[button].fallingEdge_ms = EDGEDETECTION_TIME_MS;
-    buttons[button].state = stReleased;
+    //count the click, signal a double-click right away
+    current->nbClicks++;
+    if(current->nbClicks >= 2U){
+        current->gesture = GESTURE_DOUBLE_CLICK;
+        current->nbClicks = 0;
+    }
+
+    //set the timer during which falling edge can be read, and get to released state
+    timerStart(&current->fallingEdge, EDGEDETECTION_TIME_MS);
+    current->released_ms = now;
+    current->state = stReleased;
 }
 
 /**
  * @brief State in which the button is held down
- * 
- * @param button Button for which run the state
+ *
+ * @param button    Button for which run the state
+ * @param now       Current system tick
  */
-static void stHeldDown(button_e button){
-    //if button pressed, restart debouncing timer
-    if(!LL_GPIO_IsInputPinSet(buttons[button].port, buttons[button].pin))
-        buttonsTimers[button].debouncing_ms = DEBOUNCE_TIME_MS;
+static void stHeldDown(button_e button, uint32_t now){
+    //if button not released for long enough, exit
+    if(isPinDown(button) || !isDebounced(button, now))
+        return;
 
+    //set the timer during which falling edge can be read, and get to released state
+    timerStart(&_buttons[button].fallingEdge, EDGEDETECTION_TIME_MS);
+    _buttons[button].state = stReleased;
+}
+
+/**
+ * @brief State in which the button waits to be released, without signalling any edge
+ *
+ * @param button    Button for which run the state
+ * @param now       Current system tick
+ */
+static void stWaitingRelease(button_e button, uint32_t now){
     //if button not released for long enough, exit
-    if(buttonsTimers[button].debouncing_ms)
+    if(isPinDown(button) || !isDebounced(button, now))
         return;
 
-    //set the timer during which falling edge can be read, and get to pressed state
-    buttonsTimers[button].fallingEdge_ms = EDGEDETECTION_TIME_MS;
-    buttons[button].state = stReleased;
+    _buttons[button].state = stReleased;
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Check if a button pin is pushed down (active low)
+ *
+ * @param button    Button to check
+ * @retval 0        Pin released
+ * @retval 1        Pin pushed down
+ */
+static inline uint8_t isPinDown(button_e button){
+    return (!LL_GPIO_IsInputPinSet(BUTTONS[button].port, BUTTONS[button].pin));
+}
+
+/**
+ * @brief Check if a button pin has not changed for long enough to be debounced
+ *
+ * @param button    Button to check
+ * @param now       Current system tick
+ * @retval 0        Pin still bouncing
+ * @retval 1        Pin debounced
+ */
+static inline uint8_t isDebounced(button_e button, uint32_t now){
+    return ((now - _buttons[button].lastEdge_ms) >= DEBOUNCE_TIME_MS);
+}
+
+/**
+ * @brief Check if a button state machine must be run again without waiting for an edge
+ *
+ * @param button    Button to check
+ * @param now       Current system tick
+ * @retval 0        Button idle until its next edge
+ * @retval 1        Button debouncing, waiting to be held down or for a double-click
+ */
+static uint8_t isBusy(button_e button, uint32_t now){
+    const buttonState_t* current = &_buttons[button];
+
+    return (!isDebounced(button, now) || (current->state == stPressed) || current->nbClicks);
 }
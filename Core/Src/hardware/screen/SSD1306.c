@@ -5,25 +5,76 @@
  * @date 09/03/2024
  *
  * @note Datasheet : https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
+ * @note At start-up, the configuration commands and the base screen are sent from flash by two DMA transfers.
+ * @note Two back-ends are available at build time :
+ *       - partial updates (default) : only the regions of the framebuffer modified are flushed, once per frame
+ *       - SSD1306_CIRCULAR_DMA : the whole framebuffer is streamed continuously by a circular DMA, drawings only write pixels
  */
 #include "SSD1306.h"
 #include "numbersVerdana16.h"
 #include "SSD1306_registers.h"
 #include "icons.h"
+#include "baseScreen.h"
+#include "timers.h"
+#include "profiler.h"
+#include "events.h"
+#if defined(BENCHMARK)
+#include "benchmark.h"
+#endif
 #include <assert.h>
 
 //definitions
-#define REFTYPE_PAGE        SSD_LAST_PAGE
-#define REFTYPE_COLUMN      (SSD_LAST_COLUMN - REFERENCETYPE_NB_BYTES)
-#define SPI_TIMEOUT_MS		10U		///< Maximum number of milliseconds SPI traffic should last before timeout
-#define MAX_DATA_SIZE		1024U	///< Maximum SSD1306 data size (128 * 64 pixels / 8 pixels per byte)
-#define ANGLE_NB_CHARS		6U		///< Number of characters in the angle array
-#define SSD_LAST_COLUMN		127U	///< Index of the highest column
-#define SSD_LAST_PAGE		31U		///< Index of the highest page
+#define ICONS_PAGE			SSD_LAST_PAGE								///< Page at which the referential, hold and stability icons are drawn
+#define REFTYPE_COLUMN		(SSD_NB_COLUMNS - REFERENCETYPE_WIDTH)	///< First column of the referential icon
+#define HOLD_COLUMN			(REFTYPE_COLUMN - HOLDICON_WIDTH)	///< First column of the hold icon
+#define STABILITY_COLUMN	(HOLD_COLUMN - STABILITYICON_WIDTH)	///< First column of the stability icon
+#define CMD_MAX_PARAMETERS	6U		///< Maximum number of parameters a command can have
+#define RESET_PULSE_MS		2U		///< Number of milliseconds the RES pin is held low (at least 1ms with the SysTick timers, 3us required)
+#define RESET_RECOVERY_MS	2U		///< Number of milliseconds to wait after RES is released, before sending commands
+#define SSD_NB_COLUMNS		128U	///< Number of columns of the screen
+#define SSD_NB_PAGES		8U		///< Number of pages of the screen (8 pixels high each)
+#define MAX_DATA_SIZE		(SSD_NB_COLUMNS * SSD_NB_PAGES)	///< Maximum SSD1306 data size (128 * 64 pixels / 8 pixels per byte)
+#define ANGLE_NB_CHARS		6U		///< Number of characters in the angle array (sign, number field and unit)
+#define NUMBER_NB_CHARS		(ANGLE_NB_CHARS - 2U)	///< Number of characters of the number field (digits and decimal point)
+#define SSD_LAST_COLUMN		(SSD_NB_COLUMNS - 1U)	///< Index of the highest column
+#define SSD_LAST_PAGE		(SSD_NB_PAGES - 1U)		///< Index of the highest page
+#define REGION_OVERHEAD		16U		///< Estimated cost of flushing one more region (addressing commands and DMA set-up, in bytes)
+#define DRAW_QUEUE_SIZE		8U		///< Maximum number of drawings waiting to be rendered (power of two)
+#define ADDRESSING_NB_BYTES	6U		///< Number of bytes of the COLUMN_ADDRESS and PAGE_ADDRESS commands (with parameters)
+#define ANGLE_HYSTERESIS	1U		///< Default amount of tenths of degrees an angle must exceed before being redrawn
+#define ANGLE_UNKNOWN		INT16_MIN	///< Value used when no angle is displayed
+#define UNIT_UNKNOWN		NB_UNITS	///< Unit used when no angle is displayed
+#define GLYPH_UNKNOWN		NB_NUMBERS	///< Glyph index used when no character is displayed
+#define FRAME_RATE_FPS		25U		///< Default target number of frames flushed per second
+#define FRAME_MIN_INTERVAL_MS	20U	///< Default minimum number of milliseconds between the start of two frames
+#define FPS_WINDOW_MS		1000U	///< Number of milliseconds over which the achieved frame rate is measured
+#define BUBBLE_CENTER		32U		///< Column and row of the bubble level centre
+#define BUBBLE_RING_RADIUS	30U		///< Radius of the bubble level outer ring (in pixels)
+#define BUBBLE_RADIUS		4U		///< Radius of the bubble (in pixels)
+#define BUBBLE_TARGET_RADIUS	(BUBBLE_RADIUS + 2U)	///< Radius of the ring in which the bubble is when level (in pixels)
+#define BUBBLE_TRAVEL		(BUBBLE_RING_RADIUS - BUBBLE_RADIUS - 1U)	///< Maximum distance between the bubble and the centre (in pixels)
+#define BUBBLE_RANGE_TENTHS	100		///< Angle at which the bubble touches the outer ring (in tenths of degrees)
+#define BUBBLE_UNKNOWN		UINT8_MAX	///< Position used when no bubble is displayed
+#define GRAPH_DIVIDER_COLUMN	64U	///< Column of the line separating the bubble level from the graphs
+#define GRAPH_FIRST_COLUMN	66U		///< First column of the graphs
+#define GRAPH_NB_COLUMNS	(SSD_NB_COLUMNS - GRAPH_FIRST_COLUMN)	///< Number of columns of the graphs
+#define GRAPH_RANGE_COLUMN	(GRAPH_FIRST_COLUMN - 1U)	///< Column of the bar showing the range of the angles since the latest reset
+#define GRAPH_PEAK_COLUMN	(GRAPH_DIVIDER_COLUMN - 1U)	///< Column of the mark showing the peak angle since the latest reset
+#define GRAPH_NB_PAGES		(SSD_NB_PAGES / NB_ROTATIONS)			///< Number of pages of the graph of each axis
+#define GRAPH_HALF_HEIGHT	((GRAPH_NB_PAGES * 8U) / 2U)			///< Number of rows between the zero line and the top of a graph
+#define GRAPH_RANGE_TENTHS	300		///< Angle plotted at the top of a graph (in tenths of degrees)
+#if defined(SSD1306_CIRCULAR_DMA)
+#define RUNNING_STATE		stStreaming	///< State in which the screen runs once configured
+#else
+#define RUNNING_STATE		stIdle		///< State in which the screen runs once configured
+#endif
 
 //static assertions (ran at compile time)
-_Static_assert((ANGLE_NB_CHARS * VERDANA_NB_BYTES_CHAR) <= MAX_DATA_SIZE, "SSD1306 font chosen uses too much space.");
-_Static_assert((ANGLE_NB_CHARS * VERDANA_CHAR_WIDTH) <= (SSD_LAST_COLUMN + 1), "SSD1306 font chosen has too many columns.");
+_Static_assert((ANGLE_NB_CHARS * VERDANA_NB_BYTES) <= MAX_DATA_SIZE, "SSD1306 font chosen uses too much space.");
+_Static_assert((ANGLE_NB_CHARS * VERDANA_WIDTH) <= (SSD_LAST_COLUMN + 1), "SSD1306 font chosen has too many columns.");
+_Static_assert((DRAW_QUEUE_SIZE & (DRAW_QUEUE_SIZE - 1U)) == 0, "DRAW_QUEUE_SIZE must be a power of two.");
+_Static_assert(GRAPH_NB_COLUMNS == SSD1306_GRAPH_NB_COLUMNS, "SSD1306_GRAPH_NB_COLUMNS does not match the graphs layout.");
+_Static_assert(BASESCREEN_NB_BYTES == MAX_DATA_SIZE, "SSD1306 base screen does not cover the whole screen.");
 
 /**
  * @brief Enumeration of the function IDs of the SSD1306
@@ -31,11 +82,79 @@ _Static_assert((ANGLE_NB_CHARS * VERDANA_CHAR_WIDTH) <= (SSD_LAST_COLUMN + 1), "
 typedef enum _SSD1306functionCodes_e{
     INIT = 0,		///< SSD1306initialise()
     SEND_CMD,		///< SSD1306sendCommand()
-    PRT_ANGLE,		///< SSD1306_printAngleTenths()
+    PRT_ANGLE,		///< SSD1306_printMeasureTenths()
     SENDING_DATA,	///< stSendingData()
-    WAITING_DMA_RDY	///< stWaitingForTXdone()
+    WAITING_DMA_RDY,	///< stWaitingForTXdone()
+    WAITING_ADDR_RDY,	///< stWaitingForAddressing()
+    SUSPEND,		///< SSD1306suspend()
+    RESUME,			///< SSD1306resume()
+    PRT_REFERENTIAL,	///< SSD1306_printReferentialIcon()
+    PRT_HOLD,		///< SSD1306_printHoldIcon()
+    BASE_SCREEN,	///< SSD1306drawBaseScreen()
+    QUEUE_DRAWING,	///< queueDrawing()
+    START_STREAMING,	///< startStreaming()
+    STREAMING,		///< stStreaming()
+    GRAPH_SCREEN,	///< SSD1306drawGraphScreen()
+    PRT_BUBBLE,		///< SSD1306_printBubble()
+    PRT_GRAPH,		///< SSD1306_printGraphColumn()
+    RESETTING,		///< stResetting()
+    SENDING_INIT,	///< stSendingInit()
+    SENDING_BASE,	///< stSendingBaseScreen()
+    PRT_STABILITY,	///< SSD1306_printStabilityIcon()
+    PRT_GRAPH_STATS,	///< SSD1306_printGraphStats()
+    RESUMING		///< stResuming()
 }_SSD1306functionCodes_e;
 
+/**
+ * @brief Structure defining the span of columns modified in a page since it has been flushed
+ */
+typedef struct{
+    uint8_t	first;	///< First column modified (SSD_NB_COLUMNS if page clean)
+    uint8_t	last;	///< Last column modified
+}dirtySpan_t;
+
+/**
+ * @brief Structure defining the rectangle of the framebuffer being flushed to the screen
+ */
+typedef struct{
+    uint8_t	columns[2];	///< First and last columns of the region (COLUMN_ADDRESS parameters)
+    uint8_t	pages[2];	///< First and last pages of the region (PAGE_ADDRESS parameters)
+    uint8_t	nextPage;	///< Next page of the region to transmit via DMA
+}flushRegion_t;
+
+/**
+ * @brief Enumeration of the drawings which can be queued
+ */
+typedef enum{
+    DRAW_BASE_SCREEN = 0,	///< Wipe the screen and draw the separator and icons
+    DRAW_ANGLE,				///< Draw an angle (values[0] : angle in tenths of the unit, parameter : rotation axis, unit : unit of the value)
+    DRAW_REFERENTIAL,		///< Draw the referential icon (parameter : referential type)
+    DRAW_HOLD,				///< Draw or erase the hold icon (parameter : status)
+    DRAW_STABILITY,			///< Draw the stability icon (parameter : 1 if settled, 0 if settling)
+    DRAW_GRAPH_SCREEN,		///< Wipe the screen and draw the bubble level rings and the graphs zero lines
+    DRAW_BUBBLE,			///< Move the bubble (values : column and row of its centre)
+    DRAW_GRAPH_COLUMN,		///< Plot the next column of a graph (values : lowest and highest angles in tenths of degrees, parameter : rotation axis)
+    DRAW_GRAPH_STATS		///< Draw the statistics next to a graph (values : lowest and highest angles in tenths of degrees, parameter : rotation axis)
+}drawType_e;
+
+/**
+ * @brief Enumeration of the screen pages
+ */
+typedef enum{
+    PAGE_ANGLES = 0,	///< Angles printed with digits, with the referential and hold icons
+    PAGE_GRAPHS			///< Bubble level and angles graphs
+}screenPage_e;
+
+/**
+ * @brief Structure defining a drawing waiting to be rendered in the framebuffer
+ */
+typedef struct{
+    drawType_e	type;		///< Type of drawing
+    uint8_t		parameter;	///< Parameter of the drawing (see drawType_e)
+    int16_t		values[2];	///< Values to draw (see drawType_e)
+    measureUnit_e	unit;	///< Unit of the value to draw (see drawType_e)
+}drawCommand_t;
+
 /**
  * @brief SPI Data/command pin status enumeration
  */
@@ -52,26 +171,90 @@ typedef enum{
 typedef errorCode_u (*screenState)();
 
 //communication functions with the SSD1306
-static inline void setDataCommandGPIO(DCgpio_e function);
 static errorCode_u sendCommand(SSD1306register_e regNumber, const uint8_t parameters[], uint8_t nbParameters);
+static errorCode_u startTransfer(const uint8_t buffer[], uint16_t size, DCgpio_e function);
+#if defined(SSD1306_CIRCULAR_DMA)
+static errorCode_u startStreaming();
+#else
+static errorCode_u startRegionTransfer();
+#endif
+
+//framebuffer functions
+static void drawBitmap(uint8_t column, uint8_t page, uint8_t width, uint8_t nbPages, const uint8_t bitmap[]);
+static void fillArea(uint8_t column, uint8_t page, uint8_t width, uint8_t nbPages, uint8_t value);
+static void renderBaseScreen();
+static void forgetRenderedGlyphs();
+static void renderAngle(int16_t valueTenths, rotationAxis_e rotationAxis, measureUnit_e unit);
+static void formatTenths(int16_t valueTenths, uint8_t glyphs[NUMBER_NB_CHARS]);
+static void renderDrawQueue();
+static void renderGraphScreen();
+static void renderBubble(uint8_t column, uint8_t row);
+static void renderGraphColumn(rotationAxis_e axis, int16_t minTenths, int16_t maxTenths);
+static void renderGraphStats(rotationAxis_e axis, int16_t minTenths, int16_t maxTenths);
+static uint8_t isBubbleBackground(int16_t x, int16_t y);
+static uint8_t graphRow(rotationAxis_e axis, int16_t angleTenths);
+static inline void setPixel(uint8_t column, uint8_t row, uint8_t lit);
+static errorCode_u queueDrawing(drawCommand_t command);
+static void startFrame();
+static void updateFrameRate();
+static inline void markDirty(uint8_t page, uint8_t firstColumn, uint8_t lastColumn);
+static inline void markClean(uint8_t page);
+static inline uint8_t isPageDirty(uint8_t page);
+#if !defined(SSD1306_CIRCULAR_DMA)
+static uint8_t isFrameDirty();
+static uint8_t nextFlushRegion(flushRegion_t* region);
+#endif
 
 //state machine
-static errorCode_u stIdle();
 static errorCode_u stConfiguring();
+static errorCode_u stResetting();
+static errorCode_u stSendingInit();
+static errorCode_u stSendingBaseScreen();
+#if defined(SSD1306_CIRCULAR_DMA)
+static errorCode_u stStreaming();
+#else
+static errorCode_u stIdle();
 static errorCode_u stSendingData();
+static errorCode_u stWaitingForAddressing();
 static errorCode_u stWaitingForTXdone();
+#endif
+static errorCode_u stSuspended();
+static errorCode_u stResuming();
 
 //state variables
-volatile uint16_t			screenTimer_ms = 0;				///< Timer used with screen SPI transmissions (in ms)
-volatile uint16_t			ssd1306SPITimer_ms = 0;			///< Timer used to make sure SPI does not time out (in ms)
-static SPI_TypeDef*			_spiHandle = (void*)0;			///< SPI handle used with the SSD1306
-static DMA_TypeDef*			_dmaHandle = (void*)0;			///< DMA handle used with the SSD1306
-static uint32_t				_dmaChannel = 0x00000000U;		///< DMA channel used
+static softTimer_t			_timer;							///< Timer used during the reset sequence
+static softTimer_t			_frameTimer;					///< Timer used to wait for the next frame
+static spiBus_e				_bus = NB_SPI_BUSES;			///< SPI bus used with the SSD1306
+static spiTransaction_t		_transaction;					///< SPI transaction used for the transfers sent in the background
 static screenState			_state = stConfiguring;			///< State machine current state
-static uint8_t				_screenBuffer[MAX_DATA_SIZE];	///< Buffer used to send data to the screen
-static uint8_t 				_limitColumns[2];				///< Buffer used to set the first and last column to send
-static uint8_t				_limitPages[2];					///< Buffer used to set the first and last page to send
-static uint16_t				_size;							///< Number of bytes to send
+static uint8_t				_frameBuffer[MAX_DATA_SIZE];	///< Shadow of the screen RAM (page by page, then column by column)
+static dirtySpan_t			_dirtySpans[SSD_NB_PAGES];		///< Columns modified in each page since flushed
+#if defined(SSD1306_CIRCULAR_DMA)
+static spiTransaction_t		_addressingTransaction;			///< SPI transaction addressing the whole screen, queued before the stream
+#else
+static flushRegion_t		_region;						///< Region currently being flushed
+static uint8_t				_addressing[ADDRESSING_NB_BYTES];	///< Addressing commands of the region being flushed (sent via DMA)
+#endif
+static drawCommand_t		_drawQueue[DRAW_QUEUE_SIZE];	///< Circular buffer of the drawings waiting to be rendered
+static uint8_t				_drawQueueHead = 0;				///< Index of the oldest drawing queued
+static uint8_t				_drawQueueCount = 0;			///< Number of drawings queued
+static int16_t				_displayedAngles[NB_ROTATIONS];	///< Angles currently displayed (in tenths of their unit)
+static measureUnit_e		_displayedUnits[NB_ROTATIONS];	///< Units of the angles currently displayed
+static uint8_t				_displayedGlyphs[NB_ROTATIONS][ANGLE_NB_CHARS];	///< Glyphs currently rendered for each angle
+static screenPage_e			_page = PAGE_ANGLES;			///< Page currently rendered
+static uint8_t				_displayedBubble[2] = {BUBBLE_UNKNOWN, BUBBLE_UNKNOWN};	///< Position of the latest bubble queued (column and row)
+static uint8_t				_renderedBubble[2] = {BUBBLE_UNKNOWN, BUBBLE_UNKNOWN};	///< Position of the bubble currently rendered (column and row)
+static uint8_t				_graphCursors[NB_ROTATIONS];	///< Next column plotted in the graph of each axis
+static uint8_t				_angleHysteresis = ANGLE_HYSTERESIS;	///< Amount of tenths of degrees an angle must exceed before being redrawn
+static uint16_t				_framePeriod_ms = 0;			///< Number of milliseconds between the start of two frames
+static ssd1306FrameStats_t	_frameStats;					///< Frame scheduler statistics
+static uint32_t				_lastFrame_ms = 0;				///< System tick at which the latest frame started
+static uint32_t				_pendingSince_ms = 0;			///< System tick at which the oldest drawing not rendered yet has been queued
+static uint32_t				_fpsWindowStart_ms = 0;			///< System tick at which the current frame rate measurement window started
+static uint16_t				_fpsWindowFrames = 0;			///< Number of frames started in the current frame rate measurement window
+#if defined(PROFILING)
+static uint32_t				_fpsWindowCycles = 0;			///< Number of CPU cycles spent in SSD1306update() during the current measurement window
+#endif
 
 
 /********************************************************************************************************************************************/
@@ -81,207 +264,598 @@ static uint16_t				_size;							///< Number of bytes to send
 /**
  * @brief Initialise the SSD1306
  *
- * @param handle SPI handle used
+ * @param bus SPI bus used (transmission only)
  * @return Success
- * @retval 1	Error while initialising the registers
- * @retval 2	Error while clearing the screen
  */
-errorCode_u SSD1306initialise(SPI_TypeDef* handle, DMA_TypeDef* dma, uint32_t dmaChannel){
-    _spiHandle = handle;
-    _dmaHandle = dma;
-    _dmaChannel = dmaChannel;
-
-    //make sure to disable SSD1306 SPI communication
-    LL_SPI_Disable(_spiHandle);
-    LL_DMA_DisableChannel(_dmaHandle, _dmaChannel);
+errorCode_u SSD1306initialise(spiBus_e bus){
+    _bus = bus;
+    _transaction = (spiTransaction_t){0};
+#if defined(SSD1306_CIRCULAR_DMA)
+    _addressingTransaction = (spiTransaction_t){0};
+#endif
+
+    //the screen starts with the base screen, whatever has been rendered before
+    for(uint8_t i = 0 ; i < NB_ROTATIONS ; i++){
+        _displayedAngles[i] = ANGLE_UNKNOWN;
+        _displayedUnits[i] = UNIT_UNKNOWN;
+    }
+    _displayedBubble[0] = _displayedBubble[1] = BUBBLE_UNKNOWN;
+    _renderedBubble[0] = _renderedBubble[1] = BUBBLE_UNKNOWN;
+    _drawQueueCount = 0;
+    _page = PAGE_ANGLES;
 
-    //set the DMA source and destination addresses (will always use the same ones)
-    LL_DMA_ConfigAddresses(_dmaHandle, _dmaChannel, (uint32_t)&_screenBuffer, LL_SPI_DMA_GetRegAddr(_spiHandle), LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+    SSD1306setFrameRate(FRAME_RATE_FPS, FRAME_MIN_INTERVAL_MS);
+    for(uint8_t page = 0 ; page < SSD_NB_PAGES ; page++)
+        markClean(page);
 
     return (ERR_SUCCESS);
 }
 
 /**
- * brief Set the Data/Command pin
+ * @brief Set the hysteresis applied to the angles to print
+ * @details An angle is only redrawn when it deviates from the one displayed by more than the hysteresis.
+ *          This avoids redrawing the screen each time a measurement jitters.
  *
- * @param function Value of the data/command pin
+ * @param hysteresisTenths Hysteresis in tenths of the unit printed (0 to redraw each time the printed digits differ)
  */
-static inline void setDataCommandGPIO(DCgpio_e function){
-    if(function == COMMAND)
-        LL_GPIO_ResetOutputPin(SSD1306_DC_GPIO_Port, SSD1306_DC_Pin);
-    else
-        LL_GPIO_SetOutputPin(SSD1306_DC_GPIO_Port, SSD1306_DC_Pin);
+void SSD1306setAngleHysteresis(uint8_t hysteresisTenths){
+    _angleHysteresis = hysteresisTenths;
 }
 
 /**
- * @brief Send a command with parameters
+ * @brief Set the rate at which the frames are flushed to the screen
+ * @details The drawings queued in between two frames are coalesced, so that only the newest values are drawn.
+ *          The period used is the longest between the target frame rate and the minimum interval,
+ *          which bounds the SPI bandwidth used whatever the rate at which angles are printed.
+ *
+ * @param framesPerSecond	Target number of frames per second (0 to only use the minimum interval)
+ * @param minInterval_ms	Minimum number of milliseconds between the start of two frames
+ */
+void SSD1306setFrameRate(uint8_t framesPerSecond, uint16_t minInterval_ms){
+    uint16_t period = (framesPerSecond ? (uint16_t)(1000U / framesPerSecond) : 0U);
+
+    _framePeriod_ms = (period > minInterval_ms ? period : minInterval_ms);
+}
+
+/**
+ * @brief Get the frame scheduler statistics
+ *
+ * @return Statistics since start-up
+ */
+const ssd1306FrameStats_t* SSD1306getFrameStats(){
+    return (&_frameStats);
+}
+
+/**
+ * @brief Send a command with parameters, and wait for the end of the transaction
+ * @note Blocking : only used by SSD1306suspend(), which must be done before entering Stop mode.
+ *       All the other commands are sent in the background.
  *
  * @param regNumber Register number
  * @param parameters Parameters to write
  * @param nbParameters Number of parameters to write
  * @return Success
  * @retval 1	Number of parameters above maximum
- * @retval 2	Timeout while sending the command
+ * @retval 2	Error while sending the command
  */
 errorCode_u sendCommand(SSD1306register_e regNumber, const uint8_t parameters[], uint8_t nbParameters){
-    static const uint8_t MAX_PARAMETERS = 6U;		///< Maximum number of parameters a command can have
-    errorCode_u result = ERR_SUCCESS;
+    uint8_t frame[CMD_MAX_PARAMETERS + 1U];
+    errorCode_u result;
 
     //assertions
-    assert(_spiHandle);						//handle is not null
     assert(parameters || !nbParameters);	//either 0 parameters, or parameters array not null
 
     //if too many parameters, error
-    if(nbParameters > MAX_PARAMETERS)
+    if(nbParameters > CMD_MAX_PARAMETERS)
         return(createErrorCode(SEND_CMD, 1, ERR_WARNING));
 
-    //set command pin and enable SPI
-    ssd1306SPITimer_ms = SPI_TIMEOUT_MS;
-    setDataCommandGPIO(COMMAND);
-    LL_SPI_Enable(_spiHandle);
+    //send the command byte followed by its parameters, with the command pin set
+    frame[0] = regNumber;
+    for(uint8_t i = 0 ; i < nbParameters ; i++)
+        frame[i + 1U] = parameters[i];
 
-    //send the command byte
-    LL_SPI_TransmitData8(_spiHandle, regNumber);
+    spiTransaction_t transaction = {
+        .tx = frame,
+        .length = (uint16_t)(nbParameters + 1U),
+        .dataCommand = {SSD1306_DC_GPIO_Port, SSD1306_DC_Pin},
+        .dataCommandLevel = COMMAND,
+    };
+
+    result = spiBusTransfer(_bus, &transaction);
+    if(isError(result))
+        return (pushErrorCode(result, SEND_CMD, 2));
 
-    //send the parameters
-    uint8_t* iterator = (uint8_t*)parameters;
-    while(nbParameters && ssd1306SPITimer_ms){
-        //wait for the previous byte to be done, then send the next one
-        while(!LL_SPI_IsActiveFlag_TXE(_spiHandle) && ssd1306SPITimer_ms);
-        if(ssd1306SPITimer_ms)
-            LL_SPI_TransmitData8(_spiHandle, *iterator);
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Wipe the screen blank and draw the separator and icons
+ *
+ * @return Success
+ * @retval 1	Drawing queue full
+ */
+errorCode_u SSD1306drawBaseScreen(){
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_BASE_SCREEN});
+    if(isError(result))
+        return (pushErrorCode(result, BASE_SCREEN, 1));
 
-        iterator++;
-        nbParameters--;
+    //no angle is displayed anymore
+    for(uint8_t i = 0 ; i < NB_ROTATIONS ; i++){
+        _displayedAngles[i] = ANGLE_UNKNOWN;
+        _displayedUnits[i] = UNIT_UNKNOWN;
     }
 
-    //wait for transaction to be finished and clear Overrun flag
-    while(LL_SPI_IsActiveFlag_BSY(_spiHandle) && ssd1306SPITimer_ms);
-    LL_SPI_ClearFlag_OVR(_spiHandle);
+    return (ERR_SUCCESS);
+}
 
-    //disable SPI and return status
-    LL_SPI_Disable(_spiHandle);
+/**
+ * @brief Render the base screen (blank, with the separator and icons) in the framebuffer
+ */
+static void renderBaseScreen(){
+    drawBitmap(0, 0, SSD_NB_COLUMNS, SSD_NB_PAGES, baseScreen);
+    forgetRenderedGlyphs();
+}
 
-    //if timeout, error
-    if(!ssd1306SPITimer_ms)
-        return (createErrorCode(SEND_CMD, 2, ERR_WARNING));
+/**
+ * @brief Set the angles page as current, without any glyph rendered
+ */
+static void forgetRenderedGlyphs(){
+    for(uint8_t axis = 0 ; axis < NB_ROTATIONS ; axis++){
+        for(uint8_t character = 0 ; character < ANGLE_NB_CHARS ; character++)
+            _displayedGlyphs[axis][character] = GLYPH_UNKNOWN;
+    }
 
-    return (result);
+    _page = PAGE_ANGLES;
 }
 
 /**
- * @brief Wipe the screen blank and draw the separator and icons
+ * @brief Wipe the screen and draw the bubble level and the graphs pages
  *
  * @return Success
+ * @retval 1	Drawing queue full
  */
-errorCode_u SSD1306drawBaseScreen(){
-    uint8_t* iterator = _screenBuffer;
-    uint16_t i;
-
-    //define the whole screen as the drawing window
-    _limitColumns[0] = 0;
-    _limitColumns[1] = SSD_LAST_COLUMN;
-    _limitPages[0] = 0;
-    _limitPages[1] = SSD_LAST_PAGE;
-    _size = MAX_DATA_SIZE;
-
-    //fill the screen buffer with blank pixels value
-    for(i = 0 ; i < MAX_DATA_SIZE ; i++)
-        *(iterator++) = 0x00U;
-
-    //draw the middle screen separator in the buffer (avoid drawing in the arrows icon zone)
-    static const uint8_t LIGN = 0x03U;
-    iterator = &_screenBuffer[(MAX_DATA_SIZE >> 1) + ARROWSICON_WIDTH];
-    for(i = ARROWSICON_WIDTH ; i <= SSD_LAST_COLUMN ; i++)
-        *(iterator++) = LIGN;
-
-    //draw the arrows icon
-    for(i = 0 ; i < ARROWSICON_NB_BYTES ; i++){
-        //copy a byte, while making sure to copy it at the proper page number
-        uint16_t bufferOffset = (i / ARROWSICON_WIDTH) * (SSD_LAST_COLUMN + 1);
-        _screenBuffer[bufferOffset + (i % ARROWSICON_WIDTH)] = arrowsIcon_32px[i];
-    }
-
-    //draw the absolute referential icon
-    iterator = &_screenBuffer[MAX_DATA_SIZE - REFERENCETYPE_NB_BYTES];
-    for(i = 0 ; i < REFERENCETYPE_NB_BYTES ; i++)
-        *(iterator++) = absoluteReferentialIcon[i];
-
-    _state = stSendingData;
+errorCode_u SSD1306drawGraphScreen(){
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_GRAPH_SCREEN});
+    if(isError(result))
+        return (pushErrorCode(result, GRAPH_SCREEN, 1));
+
+    //no bubble is displayed anymore
+    _displayedBubble[0] = _displayedBubble[1] = BUBBLE_UNKNOWN;
     return (ERR_SUCCESS);
 }
 
 /**
- * @brief Check if the screen is ready to accept new commands
+ * @brief Render the graphs page (bubble level rings, divider and graphs zero lines) in the framebuffer
+ */
+static void renderGraphScreen(){
+    static const uint8_t DOTTED_LINE = 0x55U;	///< Byte drawing a dotted vertical line
+
+    //wipe the whole screen, then draw the divider between the bubble level and the graphs
+    fillArea(0, 0, SSD_NB_COLUMNS, SSD_NB_PAGES, 0x00U);
+    fillArea(GRAPH_DIVIDER_COLUMN, 0, 1, SSD_NB_PAGES, DOTTED_LINE);
+
+    //draw the bubble level rings and crosshair
+    for(uint8_t column = 0 ; column < GRAPH_DIVIDER_COLUMN ; column++){
+        for(uint8_t row = 0 ; row < (SSD_NB_PAGES * 8U) ; row++){
+            if(isBubbleBackground((int16_t)(column - BUBBLE_CENTER), (int16_t)(row - BUBBLE_CENTER)))
+                setPixel(column, row, 1);
+        }
+    }
+
+    //draw the dotted zero line of each graph
+    for(uint8_t axis = 0 ; axis < NB_ROTATIONS ; axis++){
+        for(uint8_t column = 0 ; column < GRAPH_NB_COLUMNS ; column += 2U)
+            setPixel((uint8_t)(GRAPH_FIRST_COLUMN + column), graphRow(axis, 0), 1);
+
+        _graphCursors[axis] = 0;
+    }
+
+    _renderedBubble[0] = _renderedBubble[1] = BUBBLE_UNKNOWN;
+    _page = PAGE_GRAPHS;
+}
+
+/**
+ * @brief Print the bubble level according to the roll and pitch angles
+ * @note  Angles moving the bubble by less than a pixel are ignored (no screen traffic)
+ *
+ * @param rollTenths	Roll angle (in tenths of degrees)
+ * @param pitchTenths	Pitch angle (in tenths of degrees)
+ * @return Success
+ * @retval 1	Drawing queue full
+ */
+errorCode_u SSD1306_printBubble(int16_t rollTenths, int16_t pitchTenths){
+    int16_t offsets[NB_ROTATIONS] = {rollTenths, pitchTenths};
+    int16_t squaredTravel = (int16_t)(BUBBLE_TRAVEL * BUBBLE_TRAVEL);
+
+    //transpose the angles to pixel offsets from the centre (the bubble rises towards the highest side)
+    for(uint8_t axis = 0 ; axis < NB_ROTATIONS ; axis++){
+        if(offsets[axis] > BUBBLE_RANGE_TENTHS)
+            offsets[axis] = BUBBLE_RANGE_TENTHS;
+        if(offsets[axis] < -BUBBLE_RANGE_TENTHS)
+            offsets[axis] = -BUBBLE_RANGE_TENTHS;
+
+        offsets[axis] = (int16_t)((offsets[axis] * (int16_t)BUBBLE_TRAVEL) / BUBBLE_RANGE_TENTHS);
+    }
+
+    //keep the bubble within the outer ring by shortening its largest offset
+    while(((offsets[ROLL] * offsets[ROLL]) + (offsets[PITCH] * offsets[PITCH])) > squaredTravel){
+        uint8_t axis = ((offsets[ROLL] < 0 ? -offsets[ROLL] : offsets[ROLL]) > (offsets[PITCH] < 0 ? -offsets[PITCH] : offsets[PITCH])) ? ROLL : PITCH;
+        offsets[axis] = (int16_t)(offsets[axis] + (offsets[axis] < 0 ? 1 : -1));
+    }
+
+    //if the bubble would not move, exit
+    uint8_t column = (uint8_t)((int16_t)BUBBLE_CENTER + offsets[ROLL]);
+    uint8_t row = (uint8_t)((int16_t)BUBBLE_CENTER - offsets[PITCH]);
+    if((column == _displayedBubble[0]) && (row == _displayedBubble[1]))
+        return (ERR_SUCCESS);
+
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_BUBBLE, .values = {column, row}});
+    if(isError(result))
+        return (pushErrorCode(result, PRT_BUBBLE, 1));
+
+    _displayedBubble[0] = column;
+    _displayedBubble[1] = row;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Render the bubble in the framebuffer, after having restored the background where it previously was
+ *
+ * @param column	Column of the bubble centre
+ * @param row		Row of the bubble centre
+ */
+static void renderBubble(uint8_t column, uint8_t row){
+    static const int16_t SQUARED_RADIUS = (BUBBLE_RADIUS * BUBBLE_RADIUS) + BUBBLE_RADIUS;	///< Squared radius of the bubble (rounded up half a pixel)
+    static const int16_t RADIUS = BUBBLE_RADIUS;
+
+    //restore the background where the previous bubble was
+    if(_renderedBubble[0] != BUBBLE_UNKNOWN){
+        for(int16_t x = -RADIUS ; x <= RADIUS ; x++){
+            for(int16_t y = -RADIUS ; y <= RADIUS ; y++){
+                int16_t backgroundX = (int16_t)(_renderedBubble[0] + x - (int16_t)BUBBLE_CENTER);
+                int16_t backgroundY = (int16_t)(_renderedBubble[1] + y - (int16_t)BUBBLE_CENTER);
+                setPixel((uint8_t)(_renderedBubble[0] + x), (uint8_t)(_renderedBubble[1] + y), isBubbleBackground(backgroundX, backgroundY));
+            }
+        }
+    }
+
+    //draw the new bubble
+    for(int16_t x = -RADIUS ; x <= RADIUS ; x++){
+        for(int16_t y = -RADIUS ; y <= RADIUS ; y++){
+            if(((x * x) + (y * y)) <= SQUARED_RADIUS)
+                setPixel((uint8_t)(column + x), (uint8_t)(row + y), 1);
+        }
+    }
+
+    _renderedBubble[0] = column;
+    _renderedBubble[1] = row;
+}
+
+/**
+ * @brief Check if a pixel belongs to the bubble level background (outer ring, target ring and crosshair)
+ *
+ * @param x	Column of the pixel, relative to the bubble level centre
+ * @param y	Row of the pixel, relative to the bubble level centre
+ * @retval 0 Pixel blank
+ * @retval 1 Pixel lit
+ */
+static uint8_t isBubbleBackground(int16_t x, int16_t y){
+    static const int16_t OUTER = BUBBLE_RING_RADIUS;
+    static const int16_t TARGET = BUBBLE_TARGET_RADIUS;
+    int16_t squaredDistance = (int16_t)((x * x) + (y * y));
+
+    //rings : pixels within half a pixel of the radius ((r - 0.5)^2 < d^2 <= (r + 0.5)^2, rounded)
+    if((squaredDistance > ((OUTER * OUTER) - OUTER)) && (squaredDistance <= ((OUTER * OUTER) + OUTER)))
+        return (1);
+    if((squaredDistance > ((TARGET * TARGET) - TARGET)) && (squaredDistance <= ((TARGET * TARGET) + TARGET)))
+        return (1);
+
+    //crosshair : dotted axes between both rings
+    if((squaredDistance > (TARGET * TARGET)) && (squaredDistance < (OUTER * OUTER)))
+        return (((x == 0) && !(y & 1)) || ((y == 0) && !(x & 1)));
+
+    return (0);
+}
+
+/**
+ * @brief Plot the envelope of the angles measured during a graph column period
+ * @note  The graphs sweep from left to right, and wrap around once at the last column
+ *
+ * @param axis		Rotation axis of the graph
+ * @param minTenths	Lowest angle measured during the period (in tenths of degrees)
+ * @param maxTenths	Highest angle measured during the period (in tenths of degrees)
+ * @return Success
+ * @retval 1	Drawing queue full
+ */
+errorCode_u SSD1306_printGraphColumn(rotationAxis_e axis, int16_t minTenths, int16_t maxTenths){
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_GRAPH_COLUMN, .parameter = (uint8_t)axis, .values = {minTenths, maxTenths}});
+    if(isError(result))
+        return (pushErrorCode(result, PRT_GRAPH, 1));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Render the next column of a graph in the framebuffer, and blank the one after it to show where the sweep is
+ * @details Only these two columns are modified (at most 2 * GRAPH_NB_PAGES bytes flushed)
+ *
+ * @param axis		Rotation axis of the graph
+ * @param minTenths	Lowest angle to plot (in tenths of degrees)
+ * @param maxTenths	Highest angle to plot (in tenths of degrees)
+ */
+static void renderGraphColumn(rotationAxis_e axis, int16_t minTenths, int16_t maxTenths){
+    uint8_t firstPage = (uint8_t)(axis * GRAPH_NB_PAGES);
+    uint8_t column = (uint8_t)(GRAPH_FIRST_COLUMN + _graphCursors[axis]);
+
+    //plot the envelope (rows go downwards, so the highest angle has the lowest row)
+    fillArea(column, firstPage, 1, GRAPH_NB_PAGES, 0x00U);
+    if(!(_graphCursors[axis] & 1U))
+        setPixel(column, graphRow(axis, 0), 1);
+    for(uint8_t row = graphRow(axis, maxTenths) ; row <= graphRow(axis, minTenths) ; row++)
+        setPixel(column, row, 1);
+
+    //move to the next column and blank it
+    _graphCursors[axis] = (uint8_t)((_graphCursors[axis] + 1U) % GRAPH_NB_COLUMNS);
+    fillArea((uint8_t)(GRAPH_FIRST_COLUMN + _graphCursors[axis]), firstPage, 1, GRAPH_NB_PAGES, 0x00U);
+}
+
+/**
+ * @brief Print the statistics of an axis next to its graph
+ * @details The range of the angles measured since the latest reset is drawn as a bar left of the graph,
+ *          and the peak (the end of the range the furthest from 0) is marked left of the divider
+ *
+ * @param axis		Rotation axis of the graph
+ * @param minTenths	Lowest angle measured since the latest reset (in tenths of degrees, above maxTenths if none)
+ * @param maxTenths	Highest angle measured since the latest reset (in tenths of degrees)
+ * @return Success
+ * @retval 1	Drawing queue full
+ */
+errorCode_u SSD1306_printGraphStats(rotationAxis_e axis, int16_t minTenths, int16_t maxTenths){
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_GRAPH_STATS, .parameter = (uint8_t)axis, .values = {minTenths, maxTenths}});
+    if(isError(result))
+        return (pushErrorCode(result, PRT_GRAPH_STATS, 1));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Render the statistics of an axis in the framebuffer
+ *
+ * @param axis		Rotation axis of the graph
+ * @param minTenths	Lowest angle measured (in tenths of degrees, above maxTenths if none)
+ * @param maxTenths	Highest angle measured (in tenths of degrees)
+ */
+static void renderGraphStats(rotationAxis_e axis, int16_t minTenths, int16_t maxTenths){
+    uint8_t firstPage = (uint8_t)(axis * GRAPH_NB_PAGES);
+
+    fillArea((uint8_t)GRAPH_RANGE_COLUMN, firstPage, 1, GRAPH_NB_PAGES, 0x00U);
+    fillArea((uint8_t)GRAPH_PEAK_COLUMN, firstPage, 1, GRAPH_NB_PAGES, 0x00U);
+    if(minTenths > maxTenths)
+        return;
+
+    for(uint8_t row = graphRow(axis, maxTenths) ; row <= graphRow(axis, minTenths) ; row++)
+        setPixel((uint8_t)GRAPH_RANGE_COLUMN, row, 1);
+
+    int32_t highest = (maxTenths < 0 ? -(int32_t)maxTenths : maxTenths);
+    int32_t lowest = (minTenths < 0 ? -(int32_t)minTenths : minTenths);
+    setPixel((uint8_t)GRAPH_PEAK_COLUMN, graphRow(axis, (highest >= lowest ? maxTenths : minTenths)), 1);
+}
+
+/**
+ * @brief Get the row at which an angle is plotted in the graph of an axis
+ *
+ * @param axis			Rotation axis of the graph
+ * @param angleTenths	Angle to plot (in tenths of degrees, clamped to the graph range)
+ * @return Row of the angle
+ */
+static uint8_t graphRow(rotationAxis_e axis, int16_t angleTenths){
+    static const int16_t HALF_HEIGHT = GRAPH_HALF_HEIGHT;
+    int16_t offset = (int16_t)((angleTenths * HALF_HEIGHT) / GRAPH_RANGE_TENTHS);
+
+    if(offset >= HALF_HEIGHT)
+        offset = HALF_HEIGHT - 1;
+    if(offset < -(HALF_HEIGHT - 1))
+        offset = -(HALF_HEIGHT - 1);
+
+    return ((uint8_t)((int16_t)(axis * GRAPH_NB_PAGES * 8U) + HALF_HEIGHT - offset));
+}
+
+/**
+ * @brief Check if the screen is idle, with all the drawings flushed
  *
  * @return 0 Not ready
  * @retval 1 Ready
  */
 uint8_t isScreenReady(){
-    return (_state == stIdle);
+#if defined(SSD1306_CIRCULAR_DMA)
+    return ((_state == stStreaming) && !_drawQueueCount);
+#else
+    return ((_state == stIdle) && !_drawQueueCount && !isFrameDirty());
+#endif
+}
+
+/**
+ * @brief Switch the panel and its charge pump off (screen RAM is retained)
+ * @note p. 62 of the datasheet (power OFF sequence)
+ *
+ * @return Success
+ * @retval 1	Screen busy
+ * @retval 2	Error while switching the display off
+ * @retval 3	Error while disabling the charge pump
+ */
+errorCode_u SSD1306suspend(){
+    static const uint8_t CHG_PUMP_OFF = SSD_DISABLE_CHG_PUMP;
+    errorCode_u result;
+
+    //if a transmission is in progress, exit
+    if(_state != RUNNING_STATE)
+        return (createErrorCode(SUSPEND, 1, ERR_WARNING));
+
+#if defined(SSD1306_CIRCULAR_DMA)
+    //stop the stream once the byte being shifted out is done
+    spiBusAbort(_bus);
+#endif
+
+    result = sendCommand(DISPLAY_OFF, (void*)0, 0);
+    if(isError(result))
+        return (pushErrorCode(result, SUSPEND, 2));
+
+    result = sendCommand(CHG_PUMP_REGULATOR, &CHG_PUMP_OFF, 1);
+    if(isError(result))
+        return (pushErrorCode(result, SUSPEND, 3));
+
+    _state = stSuspended;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Switch the charge pump and the panel back on, with the content displayed before suspending
+ * @details The commands are sent in the background, the screen runs again once they are sent (see stResuming())
+ *
+ * @return Success
+ * @retval 1	Screen not suspended
+ * @retval 2	Error while starting the transfer
+ */
+errorCode_u SSD1306resume(){
+    static const uint8_t WAKE_UP_COMMANDS[] = {
+        CHG_PUMP_REGULATOR,	SSD_ENABLE_CHG_PUMP,
+        DISPLAY_ON,
+    };
+    errorCode_u result;
+
+    //if not suspended, exit
+    if(_state != stSuspended)
+        return (createErrorCode(RESUME, 1, ERR_WARNING));
+
+    result = startTransfer(WAKE_UP_COMMANDS, sizeof(WAKE_UP_COMMANDS), COMMAND);
+    if(isError(result))
+        return (pushErrorCode(result, RESUME, 2));
+
+    _state = stResuming;
+    return (ERR_SUCCESS);
 }
 
 /**
- * @brief Print an angle (in degrees, with sign) on the screen
+ * @brief Print an angle (with sign, in degrees, percent or topo) on the screen
+ *
+ * @note  Angles within the hysteresis of the one displayed in the same unit are ignored (no screen traffic)
+ * @note  The drawing is queued, then rendered and sent by SSD1306update()
  *
- * @param angleTenths	Angle to print
+ * @param valueTenths	Angle to print (in tenths of the unit)
  * @param rotationAxis  Axis around which the rotation angle is to print
+ * @param unit			Unit of the angle
  *
  * @return Success
- * @retval 1	Angle above maximum amplitude
+ * @retval 1	Drawing queue full
+ */
+errorCode_u SSD1306_printMeasureTenths(int16_t valueTenths, rotationAxis_e rotationAxis, measureUnit_e unit){
+    static const int16_t MAX_TENTHS[NB_UNITS] = {	///< Maximum absolute value printable in each unit (in tenths)
+        [UNIT_DEGREES]	= 900,
+        [UNIT_PERCENT]	= INT16_MAX,
+        [UNIT_TOPO]		= INT16_MAX,
+    };
+
+    if(unit >= NB_UNITS)
+        unit = UNIT_DEGREES;
+
+    //clamp the angle to print to the min value
+    if(valueTenths < -MAX_TENTHS[unit])
+        valueTenths = (int16_t)-MAX_TENTHS[unit];
+
+    //clamp the angle to print to the max value
+    if(valueTenths > MAX_TENTHS[unit])
+        valueTenths = MAX_TENTHS[unit];
+
+    //if the angle printed would not differ enough from the one displayed in the same unit, exit
+    //	(computed in 32 bits in case no angle is displayed yet)
+    int32_t deviation = (int32_t)valueTenths - (int32_t)_displayedAngles[rotationAxis];
+    if((unit == _displayedUnits[rotationAxis]) && (deviation <= _angleHysteresis) && (deviation >= -_angleHysteresis))
+        return (ERR_SUCCESS);
+
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_ANGLE, .parameter = (uint8_t)rotationAxis, .values = {valueTenths}, .unit = unit});
+    if(isError(result))
+        return (pushErrorCode(result, PRT_ANGLE, 1));
+
+    _displayedAngles[rotationAxis] = valueTenths;
+    _displayedUnits[rotationAxis] = unit;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Render an angle (with sign and unit) in the framebuffer
+ * @details Only the glyphs which differ from the ones already rendered are drawn,
+ *          so that only their columns are flushed (usually the tenths digit only, 28 bytes)
+ *
+ * @param valueTenths	Angle to render (in tenths of the unit, already clamped)
+ * @param rotationAxis  Axis around which the rotation angle is to render
+ * @param unit			Unit of the angle
  */
-errorCode_u SSD1306_printAngleTenths(int16_t angleTenths, rotationAxis_e rotationAxis){
+static void renderAngle(int16_t valueTenths, rotationAxis_e rotationAxis, measureUnit_e unit){
     static const uint8_t  ANGLE_COLUMN = 40U;		    ///< Column number of the first screen line
     static const uint8_t ANGLE_ROLL_PAGE = 1U;		    ///< Number of the page at which display the roll axis angle
     static const uint8_t ANGLE_PITCH_PAGE = 5U;		    ///< Number of the page at which display the pitch axis angle
-    static const int16_t MIN_ANGLE_DEG_TENTHS = -900;	///< Minimum angle allowed (in tenths of degrees)
-    static const int16_t MAX_ANGLE_DEG_TENTHS =  900;	///< Maximum angle allowed (in tenths of degrees)
     static const uint8_t INDEX_SIGN = 0;	            ///< Index of the sign in the angle indexes array
-    static const uint8_t INDEX_TENS = 1U;	            ///< Index of the tens in the angle indexes array
-    static const uint8_t INDEX_UNITS = 2U;	            ///< Index of the units in the angle indexes array
-    static const uint8_t INDEX_TENTHS = 4U;	            ///< Index of the tenths in the angle indexes array
-    uint8_t charIndexes[ANGLE_NB_CHARS] = {INDEX_PLUS, 0, 0, INDEX_DOT, 0, INDEX_DEG};
-    uint8_t* iterator = _screenBuffer;
+    static const uint8_t INDEX_NUMBER = 1U;	            ///< Index of the number field in the angle indexes array
+    static const uint8_t INDEX_UNIT = ANGLE_NB_CHARS - 1U;	///< Index of the unit in the angle indexes array
+    static const uint8_t UNIT_GLYPHS[NB_UNITS] = {		///< Glyph printed after the number, for each unit
+        [UNIT_DEGREES]	= INDEX_DEG,
+        [UNIT_PERCENT]	= INDEX_PERCENT,
+        [UNIT_TOPO]		= INDEX_TOPO,
+    };
+    uint8_t charIndexes[ANGLE_NB_CHARS];
 
-    //clamp the angle to print to the min value
-    if(angleTenths < MIN_ANGLE_DEG_TENTHS)
-        angleTenths = MIN_ANGLE_DEG_TENTHS;
+    //set the sign and the unit, then format the absolute value in between
+    charIndexes[INDEX_SIGN] = (valueTenths < 0 ? INDEX_MINUS : INDEX_PLUS);
+    charIndexes[INDEX_UNIT] = UNIT_GLYPHS[unit];
+    formatTenths((int16_t)(valueTenths < 0 ? -valueTenths : valueTenths), &charIndexes[INDEX_NUMBER]);
 
-    //clamp the angle to print to the max value
-    if(angleTenths > MAX_ANGLE_DEG_TENTHS)
-        angleTenths = MAX_ANGLE_DEG_TENTHS;
-
-    //if angle negative, replace plus sign with minus sign
-    if(angleTenths < 0){
-        charIndexes[INDEX_SIGN] = INDEX_MINUS;
-        angleTenths = -angleTenths;
-    }
-
-    //store the values
-    _limitColumns[0] = ANGLE_COLUMN;
-    _limitColumns[1] = ANGLE_COLUMN + (VERDANA_CHAR_WIDTH * ANGLE_NB_CHARS) - 1;
-    _limitPages[0] = (rotationAxis == ROLL ? ANGLE_ROLL_PAGE : ANGLE_PITCH_PAGE);
-    _limitPages[1] = (rotationAxis == ROLL ? ANGLE_ROLL_PAGE : ANGLE_PITCH_PAGE) + 1;
-    _size = ANGLE_NB_CHARS * VERDANA_NB_BYTES_CHAR;
-
-    //fill the angle characters indexes array with the float values (tens, units, tenths)
-    charIndexes[INDEX_TENS] = (uint8_t)(angleTenths / 100);
-    charIndexes[INDEX_UNITS] = (uint8_t)((angleTenths / 10) % 10);
-    charIndexes[INDEX_TENTHS] = (uint8_t)(angleTenths % 10);
-
-    //fill the buffer with all the required bitmaps bytes (column by column, then character by character, then page by page)
-    for(uint8_t page = 0 ; page < VERDANA_NB_PAGES ; page++){
-        for(uint8_t character = 0 ; character < ANGLE_NB_CHARS ; character++){
-            for(uint8_t column = 0 ; column < VERDANA_CHAR_WIDTH ; column++){
-                *iterator = verdana_16ptNumbers[charIndexes[character]][(VERDANA_CHAR_WIDTH * page) + column];
-                iterator++;
-            }
-        }
+    //draw the characters which changed one after the other
+    uint8_t page = (rotationAxis == ROLL ? ANGLE_ROLL_PAGE : ANGLE_PITCH_PAGE);
+    for(uint8_t character = 0 ; character < ANGLE_NB_CHARS ; character++){
+        if(charIndexes[character] == _displayedGlyphs[rotationAxis][character])
+            continue;
+
+        drawBitmap((uint8_t)(ANGLE_COLUMN + (character * VERDANA_WIDTH)), page, VERDANA_WIDTH, VERDANA_NB_PAGES, verdana_16ptNumbers[charIndexes[character]]);
+        _displayedGlyphs[rotationAxis][character] = charIndexes[character];
     }
+}
 
-    //get to printing state
-    _state = stSendingData;
-    return (ERR_SUCCESS);
+/**
+ * @brief Format a positive value in tenths into a fixed-width field of glyphs
+ * @details If the value fits with its tenths, the field gets zero-padded integer digits, a dot and the tenths digit (e.g. "05.3").
+ *          Otherwise, the tenths are dropped and the integer digits are right-aligned with spaces (e.g. " 123").
+ *
+ * @param valueTenths	Value to format (positive, with at most NUMBER_NB_CHARS integer digits)
+ * @param glyphs		Field of NUMBER_NB_CHARS glyphs to fill
+ */
+static void formatTenths(int16_t valueTenths, uint8_t glyphs[NUMBER_NB_CHARS]){
+    static const uint8_t DECIMAL_BASE = 10U;	///< Base in which the value is printed
+    uint16_t value = (uint16_t)valueTenths;
+    uint16_t tenthsLimit = 1U;
+    uint8_t padding = INDEX_0;
+    uint8_t character = NUMBER_NB_CHARS;
+
+    //get the first value which would not fit with its tenths (one digit and the dot less than the field)
+    for(uint8_t i = 1 ; i < NUMBER_NB_CHARS ; i++)
+        tenthsLimit = (uint16_t)(tenthsLimit * DECIMAL_BASE);
+
+    //print the tenths and the dot if they fit, otherwise drop them
+    if(value < tenthsLimit){
+        glyphs[--character] = (uint8_t)(value % DECIMAL_BASE);
+        glyphs[--character] = INDEX_DOT;
+    }
+    else
+        padding = INDEX_SPACE;
+    value /= DECIMAL_BASE;
+
+    //print the integer digits from the units to the highest ones, then pad the remaining characters
+    do{
+        glyphs[--character] = (uint8_t)(value % DECIMAL_BASE);
+        value /= DECIMAL_BASE;
+    }while(value && character);
+
+    while(character)
+        glyphs[--character] = padding;
 }
 
 /**
@@ -289,22 +863,13 @@ errorCode_u SSD1306_printAngleTenths(int16_t angleTenths, rotationAxis_e rotatio
  * 
  * @param type Referential type
  * @return Success
+ * @retval 1	Drawing queue full
  */
 errorCode_u SSD1306_printReferentialIcon(referentialType_e type){
-    uint8_t* iterator = _screenBuffer;
-    const uint8_t* iconIterator = (type == ABSOLUTE ? absoluteReferentialIcon : relativeReferentialIcon);
-
-    _limitColumns[0] = REFTYPE_COLUMN;
-    _limitColumns[1] = REFTYPE_COLUMN + REFERENCETYPE_NB_BYTES;
-    _limitPages[0] = REFTYPE_PAGE;
-    _limitPages[1] = REFTYPE_PAGE;
-    _size = REFERENCETYPE_NB_BYTES;
-
-    for(uint8_t i = 0 ; i < REFERENCETYPE_NB_BYTES ; i++)
-        *(iterator++) = *(iconIterator++);
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_REFERENTIAL, .parameter = (uint8_t)type});
+    if(isError(result))
+        return (pushErrorCode(result, PRT_REFERENTIAL, 1));
 
-    //get to printing state
-    _state = stSendingData;
     return (ERR_SUCCESS);
 }
 
@@ -313,165 +878,840 @@ errorCode_u SSD1306_printReferentialIcon(referentialType_e type){
  * 
  * @param status 1 to print, 0 to erase
  * @return Success
+ * @retval 1	Drawing queue full
  */
 errorCode_u SSD1306_printHoldIcon(uint8_t status){
-    uint8_t* iterator = _screenBuffer;
-    const uint8_t* iconIterator = holdIcon;
-
-    _limitColumns[0] = REFTYPE_COLUMN - REFERENCETYPE_NB_BYTES;
-    _limitColumns[1] = REFTYPE_COLUMN;
-    _limitPages[0] = REFTYPE_PAGE;
-    _limitPages[1] = REFTYPE_PAGE;
-    _size = REFERENCETYPE_NB_BYTES;
-
-    for(uint8_t i = 0 ; i < REFERENCETYPE_NB_BYTES ; i++)
-        if(status)
-            *(iterator++) = *(iconIterator++);
-        else
-            *(iterator++) = 0x00;
-
-    //get to printing state
-    _state = stSendingData;
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_HOLD, .parameter = status});
+    if(isError(result))
+        return (pushErrorCode(result, PRT_HOLD, 1));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Draw the icon telling whether the measurements are settled or still settling
+ *
+ * @param settled 1 if settled, 0 if settling
+ * @return Success
+ * @retval 1	Drawing queue full
+ */
+errorCode_u SSD1306_printStabilityIcon(uint8_t settled){
+    errorCode_u result = queueDrawing((drawCommand_t){.type = DRAW_STABILITY, .parameter = settled});
+    if(isError(result))
+        return (pushErrorCode(result, PRT_STABILITY, 1));
+
     return (ERR_SUCCESS);
 }
 
 /**
  * @brief Run the state machine
+ * @note With PROFILING, the cycles spent are accumulated to measure the CPU load of the back-end (see SSD1306getFrameStats())
  *
  * @return Return code of the current state
  */
 errorCode_u SSD1306update(){
-    return ((*_state)());
+    errorCode_u result;
+#if defined(PROFILING)
+    uint32_t start = profilerNow();
+#endif
+
+    PROFILE(_state, result = (*_state)());
+
+#if defined(PROFILING)
+    _fpsWindowCycles += profilerNow() - start;
+#endif
+    return (result);
+}
+
+
+/**
+ * @brief Queue a drawing, to be rendered in the framebuffer while no DMA transfer reads it
+ * @details If a drawing of the same element is already queued (and not followed by a base or graph screen), it is updated in place.
+ *          A burst of updates of the same element then only costs one rendering and the queue does not overflow.
+ *          Graph columns are never merged, as each one is plotted next to the previous one.
+ *
+ * @param command	Drawing to queue
+ * @return Success
+ * @retval 1	Queue full
+ */
+static errorCode_u queueDrawing(drawCommand_t command){
+    //look for the same element from the newest drawing to the oldest one
+    for(uint8_t i = _drawQueueCount ; i > 0 ; i--){
+        drawCommand_t* queued = &_drawQueue[(_drawQueueHead + i - 1U) & (DRAW_QUEUE_SIZE - 1U)];
+
+        if((queued->type == DRAW_BASE_SCREEN) || (queued->type == DRAW_GRAPH_SCREEN) || (command.type == DRAW_GRAPH_COLUMN))
+            break;
+
+        if((queued->type == command.type) && (((command.type != DRAW_ANGLE) && (command.type != DRAW_GRAPH_STATS)) || (queued->parameter == command.parameter))){
+            *queued = command;
+            return (ERR_SUCCESS);
+        }
+    }
+
+    if(_drawQueueCount >= DRAW_QUEUE_SIZE)
+        return (createErrorCode(QUEUE_DRAWING, 1, ERR_WARNING));
+
+    if(!_drawQueueCount)
+        _pendingSince_ms = systemTick_ms;
+
+    _drawQueue[(_drawQueueHead + _drawQueueCount) & (DRAW_QUEUE_SIZE - 1U)] = command;
+    _drawQueueCount++;
+    return (ERR_SUCCESS);
 }
 
+/**
+ * @brief Render all the drawings queued in the framebuffer, in order
+ * @note No DMA transfer must be reading the framebuffer
+ */
+static void renderDrawQueue(){
+    while(_drawQueueCount){
+        const drawCommand_t* command = &_drawQueue[_drawQueueHead];
+
+        switch(command->type){
+            case DRAW_BASE_SCREEN:
+                renderBaseScreen();
+                break;
+
+            case DRAW_GRAPH_SCREEN:
+                renderGraphScreen();
+                break;
+
+            case DRAW_BUBBLE:
+                if(_page == PAGE_GRAPHS)
+                    renderBubble((uint8_t)command->values[0], (uint8_t)command->values[1]);
+                break;
+
+            case DRAW_GRAPH_COLUMN:
+                if(_page == PAGE_GRAPHS)
+                    renderGraphColumn((rotationAxis_e)command->parameter, command->values[0], command->values[1]);
+                break;
+
+            case DRAW_GRAPH_STATS:
+                if(_page == PAGE_GRAPHS)
+                    renderGraphStats((rotationAxis_e)command->parameter, command->values[0], command->values[1]);
+                break;
+
+            case DRAW_ANGLE:
+                if(_page == PAGE_ANGLES)
+                    PROFILE(renderAngle, renderAngle(command->values[0], (rotationAxis_e)command->parameter, command->unit));
+                break;
+
+            case DRAW_REFERENTIAL:
+                if(_page == PAGE_ANGLES)
+                    drawBitmap(REFTYPE_COLUMN, ICONS_PAGE, REFERENCETYPE_WIDTH, REFERENCETYPE_NB_PAGES, (command->parameter == ABSOLUTE ? absoluteReferentialIcon : relativeReferentialIcon));
+                break;
+
+            case DRAW_HOLD:
+                if(_page != PAGE_ANGLES)
+                    break;
+
+                if(command->parameter)
+                    drawBitmap(HOLD_COLUMN, ICONS_PAGE, HOLDICON_WIDTH, HOLDICON_NB_PAGES, holdIcon);
+                else
+                    fillArea(HOLD_COLUMN, ICONS_PAGE, HOLDICON_WIDTH, HOLDICON_NB_PAGES, 0x00U);
+                break;
+
+            case DRAW_STABILITY:
+                if(_page == PAGE_ANGLES)
+                    drawBitmap(STABILITY_COLUMN, ICONS_PAGE, STABILITYICON_WIDTH, STABILITYICON_NB_PAGES, (command->parameter ? settledIcon : settlingIcon));
+                break;
+
+            default:
+                break;
+        }
+
+        _drawQueueHead = (uint8_t)((_drawQueueHead + 1U) & (DRAW_QUEUE_SIZE - 1U));
+        _drawQueueCount--;
+    }
+}
+
+/**
+ * @brief Copy a bitmap in the framebuffer and mark its columns as modified
+ *
+ * @param column	First column of the bitmap
+ * @param page		First page of the bitmap
+ * @param width		Number of columns of the bitmap
+ * @param nbPages	Number of pages of the bitmap
+ * @param bitmap	Bitmap bytes (page by page, then column by column)
+ */
+static RAMFUNC void drawBitmap(uint8_t column, uint8_t page, uint8_t width, uint8_t nbPages, const uint8_t bitmap[]){
+    assert(bitmap);
+    assert(width && ((column + width) <= SSD_NB_COLUMNS));
+    assert(nbPages && ((page + nbPages) <= SSD_NB_PAGES));
+
+    for(uint8_t i = 0 ; i < nbPages ; i++){
+        uint8_t* iterator = &_frameBuffer[((page + i) * SSD_NB_COLUMNS) + column];
+        for(uint8_t j = 0 ; j < width ; j++)
+            *(iterator++) = *(bitmap++);
+
+        markDirty((uint8_t)(page + i), column, (uint8_t)(column + width - 1U));
+    }
+}
+
+/**
+ * @brief Fill an area of the framebuffer with a single byte value and mark its columns as modified
+ *
+ * @param column	First column of the area
+ * @param page		First page of the area
+ * @param width		Number of columns of the area
+ * @param nbPages	Number of pages of the area
+ * @param value		Byte value to fill the area with
+ */
+static void fillArea(uint8_t column, uint8_t page, uint8_t width, uint8_t nbPages, uint8_t value){
+    assert(width && ((column + width) <= SSD_NB_COLUMNS));
+    assert(nbPages && ((page + nbPages) <= SSD_NB_PAGES));
+
+    for(uint8_t i = 0 ; i < nbPages ; i++){
+        uint8_t* iterator = &_frameBuffer[((page + i) * SSD_NB_COLUMNS) + column];
+        for(uint8_t j = 0 ; j < width ; j++)
+            *(iterator++) = value;
+
+        markDirty((uint8_t)(page + i), column, (uint8_t)(column + width - 1U));
+    }
+}
+
+/**
+ * @brief Light or blank a single pixel of the framebuffer and mark its column as modified
+ *
+ * @param column	Column of the pixel
+ * @param row		Row of the pixel (0 at the top of the screen)
+ * @param lit		1 to light the pixel, 0 to blank it
+ */
+static inline void setPixel(uint8_t column, uint8_t row, uint8_t lit){
+    assert((column < SSD_NB_COLUMNS) && (row < (SSD_NB_PAGES * 8U)));
+
+    uint8_t page = (uint8_t)(row >> 3);
+    uint8_t mask = (uint8_t)(1U << (row & 7U));
+    uint8_t* pixels = &_frameBuffer[(page * SSD_NB_COLUMNS) + column];
+
+    if(lit)
+        *pixels |= mask;
+    else
+        *pixels &= (uint8_t)~mask;
+
+    markDirty(page, column, column);
+}
+
+/**
+ * @brief Extend the span of modified columns of a page
+ *
+ * @param page			Page modified
+ * @param firstColumn	First column modified
+ * @param lastColumn	Last column modified
+ */
+static inline void markDirty(uint8_t page, uint8_t firstColumn, uint8_t lastColumn){
+    if(firstColumn < _dirtySpans[page].first)
+        _dirtySpans[page].first = firstColumn;
+
+    if(!isPageDirty(page) || (lastColumn > _dirtySpans[page].last))
+        _dirtySpans[page].last = lastColumn;
+}
+
+/**
+ * @brief Mark a page as identical to the screen RAM
+ *
+ * @param page Page flushed
+ */
+static inline void markClean(uint8_t page){
+    _dirtySpans[page].first = SSD_NB_COLUMNS;
+    _dirtySpans[page].last = 0;
+}
+
+/**
+ * @brief Check if a page has been modified since flushed
+ *
+ * @param page Page to check
+ * @retval 0 Page clean
+ * @retval 1 Page modified
+ */
+static inline uint8_t isPageDirty(uint8_t page){
+    return (_dirtySpans[page].first < SSD_NB_COLUMNS);
+}
+
+#if !defined(SSD1306_CIRCULAR_DMA)
+/**
+ * @brief Check if any page has been modified since flushed
+ *
+ * @retval 0 Framebuffer identical to the screen RAM
+ * @retval 1 Framebuffer modified
+ */
+static uint8_t isFrameDirty(){
+    for(uint8_t page = 0 ; page < SSD_NB_PAGES ; page++){
+        if(isPageDirty(page))
+            return (1);
+    }
+
+    return (0);
+}
+
+/**
+ * @brief Coalesce the modified spans of consecutive pages into the next rectangle to flush, then mark them clean
+ * @details A page is merged in the rectangle as long as the extra bytes sent because of it
+ *          cost less than flushing it in a region of its own (see REGION_OVERHEAD)
+ * @note A drawing happening while the region is flushed marks its columns modified again
+ *
+ * @param[out] region Rectangle to flush
+ * @retval 0 Nothing to flush
+ * @retval 1 Region to flush found
+ */
+static uint8_t nextFlushRegion(flushRegion_t* region){
+    uint8_t page = 0;
+
+    //find the first modified page
+    while((page < SSD_NB_PAGES) && !isPageDirty(page))
+        page++;
+
+    if(page >= SSD_NB_PAGES)
+        return (0);
+
+    region->columns[0] = _dirtySpans[page].first;
+    region->columns[1] = _dirtySpans[page].last;
+    region->pages[0] = region->pages[1] = page;
+
+    //merge the following modified pages while cheaper than flushing them separately
+    for(page++ ; (page < SSD_NB_PAGES) && isPageDirty(page) ; page++){
+        uint8_t first = (_dirtySpans[page].first < region->columns[0] ? _dirtySpans[page].first : region->columns[0]);
+        uint8_t last = (_dirtySpans[page].last > region->columns[1] ? _dirtySpans[page].last : region->columns[1]);
+        uint16_t extraBytes = (uint16_t)((last - first) - (_dirtySpans[page].last - _dirtySpans[page].first));
+        extraBytes += (uint16_t)(((last - first) - (region->columns[1] - region->columns[0])) * (region->pages[1] - region->pages[0] + 1));
+
+        if(extraBytes > REGION_OVERHEAD)
+            break;
+
+        region->columns[0] = first;
+        region->columns[1] = last;
+        region->pages[1] = page;
+    }
+
+    for(page = region->pages[0] ; page <= region->pages[1] ; page++)
+        markClean(page);
+
+    region->nextPage = region->pages[0];
+    return (1);
+}
+#endif
+
 
 /********************************************************************************************************************************************/
 /********************************************************************************************************************************************/
 
 
 /**
- * @brief State in which the SSD1306 configuration registers are set
+ * @brief State in which the SSD1306 reset is started
  * 
  * @return Success
- * @retval 1	Error while setting a configuration register
- * @retval 2	Error while requesting the screen wipe
  */
 static errorCode_u stConfiguring(){
-    #define NB_INIT_REGISERS    8U		                                ///< Number of registers set at initialisation
-    static const uint8_t initCommands[NB_INIT_REGISERS][3] = {			///< Array used to initialise the registers
-        {SCAN_DIRECTION_N1_0,	0,	0x00},
-        {HARDWARE_CONFIG,		1,	SSD_PIN_CONFIG_ALT | SSD_COM_REMAP_DISABLE},
-        {SEGMENT_REMAP_127,		0,	0x00},
-        {MEMORY_ADDR_MODE,		1,	SSD_HORIZONTAL_ADDR},
-        {CONTRAST_CONTROL,		1,	SSD_CONTRAST_HIGHEST},
-        {CLOCK_DIVIDE_RATIO,	1,	SSD_CLOCK_FREQ_MID | SSD_CLOCK_DIVIDER_1},
-        {CHG_PUMP_REGULATOR,	1,	SSD_ENABLE_CHG_PUMP},
-        {DISPLAY_ON,			0,	0x00},
-    };
-    errorCode_u result;
-
-    //reset the chip
+    //hold the chip in reset for the pulse duration
     LL_GPIO_ResetOutputPin(SSD1306_RES_GPIO_Port, SSD1306_RES_Pin);
-    LL_GPIO_SetOutputPin(SSD1306_RES_GPIO_Port, SSD1306_RES_Pin);
+    timerStart(&_timer, RESET_PULSE_MS);
+    _state = stResetting;
+    return (ERR_SUCCESS);
+}
 
-    //initialisation taken from PDF p. 64 (Application Example)
+/**
+ * @brief State in which the machine waits for the reset pulse and the reset recovery to elapse,
+ *        before sending the configuration commands in a single DMA transfer
+ * 
+ * @return Success
+ * @retval 1	Error while starting the transfer (the chip is reset again)
+ */
+static errorCode_u stResetting(){
+    errorCode_u result;
+
+    //initialisation taken from PDF p. 64 (Application Example), followed by the whole screen addressing
     //	values which don't change from reset values aren't modified
     //TODO test for max oscillator frequency
-    for(uint8_t i = 0 ; i < NB_INIT_REGISERS ; i++){
-        result = sendCommand(initCommands[i][0], &initCommands[i][2], initCommands[i][1]);
-        if(isError(result))
-            return (pushErrorCode(result, INIT, 1));
+    static const uint8_t INIT_COMMANDS[] = {
+        SCAN_DIRECTION_N1_0,
+        HARDWARE_CONFIG,	SSD_PIN_CONFIG_ALT | SSD_COM_REMAP_DISABLE,
+        SEGMENT_REMAP_127,
+        MEMORY_ADDR_MODE,	SSD_HORIZONTAL_ADDR,
+        CONTRAST_CONTROL,	SSD_CONTRAST_HIGHEST,
+        CLOCK_DIVIDE_RATIO,	SSD_CLOCK_FREQ_MID | SSD_CLOCK_DIVIDER_1,
+        CHG_PUMP_REGULATOR,	SSD_ENABLE_CHG_PUMP,
+        COLUMN_ADDRESS,		0,	SSD_LAST_COLUMN,
+        PAGE_ADDRESS,		0,	SSD_LAST_PAGE,
+        DISPLAY_ON,
+    };
+
+    //if the current phase of the reset has not elapsed yet, exit
+    if(timerIsRunning(&_timer))
+        return (ERR_SUCCESS);
+
+    //if the pulse is over, release the chip and wait for it to recover
+    if(!LL_GPIO_IsOutputPinSet(SSD1306_RES_GPIO_Port, SSD1306_RES_Pin)){
+        LL_GPIO_SetOutputPin(SSD1306_RES_GPIO_Port, SSD1306_RES_Pin);
+        timerStart(&_timer, RESET_RECOVERY_MS);
+        return (ERR_SUCCESS);
+    }
+
+    //send all the commands at once
+    result = startTransfer(INIT_COMMANDS, sizeof(INIT_COMMANDS), COMMAND);
+    if(isError(result)){
+        _state = stConfiguring;
+        return (pushErrorCode(result, RESETTING, 1));
+    }
+
+    _state = stSendingInit;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief State in which the machine waits for the configuration commands to be sent, before sending the base screen
+ * @details The base screen is sent directly from flash. The framebuffer is synchronised with it during the transfer.
+ * 
+ * @return Success
+ * @retval 1	Timeout while waiting for transmission to end (the chip is reset again)
+ * @retval 2	Error occurred during the DMA transfer (the chip is reset again)
+ * @retval 3	Error while starting the base screen transfer (the chip is reset again)
+ */
+static errorCode_u stSendingInit(){
+    errorCode_u result;
+
+    //if transmission not complete yet, exit
+    spiBusUpdate(_bus);
+    if(spiIsPending(&_transaction))
+        return (ERR_SUCCESS);
+
+    //if timeout or DMA error, restart the configuration
+    if(_transaction.status != SPI_DONE){
+        _state = stConfiguring;
+        return (createErrorCode(SENDING_INIT, (_transaction.status == SPI_TIMEOUT ? 1 : 2), ERR_ERROR));
+    }
+
+    //send the base screen
+    result = startTransfer(baseScreen, MAX_DATA_SIZE, DATA);
+    if(isError(result)){
+        _state = stConfiguring;
+        return (pushErrorCode(result, SENDING_INIT, 3));
+    }
+
+    //copy the base screen in the framebuffer while it is being sent
+    for(uint16_t i = 0 ; i < MAX_DATA_SIZE ; i++)
+        _frameBuffer[i] = baseScreen[i];
+
+    forgetRenderedGlyphs();
+    _state = stSendingBaseScreen;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief State in which the machine waits for the base screen to be sent, before running
+ * 
+ * @return Success
+ * @retval 1	Timeout while waiting for transmission to end (the chip is reset again)
+ * @retval 2	Error occurred during the DMA transfer (the chip is reset again)
+ * @retval 3	Error while starting the stream (SSD1306_CIRCULAR_DMA only)
+ */
+static errorCode_u stSendingBaseScreen(){
+    errorCode_u result;
+
+    //if transmission not complete yet, exit
+    spiBusUpdate(_bus);
+    if(spiIsPending(&_transaction))
+        return (ERR_SUCCESS);
+
+    //if timeout or DMA error, restart the configuration
+    if(_transaction.status != SPI_DONE){
+        _state = stConfiguring;
+        return (createErrorCode(SENDING_BASE, (_transaction.status == SPI_TIMEOUT ? 1 : 2), ERR_ERROR));
+    }
+
+    //the drawings queued in the meantime are rendered with the first frame
+    for(uint8_t i = 0 ; i < NB_ROTATIONS ; i++){
+        _displayedAngles[i] = ANGLE_UNKNOWN;
+        _displayedUnits[i] = UNIT_UNKNOWN;
+    }
+
+    timerStop(&_frameTimer);
+    _pendingSince_ms = systemTick_ms;
+    _state = RUNNING_STATE;
+
+#if defined(SSD1306_CIRCULAR_DMA)
+    result = startStreaming();
+    if(isError(result))
+        return (pushErrorCode(result, SENDING_BASE, 3));
+#else
+    result = ERR_SUCCESS;
+#endif
+    return (result);
+}
+
+/**
+ * @brief Start a frame : render the newest drawings queued and update the statistics
+ * @details Frames which could have started since the latest one, while drawings were waiting, are counted as dropped
+ * @note With partial updates, no DMA transfer must be reading the framebuffer
+ */
+static void startFrame(){
+    uint32_t now = systemTick_ms;
+    uint32_t due = _lastFrame_ms + _framePeriod_ms;
+
+    //count the frame periods elapsed since the frame was due
+    if(_frameStats.nbFrames && _framePeriod_ms){
+        if((int32_t)(_pendingSince_ms - due) > 0)
+            due = _pendingSince_ms;
+
+        uint32_t dropped = ((int32_t)(now - due) > 0 ? (now - due) / _framePeriod_ms : 0);
+        if(dropped){
+            _frameStats.nbDroppedFrames += dropped;
+            eventsPush(EVENT_FRAMES_DROPPED, 0, dropped);
+        }
     }
 
-    result = SSD1306drawBaseScreen();
+    _frameStats.nbFrames++;
+    _fpsWindowFrames++;
+    _lastFrame_ms = now;
+    timerStart(&_frameTimer, _framePeriod_ms);
+
+    //latch the newest drawings queued
+    renderDrawQueue();
+}
+
+/**
+ * @brief Update the achieved frame rate once per measurement window
+ */
+static void updateFrameRate(){
+    uint32_t elapsed = systemTick_ms - _fpsWindowStart_ms;
+
+    if(elapsed < FPS_WINDOW_MS)
+        return;
+
+    _frameStats.framesPerSecond = (uint16_t)((_fpsWindowFrames * 1000U) / elapsed);
+    _fpsWindowFrames = 0;
+#if defined(PROFILING)
+    _frameStats.cpuLoadPerMille = (uint16_t)(((uint64_t)_fpsWindowCycles * 1000U) / ((uint64_t)elapsed * (SystemCoreClock / 1000U)));
+    _fpsWindowCycles = 0;
+#endif
+    _fpsWindowStart_ms = systemTick_ms;
+}
+
+/**
+ * @brief Start a DMA transfer to the screen in the background
+ * @note The transfer status is given by _transaction
+ *
+ * @param buffer	Bytes to send
+ * @param size		Number of bytes to send
+ * @param function	Value of the data/command pin during the transfer
+ * @return Return code of the submission to the SPI bus
+ */
+static errorCode_u startTransfer(const uint8_t buffer[], uint16_t size, DCgpio_e function){
+    _transaction = (spiTransaction_t){
+        .tx = buffer,
+        .length = size,
+        .dataCommand = {SSD1306_DC_GPIO_Port, SSD1306_DC_Pin},
+        .dataCommandLevel = function,
+    };
+
+    return (spiBusSubmit(_bus, &_transaction));
+}
+
+#if defined(SSD1306_CIRCULAR_DMA)
+/**
+ * @brief Address the whole screen once, then stream the framebuffer to it continuously with a circular DMA
+ * @details In horizontal addressing mode, the screen wraps to the first column of the first page after the last byte,
+ *          so the framebuffer is kept in sync without any other command.
+ *          Both transactions are queued at once, the bus starts the stream as soon as the addressing commands are sent.
+ *
+ * @return Success
+ * @retval 1	Error while starting the addressing commands transfer
+ * @retval 2	Error while starting the stream
+ */
+static errorCode_u startStreaming(){
+    static const uint8_t ADDRESSING_COMMANDS[ADDRESSING_NB_BYTES] = {
+        COLUMN_ADDRESS,	0,	SSD_LAST_COLUMN,
+        PAGE_ADDRESS,	0,	SSD_LAST_PAGE,
+    };
+    errorCode_u result;
+
+    _addressingTransaction = (spiTransaction_t){
+        .tx = ADDRESSING_COMMANDS,
+        .length = ADDRESSING_NB_BYTES,
+        .dataCommand = {SSD1306_DC_GPIO_Port, SSD1306_DC_Pin},
+        .dataCommandLevel = COMMAND,
+    };
+
+    result = spiBusSubmit(_bus, &_addressingTransaction);
     if(isError(result))
-        return (pushErrorCode(result, INIT, 2));
+        return (pushErrorCode(result, START_STREAMING, 1));
+
+    //the frame is sent by the stream, no region needs flushing anymore
+    for(uint8_t page = 0 ; page < SSD_NB_PAGES ; page++)
+        markClean(page);
+
+    //start streaming (the DMA reloads itself after each frame)
+    _transaction = (spiTransaction_t){
+        .tx = _frameBuffer,
+        .length = MAX_DATA_SIZE,
+        .dataCommand = {SSD1306_DC_GPIO_Port, SSD1306_DC_Pin},
+        .dataCommandLevel = DATA,
+        .circular = 1,
+    };
+
+    result = spiBusSubmit(_bus, &_transaction);
+    if(isError(result)){
+        spiBusAbort(_bus);
+        return (pushErrorCode(result, START_STREAMING, 2));
+    }
 
-    _state = stSendingData;
     return (ERR_SUCCESS);
 }
 
 /**
- * @brief State in which the screen awaits for commands
+ * @brief State in which the framebuffer is streamed continuously to the screen
+ * @details The drawings queued are rendered in the framebuffer once per frame period,
+ *          the stream takes care of sending them
  *
  * @return Success
+ * @retval 1	Error occurred during the DMA transfer (stream restarted)
+ * @retval 2	Error while restarting the stream (the screen is reset and configured again)
  */
-errorCode_u stIdle(){
+static errorCode_u stStreaming(){
+    errorCode_u result;
+
+    //if the addressing commands failed or the stream stopped on a DMA error, restart it from the first byte and error
+    //	if it cannot be restarted, back off to a full reset instead of retrying at each pass
+    spiBusUpdate(_bus);
+    uint8_t addressingFailed = (!spiIsPending(&_addressingTransaction) && (_addressingTransaction.status != SPI_DONE));
+    if(addressingFailed || !spiIsPending(&_transaction)){
+        spiBusAbort(_bus);
+        result = startStreaming();
+        if(isError(result)){
+            _state = stConfiguring;
+            return (pushErrorCode(result, STREAMING, 2));
+        }
+        return (createErrorCode(STREAMING, 1, ERR_ERROR));
+    }
+
+    updateFrameRate();
+
+    //if nothing has been drawn since the latest frame, or the frame period has not elapsed yet, exit
+    if(!_drawQueueCount || timerIsRunning(&_frameTimer))
+        return (ERR_SUCCESS);
+
+    //render the drawings, the stream sends them with its next pass
+    startFrame();
+    for(uint8_t page = 0 ; page < SSD_NB_PAGES ; page++)
+        markClean(page);
+
     return (ERR_SUCCESS);
 }
+#else
+/**
+ * @brief State in which the screen awaits for the next frame
+ *
+ * @return Return code of the flush started (if any)
+ */
+errorCode_u stIdle(){
+    updateFrameRate();
+
+    //if nothing has been drawn since the latest frame, exit
+    if(!_drawQueueCount && !isFrameDirty())
+        return (ERR_SUCCESS);
+
+    //if the frame period has not elapsed yet, exit (the drawings queued keep being coalesced)
+    if(timerIsRunning(&_frameTimer))
+        return (ERR_SUCCESS);
+
+    startFrame();
+    return (stSendingData());
+}
 
 /**
- * @brief State in which data is sent to the screen
+ * @brief State in which the addressing of the next modified region of the framebuffer is sent
  *
  * @return Success
- * @retval 1	Error occurred while sending the column address command
- * @retval 2	Error occurred while sending the page address command
+ * @retval 1	Error while starting the transfer
  */
 errorCode_u stSendingData(){
     errorCode_u result;
 
-    //send the set start and end column addresses
-    result = sendCommand(COLUMN_ADDRESS, _limitColumns, 2);
-    if(isError(result)){
+    //if the whole framebuffer has been flushed, get back to idle
+    if(!nextFlushRegion(&_region)){
         _state = stIdle;
-        return (pushErrorCode(result, SENDING_DATA, 1));
+        return (ERR_SUCCESS);
     }
 
-    //send the set start and end page addresses
-    result = sendCommand(PAGE_ADDRESS, _limitPages, 2);
+    //set the start and end column addresses, then the start and end page addresses
+    _addressing[0] = COLUMN_ADDRESS;
+    _addressing[1] = _region.columns[0];
+    _addressing[2] = _region.columns[1];
+    _addressing[3] = PAGE_ADDRESS;
+    _addressing[4] = _region.pages[0];
+    _addressing[5] = _region.pages[1];
+
+    //send the addressing commands and get to next state
+    result = startTransfer(_addressing, ADDRESSING_NB_BYTES, COMMAND);
     if(isError(result)){
         _state = stIdle;
-        return (pushErrorCode(result, SENDING_DATA, 2));
+        return (pushErrorCode(result, SENDING_DATA, 1));
     }
 
-    //set data GPIO and enable SPI
-    setDataCommandGPIO(DATA);
-    LL_SPI_Enable(_spiHandle);
+    _state = stWaitingForAddressing;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Start the DMA transfer of the next part of the region being flushed
+ * @details The screen wraps to the next page of the region by itself after the last column.
+ *          A region spanning the whole width is contiguous in the framebuffer and sent at once,
+ *          otherwise it is sent page by page.
+ *
+ * @return Return code of the submission to the SPI bus
+ */
+static errorCode_u startRegionTransfer(){
+    uint8_t width = (uint8_t)(_region.columns[1] - _region.columns[0] + 1U);
+    uint8_t nbPages = 1U;
+
+    if(width == SSD_NB_COLUMNS)
+        nbPages = (uint8_t)(_region.pages[1] - _region.nextPage + 1U);
+
+    uint16_t first = (uint16_t)((_region.nextPage * SSD_NB_COLUMNS) + _region.columns[0]);
+    _region.nextPage = (uint8_t)(_region.nextPage + nbPages);
+    return (startTransfer(&_frameBuffer[first], (uint16_t)(width * nbPages), DATA));
+}
+
+/**
+ * @brief State in which the machine waits for the addressing commands to be sent, before sending the region data
+ *
+ * @return Success
+ * @retval 1	Timeout while waiting for transmission to end
+ * @retval 2	Error occurred during the DMA transfer
+ * @retval 3	Error while starting the region data transfer
+ */
+static errorCode_u stWaitingForAddressing(){
+    errorCode_u result;
+
+    //if transmission not complete yet, exit
+    spiBusUpdate(_bus);
+    if(spiIsPending(&_transaction))
+        return (ERR_SUCCESS);
 
-    //configure the DMA transaction
-    LL_DMA_DisableChannel(_dmaHandle, _dmaChannel);
-    LL_DMA_ClearFlag_GI5(_dmaHandle);
-    LL_DMA_SetDataLength(_dmaHandle, _dmaChannel, _size);
-    LL_DMA_EnableChannel(_dmaHandle, _dmaChannel);
+    //if timeout or DMA error, error
+    if(_transaction.status != SPI_DONE){
+        _state = stIdle;
+        return (createErrorCode(WAITING_ADDR_RDY, (_transaction.status == SPI_TIMEOUT ? 1 : 2), ERR_ERROR));
+    }
 
-    //send the data
-    screenTimer_ms = SPI_TIMEOUT_MS;
-    LL_SPI_EnableDMAReq_TX(_spiHandle);
+    //send the region data
+    result = startRegionTransfer();
+    if(isError(result)){
+        _state = stIdle;
+        return (pushErrorCode(result, WAITING_ADDR_RDY, 3));
+    }
 
-    //get to next
     _state = stWaitingForTXdone;
     return (ERR_SUCCESS);
 }
 
 /**
  * @brief State in which the machine waits for a DMA transmission to end
+ * @note Once a region is fully transmitted, the next one is flushed right away
  *
  * @return Success
  * @retval 1	Timeout while waiting for transmission to end
- * @retval 2	Error interrupt occurred during the DMA transfer
+ * @retval 2	Error occurred during the DMA transfer
+ * @retval 3	Error while starting the transfer of the next page
  */
 errorCode_u stWaitingForTXdone(){
-    errorCode_u result = ERR_SUCCESS;
+    errorCode_u result;
+
+    //if transmission not complete yet, exit
+    spiBusUpdate(_bus);
+    if(spiIsPending(&_transaction))
+        return (ERR_SUCCESS);
 
-    //if timer elapsed, stop DMA and error
-    if(!screenTimer_ms){
-        result = createErrorCode(WAITING_DMA_RDY, 1, ERR_ERROR);
-        goto finalise;
+    //if timeout or DMA error, error
+    if(_transaction.status != SPI_DONE){
+        _state = stIdle;
+        return (createErrorCode(WAITING_DMA_RDY, (_transaction.status == SPI_TIMEOUT ? 1 : 2), ERR_ERROR));
     }
 
-    //if DMA error, error
-    if(LL_DMA_IsActiveFlag_TE5(_dmaHandle)){
-        result = createErrorCode(WAITING_DMA_RDY, 2, ERR_ERROR);
-        goto finalise;
+    //if pages of the region remain, transmit the next one
+    if(_region.nextPage <= _region.pages[1]){
+        result = startRegionTransfer();
+        if(isError(result)){
+            _state = stIdle;
+            return (pushErrorCode(result, WAITING_DMA_RDY, 3));
+        }
+
+        return (ERR_SUCCESS);
     }
 
+    //flush the next region right away
+    return (stSendingData());
+}
+#endif
+
+/**
+ * @brief State in which the panel is switched off, waiting for SSD1306resume()
+ *
+ * @return Success
+ */
+static errorCode_u stSuspended(){
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief State in which the machine waits for the wake-up commands to be sent, before running again
+ *
+ * @return Success
+ * @retval 1	Timeout while waiting for transmission to end (the chip is reset again)
+ * @retval 2	Error occurred during the DMA transfer (the chip is reset again)
+ * @retval 3	Error while restarting the stream (SSD1306_CIRCULAR_DMA only)
+ */
+static errorCode_u stResuming(){
+    errorCode_u result = ERR_SUCCESS;
+
     //if transmission not complete yet, exit
-    if(!LL_DMA_IsActiveFlag_TC5(_dmaHandle))
+    spiBusUpdate(_bus);
+    if(spiIsPending(&_transaction))
         return (ERR_SUCCESS);
 
-finalise:
-    LL_DMA_DisableChannel(_dmaHandle, _dmaChannel);
-    LL_SPI_Disable(_spiHandle);
-    _state = stIdle;
-    return result;
+    //if timeout or DMA error, restart the configuration
+    if(_transaction.status != SPI_DONE){
+        _state = stConfiguring;
+        return (createErrorCode(RESUMING, (_transaction.status == SPI_TIMEOUT ? 1 : 2), ERR_ERROR));
+    }
+
+    //start a frame right away once woken up
+    timerStop(&_frameTimer);
+    _state = RUNNING_STATE;
+
+#if defined(SSD1306_CIRCULAR_DMA)
+    result = startStreaming();
+    if(isError(result))
+        return (pushErrorCode(result, RESUMING, 3));
+#endif
+    return (result);
+}
+
+#if defined(BENCHMARK)
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Render the angles computed by a benchmark step in the framebuffer, recording the duration of each render path
+ * @note To be called before SSD1306initialise(), the framebuffer being replaced by the base screen at start-up
+ *
+ * @param angles Roll and pitch angles (in tenths of degrees)
+ */
+void SSD1306benchmarkRender(const int16_t angles[NB_ROTATIONS]){
+    uint32_t start = profilerNow();
+    renderAngle(angles[ROLL], ROLL, UNIT_DEGREES);
+    benchmarkRecord(BENCH_RENDER_ANGLE, profilerNow() - start);
+
+    //the bubble goes through the drawing queue, as when printed by the application
+    if(_page != PAGE_GRAPHS)
+        renderGraphScreen();
+    SSD1306_printBubble(angles[ROLL], angles[PITCH]);
+    start = profilerNow();
+    renderDrawQueue();
+    benchmarkRecord(BENCH_RENDER_BUBBLE, profilerNow() - start);
+
+    start = profilerNow();
+    renderGraphColumn(ROLL, angles[ROLL], angles[ROLL]);
+    benchmarkRecord(BENCH_RENDER_GRAPH, profilerNow() - start);
 }
+#endif
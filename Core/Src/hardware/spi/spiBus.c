@@ -0,0 +1,466 @@
+/**
+ * @file spiBus.c
+ * @brief Implement the SPI transactions, queued and exchanged via DMA on behalf of the devices drivers
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * Each bus exchanges the transactions submitted in order, one DMA transfer per transaction.
+ * The bus drives the chip select and data/command pins of each transaction (if any),
+ * enables the SPI for the transfer (which lowers a hardware NSS) and disables it once over.
+ *
+ * The end of a transaction is detected :
+ *   - on a bus with a reception channel, by the reception channel interrupt (spiBusInterrupt()), as no byte remains to be shifted
+ *   - on a transmit-only bus, by polling the transmission channel (spiBusUpdate()), then waiting for the last byte to be shifted out
+ *
+ * spiBusUpdate() also detects the transactions not ended in time. It must be called regularly by the clients.
+ * spiBusTransfer() waits for the end of a transaction, and is only meant for the one-off initialisation sequences.
+ *
+ * The queue being shared with the interrupt handlers, it is only modified with the interrupts masked.
+ */
+#include "spiBus.h"
+#include "timers.h"
+
+//definitions
+#define SPI_TIMEOUT_MS		10U			///< Maximum number of milliseconds a transaction should last before timeout
+#define DMA_CHANNEL_FLAGS	4U			///< Number of bits of each channel flags in the DMA ISR and IFCR registers
+#define STOP_MAX_POLLS		4096U		///< Maximum number of polls of the SPI flags while stopping a transfer (> 2 bytes at 72MHz with a 256 prescaler)
+
+/**
+ * @brief Enumeration of the function IDs of the SPI bus
+ */
+typedef enum _spiBusFunctionCodes_e{
+    INITIALISE = 0,	///< spiBusInitialise()
+    SUBMIT,			///< spiBusSubmit()
+    TRANSFER,		///< spiBusTransfer()
+}spiBusFunctionCodes_e;
+
+/**
+ * @brief Structure defining the state of a bus
+ */
+typedef struct{
+    SPI_TypeDef*		handle;		///< SPI peripheral of the bus (null if not initialised)
+    DMA_TypeDef*		dma;		///< DMA used by the bus
+    uint32_t			channelTX;	///< DMA channel used to send the bytes
+    uint32_t			channelRX;	///< DMA channel used to receive the bytes (SPI_NO_DMA_CHANNEL if transmit-only)
+    spiTransaction_t*	head;		///< Transaction in progress (null if the bus is idle)
+    spiTransaction_t*	tail;		///< Latest transaction queued
+    softTimer_t			timer;		///< Timer used to make sure the transaction in progress does not time out
+    uint8_t				discard;	///< Byte receiving the replies not wanted
+}spiBusInstance_t;
+
+//tool functions
+static void startTransaction(spiBusInstance_t* instance);
+static void configureChannel(const spiBusInstance_t* instance, uint32_t channel, const uint8_t buffer[], uint8_t increment, uint16_t length, uint32_t mode);
+static void stopTransfer(spiBusInstance_t* instance);
+static void endTransaction(spiBusInstance_t* instance, spiStatus_e status);
+static inline uint32_t channelFlag(uint32_t channel, uint32_t flag);
+static inline uint32_t completionChannel(const spiBusInstance_t* instance);
+static inline uint32_t enterCritical();
+static inline void exitCritical(uint32_t primask);
+
+//state variables
+static spiBusInstance_t	_buses[NB_SPI_BUSES];	///< State of each bus
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Initialise a bus
+ * @note The SPI must be configured as master, and the DMA channels configured with it (byte-wide, normal mode)
+ * @warning spiBusInterrupt() must be called by the reception channel interrupt handler (transmission channel on a transmit-only bus)
+ *
+ * @param bus		Bus to initialise
+ * @param handle	SPI peripheral of the bus
+ * @param dma		DMA used by the bus
+ * @param channelTX	DMA channel used to send the bytes
+ * @param channelRX	DMA channel used to receive the bytes (SPI_NO_DMA_CHANNEL if transmit-only)
+ * @return Success
+ * @retval 1	Unknown bus or peripherals null
+ */
+errorCode_u spiBusInitialise(spiBus_e bus, SPI_TypeDef* handle, DMA_TypeDef* dma, uint32_t channelTX, uint32_t channelRX){
+    if((bus >= NB_SPI_BUSES) || !handle || !dma)
+        return (createErrorCode(INITIALISE, 1, ERR_ERROR));
+
+    spiBusInstance_t* instance = &_buses[bus];
+    *instance = (spiBusInstance_t){
+        .handle = handle,
+        .dma = dma,
+        .channelTX = channelTX,
+        .channelRX = channelRX,
+    };
+
+    //make sure to disable the SPI communication
+    LL_SPI_Disable(handle);
+    LL_DMA_DisableChannel(dma, channelTX);
+
+    //set the DMA peripheral addresses (memory addresses are set for each transaction)
+    LL_DMA_SetPeriphAddress(dma, channelTX, LL_SPI_DMA_GetRegAddr(handle));
+    if(channelRX != SPI_NO_DMA_CHANNEL){
+        LL_DMA_DisableChannel(dma, channelRX);
+        LL_DMA_SetPeriphAddress(dma, channelRX, LL_SPI_DMA_GetRegAddr(handle));
+
+        //enable the interrupts signalling the end of a transaction
+        LL_DMA_EnableIT_TC(dma, channelRX);
+    }
+
+    //transfer errors are signalled by the last channel of the transaction (TC enabled for each transaction on a transmit-only bus)
+    LL_DMA_EnableIT_TE(dma, completionChannel(instance));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Queue a transaction, and start it right away if the bus is idle
+ * @note Safe to call from interrupt handlers and transaction callbacks
+ *
+ * @param bus			Bus on which exchange the transaction
+ * @param transaction	Transaction to exchange
+ * @return Success
+ * @retval 1	Unknown bus or bus not initialised
+ * @retval 2	Transaction null or empty
+ * @retval 3	Transaction already pending
+ * @retval 4	Bus busy with a circular transaction
+ */
+errorCode_u spiBusSubmit(spiBus_e bus, spiTransaction_t* transaction){
+    errorCode_u result = ERR_SUCCESS;
+
+    if((bus >= NB_SPI_BUSES) || !_buses[bus].handle)
+        return (createErrorCode(SUBMIT, 1, ERR_WARNING));
+    if(!transaction || !transaction->length)
+        return (createErrorCode(SUBMIT, 2, ERR_WARNING));
+
+    spiBusInstance_t* instance = &_buses[bus];
+    uint32_t primask = enterCritical();
+
+    if(spiIsPending(transaction)){
+        result = createErrorCode(SUBMIT, 3, ERR_WARNING);
+        goto finalise;
+    }
+
+    //a circular transaction never ends, nothing can be queued after it
+    if(instance->head && instance->tail->circular){
+        result = createErrorCode(SUBMIT, 4, ERR_WARNING);
+        goto finalise;
+    }
+
+    //append the transaction to the queue, and start it if the bus is idle
+    transaction->next = (void*)0;
+    transaction->status = SPI_QUEUED;
+    if(instance->head)
+        instance->tail->next = transaction;
+    else
+        instance->head = transaction;
+    instance->tail = transaction;
+
+    if(instance->head == transaction)
+        startTransaction(instance);
+
+finalise:
+    exitCritical(primask);
+    return (result);
+}
+
+/**
+ * @brief Exchange a transaction and wait for it to end
+ * @note Only meant for the one-off sequences of the drivers (start-up, and the suspension done right before entering Stop mode) :
+ *       while running, the clients submit their transactions with spiBusSubmit() and carry on with their state machines
+ * @warning Must not be called from interrupt handlers or transaction callbacks
+ *
+ * @param bus			Bus on which exchange the transaction
+ * @param transaction	Transaction to exchange
+ * @return Success
+ * @retval 1	Circular transaction refused
+ * @retval 2	Error while submitting the transaction
+ * @retval 3	Timeout
+ * @retval 4	DMA error, or transaction aborted
+ */
+errorCode_u spiBusTransfer(spiBus_e bus, spiTransaction_t* transaction){
+    errorCode_u result;
+
+    if(transaction && transaction->circular)
+        return (createErrorCode(TRANSFER, 1, ERR_WARNING));
+
+    result = spiBusSubmit(bus, transaction);
+    if(isError(result))
+        return (pushErrorCode(result, TRANSFER, 2));
+
+    while(spiIsPending(transaction))
+        spiBusUpdate(bus);
+
+    if(transaction->status == SPI_TIMEOUT)
+        return (createErrorCode(TRANSFER, 3, ERR_WARNING));
+    if(transaction->status != SPI_DONE)
+        return (createErrorCode(TRANSFER, 4, ERR_WARNING));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Check the transaction in progress for its end (transmit-only buses), an error or a timeout
+ * @note Must be called regularly by the clients of the bus
+ *
+ * @param bus Bus to check
+ */
+void spiBusUpdate(spiBus_e bus){
+    if(bus >= NB_SPI_BUSES)
+        return;
+
+    spiBusInstance_t* instance = &_buses[bus];
+    uint32_t primask = enterCritical();
+    const spiTransaction_t* current = instance->head;
+
+    if(current && (current->status == SPI_IN_PROGRESS)){
+        uint32_t flags = instance->dma->ISR;
+        uint8_t transmitOnly = (instance->channelRX == SPI_NO_DMA_CHANNEL);
+
+        if((flags & channelFlag(instance->channelTX, DMA_ISR_TEIF1)) || (!transmitOnly && (flags & channelFlag(instance->channelRX, DMA_ISR_TEIF1))))
+            endTransaction(instance, SPI_DMA_ERROR);
+        else if(!current->circular && transmitOnly && (flags & channelFlag(instance->channelTX, DMA_ISR_TCIF1)))
+            endTransaction(instance, SPI_DONE);
+        else if(!current->circular && !timerIsRunning(&instance->timer))
+            endTransaction(instance, SPI_TIMEOUT);
+    }
+
+    exitCritical(primask);
+}
+
+/**
+ * @brief Handle the end of the DMA transfer of a transaction
+ * @note To be called from the reception channel interrupt handler (transmission channel on a transmit-only bus)
+ *
+ * @param bus Bus of which the channel interrupt fired
+ */
+void spiBusInterrupt(spiBus_e bus){
+    if((bus >= NB_SPI_BUSES) || !_buses[bus].handle)
+        return;
+
+    spiBusInstance_t* instance = &_buses[bus];
+    uint32_t channel = completionChannel(instance);
+    uint32_t flags = instance->dma->ISR;
+    instance->dma->IFCR = channelFlag(channel, DMA_IFCR_CGIF1);
+
+    if(!instance->head || (instance->head->status != SPI_IN_PROGRESS))
+        return;
+
+    if(flags & channelFlag(channel, DMA_ISR_TEIF1))
+        endTransaction(instance, SPI_DMA_ERROR);
+    else if((flags & channelFlag(channel, DMA_ISR_TCIF1)) && !instance->head->circular)
+        endTransaction(instance, SPI_DONE);
+}
+
+/**
+ * @brief Stop the transaction in progress (e.g. a circular one), and drop all the transactions queued
+ * @note The callbacks are called with the SPI_ABORTED status
+ *
+ * @param bus Bus to abort
+ */
+void spiBusAbort(spiBus_e bus){
+    if((bus >= NB_SPI_BUSES) || !_buses[bus].handle)
+        return;
+
+    spiBusInstance_t* instance = &_buses[bus];
+    uint32_t primask = enterCritical();
+    spiTransaction_t* transaction = instance->head;
+
+    //stop the transfer once the byte being shifted out is done
+    if(transaction){
+        stopTransfer(instance);
+        if(transaction->chipSelect.port)
+            LL_GPIO_SetOutputPin(transaction->chipSelect.port, transaction->chipSelect.pin);
+    }
+
+    //empty the queue
+    instance->head = (void*)0;
+    while(transaction){
+        spiTransaction_t* next = transaction->next;
+
+        transaction->next = (void*)0;
+        transaction->status = SPI_ABORTED;
+        if(transaction->callback)
+            (*transaction->callback)(transaction);
+
+        transaction = next;
+    }
+
+    exitCritical(primask);
+}
+
+/**
+ * @brief Check if a bus has no transaction in progress or queued
+ *
+ * @param bus Bus to check
+ * @retval 0 Bus busy
+ * @retval 1 Bus idle (or unknown)
+ */
+uint8_t spiBusIsIdle(spiBus_e bus){
+    if(bus >= NB_SPI_BUSES)
+        return (1);
+
+    return (_buses[bus].head == (void*)0);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Start the DMA transfer of the transaction at the head of the queue
+ * @note Interrupts must be masked
+ *
+ * @param instance Bus on which start the transaction
+ */
+static void startTransaction(spiBusInstance_t* instance){
+    static const uint8_t TX_FILLER = 0xFFU;	///< Value sent to keep the SPI clock running when no bytes are to be sent
+    spiTransaction_t* transaction = instance->head;
+    uint32_t mode = (transaction->circular ? LL_DMA_MODE_CIRCULAR : LL_DMA_MODE_NORMAL);
+
+    transaction->status = SPI_IN_PROGRESS;
+
+    //set the data/command pin and lower the chip select (if any)
+    if(transaction->dataCommand.port){
+        if(transaction->dataCommandLevel)
+            LL_GPIO_SetOutputPin(transaction->dataCommand.port, transaction->dataCommand.pin);
+        else
+            LL_GPIO_ResetOutputPin(transaction->dataCommand.port, transaction->dataCommand.pin);
+    }
+    if(transaction->chipSelect.port)
+        LL_GPIO_ResetOutputPin(transaction->chipSelect.port, transaction->chipSelect.pin);
+
+    //configure both DMA channels (RX first to avoid missing any byte)
+    if(instance->channelRX != SPI_NO_DMA_CHANNEL)
+        configureChannel(instance, instance->channelRX, (transaction->rx ? transaction->rx : &instance->discard), (transaction->rx != (void*)0), transaction->length, mode);
+    configureChannel(instance, instance->channelTX, (transaction->tx ? transaction->tx : &TX_FILLER), (transaction->tx != (void*)0), transaction->length, mode);
+
+    //on a transmit-only bus, only interrupt at the end of a normal transaction (a circular one would interrupt at each lap)
+    if(instance->channelRX == SPI_NO_DMA_CHANNEL){
+        if(transaction->circular)
+            LL_DMA_DisableIT_TC(instance->dma, instance->channelTX);
+        else
+            LL_DMA_EnableIT_TC(instance->dma, instance->channelTX);
+    }
+
+    //enable SPI (lowers a hardware NSS) and start the transfer
+    timerStart(&instance->timer, SPI_TIMEOUT_MS);
+    LL_SPI_Enable(instance->handle);
+    if(instance->channelRX != SPI_NO_DMA_CHANNEL)
+        LL_SPI_EnableDMAReq_RX(instance->handle);
+    LL_SPI_EnableDMAReq_TX(instance->handle);
+}
+
+/**
+ * @brief Configure and enable a DMA channel for a transaction
+ *
+ * @param instance	Bus of the channel
+ * @param channel	DMA channel to configure
+ * @param buffer	Memory address of the transfer
+ * @param increment	Flag indicating the memory address is incremented after each byte
+ * @param length	Number of bytes to transfer
+ * @param mode		DMA mode (normal or circular)
+ */
+static void configureChannel(const spiBusInstance_t* instance, uint32_t channel, const uint8_t buffer[], uint8_t increment, uint16_t length, uint32_t mode){
+    LL_DMA_DisableChannel(instance->dma, channel);
+    instance->dma->IFCR = channelFlag(channel, DMA_IFCR_CGIF1);
+    LL_DMA_SetMemoryAddress(instance->dma, channel, (uint32_t)buffer);
+    LL_DMA_SetMemoryIncMode(instance->dma, channel, (increment ? LL_DMA_MEMORY_INCREMENT : LL_DMA_MEMORY_NOINCREMENT));
+    LL_DMA_SetMode(instance->dma, channel, mode);
+    LL_DMA_SetDataLength(instance->dma, channel, length);
+    LL_DMA_EnableChannel(instance->dma, channel);
+}
+
+/**
+ * @brief Stop the DMA transfer once the byte being shifted out is done, and disable the SPI (raises a hardware NSS)
+ * @note Interrupts are masked by all the callers, so the SysTick cannot bound the wait :
+ *       it is bounded by a number of polls instead (the SPI is disabled anyway once they are exhausted)
+ *
+ * @param instance Bus to stop
+ */
+static void stopTransfer(spiBusInstance_t* instance){
+    uint16_t polls = STOP_MAX_POLLS;
+
+    LL_SPI_DisableDMAReq_TX(instance->handle);
+    while((!LL_SPI_IsActiveFlag_TXE(instance->handle) || LL_SPI_IsActiveFlag_BSY(instance->handle)) && polls)
+        polls--;
+    LL_SPI_DisableDMAReq_RX(instance->handle);
+
+    LL_DMA_DisableChannel(instance->dma, instance->channelTX);
+    instance->dma->IFCR = channelFlag(instance->channelTX, DMA_IFCR_CGIF1);
+    if(instance->channelRX != SPI_NO_DMA_CHANNEL){
+        LL_DMA_DisableChannel(instance->dma, instance->channelRX);
+        instance->dma->IFCR = channelFlag(instance->channelRX, DMA_IFCR_CGIF1);
+    }
+
+    //clear the overrun flag raised by the bytes not received
+    LL_SPI_ClearFlag_OVR(instance->handle);
+    LL_SPI_Disable(instance->handle);
+}
+
+/**
+ * @brief End the transaction in progress, start the next one queued (if any), then call the callback of the one ended
+ * @note Interrupts must be masked (or called from the completion channel interrupt handler)
+ *
+ * @param instance	Bus of the transaction
+ * @param status	Status with which the transaction ends
+ */
+static void endTransaction(spiBusInstance_t* instance, spiStatus_e status){
+    spiTransaction_t* transaction = instance->head;
+
+    stopTransfer(instance);
+    if(transaction->chipSelect.port)
+        LL_GPIO_SetOutputPin(transaction->chipSelect.port, transaction->chipSelect.pin);
+
+    //pop the transaction, and start the next one right away
+    instance->head = transaction->next;
+    transaction->next = (void*)0;
+    if(instance->head)
+        startTransaction(instance);
+
+    transaction->status = status;
+    if(transaction->callback)
+        (*transaction->callback)(transaction);
+}
+
+/**
+ * @brief Get the mask of a flag of a DMA channel, in the ISR and IFCR registers
+ *
+ * @param channel	DMA channel (LL_DMA_CHANNEL_x)
+ * @param flag		Flag of the channel 1 (e.g. DMA_ISR_TCIF1)
+ * @return Flag of the channel
+ */
+static inline uint32_t channelFlag(uint32_t channel, uint32_t flag){
+    return (flag << ((channel - 1U) * DMA_CHANNEL_FLAGS));
+}
+
+/**
+ * @brief Get the DMA channel of which the interrupts signal the end of a transaction
+ *
+ * @param instance Bus of the channel
+ * @return Reception channel, or transmission channel on a transmit-only bus
+ */
+static inline uint32_t completionChannel(const spiBusInstance_t* instance){
+    return ((instance->channelRX != SPI_NO_DMA_CHANNEL) ? instance->channelRX : instance->channelTX);
+}
+
+/**
+ * @brief Mask the interrupts
+ *
+ * @return Interrupts mask before the call
+ */
+static inline uint32_t enterCritical(){
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    return (primask);
+}
+
+/**
+ * @brief Restore the interrupts mask
+ *
+ * @param primask Interrupts mask returned by enterCritical()
+ */
+static inline void exitCritical(uint32_t primask){
+    __set_PRIMASK(primask);
+}
@@ -24,6 +24,15 @@
 #include "ADXL345.h"
 #include "SSD1306.h"
 #include "buttons.h"
+#include "eeprom.h"
+#include "history.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "events.h"
+#include "telemetry.h"
+#if defined(BENCHMARK)
+#include "benchmark.h"
+#endif
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -33,6 +42,19 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#define IWDG_PRESCALER_RUN    LL_IWDG_PRESCALER_4   ///< Watchdog prescaler while running (must match MX_IWDG_Init(), 100ms timeout)
+#define IWDG_PRESCALER_STOP   LL_IWDG_PRESCALER_64  ///< Watchdog prescaler while in Stop mode (1.6s timeout)
+#define STOP_WAKEUP_PERIOD_S  1U                    ///< Number of seconds between two watchdog reloads while in Stop mode
+#define TOPO_PER_PERCENT      66                    ///< Number of topo in 100 percent of grade (rise over a 66 feet chain)
+#define GRAPH_COLUMN_MS       250U                  ///< Number of milliseconds of history plotted in each graph column
+#define GRAPH_REPLAY_COLUMNS  2U                    ///< Number of graph columns replayed from the history each time the screen is ready
+#define ACCELEROMETER_PERIOD_MS 10U                 ///< Number of milliseconds between two accelerometer polls (also signaled by its interrupts)
+#define SCREEN_PERIOD_MS      5U                    ///< Number of milliseconds between two screen polls (also signaled by its DMA interrupts)
+#define BUTTONS_PERIOD_MS     5U                    ///< Number of milliseconds between two buttons polls (only while a button is busy, its EXTI edges signal it otherwise)
+#define APPLICATION_PERIOD_MS 10U                   ///< Number of milliseconds between two application runs (also signaled by new snapshots)
+#define EVENTS_PERIOD_MS      100U                  ///< Number of milliseconds between two events ring drains
+#define EVENTS_PER_DRAIN      4U                    ///< Maximum number of events sent per drain
+#define EVENTS_ITM_PORT       2U                    ///< ITM stimulus port on which the events are sent
 
 /* USER CODE END PD */
 
@@ -44,6 +66,18 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
+volatile uint32_t systemTick_ms = 0;  ///< Number of milliseconds elapsed since start-up
+static uint8_t holdingValues = 0;           ///< Flag indicating the measurements printed are held
+static int16_t displayedRoll = INT16_MAX;   ///< Roll angle printed (in tenths of the unit)
+static int16_t displayedPitch = INT16_MAX;  ///< Pitch angle printed (in tenths of the unit)
+static uint8_t displayedSettled = UINT8_MAX;  ///< Stability printed (UINT8_MAX if none)
+static uint8_t referentialPrinted = 0;      ///< Flag indicating the referential restored at start-up has been printed
+static uint8_t calibrated = 0;              ///< Flag indicating a calibration has been done during the current buttons hold
+static measureUnit_e unit = UNIT_DEGREES;   ///< Unit in which the angles are printed
+static uint8_t graphsView = 0;              ///< Flag indicating the graphs view is shown
+static uint32_t lastSequence = 0;           ///< Sequence of the latest snapshot recorded in the history
+static uint32_t graphColumnStart_ms = 0;    ///< Timestamp of the first snapshot of the current graph column
+static uint16_t spansToReplay = 0;          ///< Number of history spans left to replay in the graphs
 
 /* USER CODE END PV */
 
@@ -54,7 +88,24 @@ static void MX_DMA_Init(void);
 static void MX_SPI1_Init(void);
 static void MX_SPI2_Init(void);
 static void MX_IWDG_Init(void);
+static void MX_TIM2_Init(void);
+static void MX_RTC_Init(void);
+static void MX_USART2_UART_Init(void);
 /* USER CODE BEGIN PFP */
+static uint8_t sleepUntilWokenUp();
+static void setWatchdogPrescaler(uint32_t prescaler);
+static void setRTCalarm(uint32_t seconds);
+static void saveCalibration();
+static int16_t getMeasureTenths(const adxlSnapshot_t* snapshot, rotationAxis_e axis, measureUnit_e unit);
+static void printGraphStats();
+static errorCode_u accelerometerTask();
+static errorCode_u buttonsTask();
+static errorCode_u applicationTask();
+static errorCode_u eventsTask();
+static void sendEvent(const event_t* event);
+#if defined(BENCHMARK)
+static void runBenchmark();
+#endif
 
 /* USER CODE END PFP */
 
@@ -70,7 +121,8 @@ static void MX_IWDG_Init(void);
 int main(void)
 {
   /* USER CODE BEGIN 1 */
-  uint8_t holdingValues = 0;
+  adxlBootMode_e adxlBootMode = ADXL_BOOT_COLD;
+  adxlCalibration_t calibration;
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -97,6 +149,10 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  //warm boot only after a watchdog reset (a power-on reset forces the full start-up sequence)
+  if(LL_RCC_IsActiveFlag_IWDGRST() && !LL_RCC_IsActiveFlag_PORRST())
+    adxlBootMode = ADXL_BOOT_WARM;
+  LL_RCC_ClearResetFlags();
 
   /* USER CODE END SysInit */
 
@@ -106,57 +162,58 @@ int main(void)
   MX_SPI1_Init();
   MX_SPI2_Init();
   MX_IWDG_Init();
+  MX_TIM2_Init();
+  MX_RTC_Init();
+  MX_USART2_UART_Init();
   /* USER CODE BEGIN 2 */
+  eventsInitialise();
   LL_SYSTICK_EnableIT();
-  ADXL345initialise(SPI1);
-  SSD1306initialise(SPI2, DMA1, LL_DMA_CHANNEL_5);
+  PROFILE_INIT();
+  spiBusInitialise(SPI_BUS_1, SPI1, DMA1, LL_DMA_CHANNEL_3, LL_DMA_CHANNEL_2);
+  spiBusInitialise(SPI_BUS_2, SPI2, DMA1, LL_DMA_CHANNEL_5, SPI_NO_DMA_CHANNEL);
+#if defined(BENCHMARK)
+  runBenchmark();
+#endif
+  ADXL345initialise(SPI_BUS_1, TIM2, adxlBootMode);
+  ADXL345setProfile(ADXL_PROFILE_ADAPTIVE);
+  SSD1306initialise(SPI_BUS_2);
+  telemetryInitialise(USART2, DMA1, LL_DMA_CHANNEL_7);
+
+  //restore the calibration and the zeroing persisted before the last reset (if any)
+  EEPROMinitialise();
+  if(!isError(EEPROMread(&calibration, sizeof(calibration))))
+    ADXL345setCalibration(&calibration);
+  historyReset();
+  buttonsInitialise();
+
+  //register the tasks, by decreasing priority
+  schedulerRegister(TASK_ACCELEROMETER, accelerometerTask, ACCELEROMETER_PERIOD_MS);
+  schedulerRegister(TASK_SCREEN, SSD1306update, SCREEN_PERIOD_MS);
+  schedulerRegister(TASK_BUTTONS, buttonsTask, BUTTONS_PERIOD_MS);
+  schedulerRegister(TASK_APPLICATION, applicationTask, APPLICATION_PERIOD_MS);
+  schedulerRegister(TASK_EVENTS, eventsTask, EVENTS_PERIOD_MS);
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
-  errorCode_u result;
   while (1)
   {
+    //measure the previous iteration, and send the profiling report (if any)
+    PROFILE_LOOP();
+
     //reset the watchdog
     LL_IWDG_ReloadCounter(IWDG);
 
-	  //update the accelerometer state machine
-	  result = ADXL345update();
-	  if(isError(result))
-		  result.fields.moduleID = 1;
-
-	  //update the screen state machine
-	  result = SSD1306update();
-	  if(isError(result))
-		  result.fields.moduleID = 2;
-
-    //update the buttons' state machines
-    buttonsUpdate();
-  
-    //if zero button is pressed, zero down measurements
-    if(buttonHasRisingEdge(ZERO)){
-      ADXLzeroDown();
-      SSD1306_printReferentialIcon(RELATIVE);
-    }
+    //run the most urgent task due (if any), then start over
+    if(schedulerRun())
+      continue;
 
-    //if zero button is pressed, get back to absolute measurements
-    if(isButtonHeldDown(ZERO)){
-      ADXLcancelZeroing();
-      SSD1306_printReferentialIcon(ABSOLUTE);
-    }
+    //if the device has been still for long enough, sleep until it moves or a button is pressed
+    if(ADXL345isInactive() && isScreenReady() && !isAnyButtonDown())
+      sleepUntilWokenUp();
 
-    if(buttonHasRisingEdge(HOLD)){
-      holdingValues = !holdingValues;
-      SSD1306_printHoldIcon(holdingValues);
-    }
-
-	  //if X axis angle changed, update the screen
-	  if(isScreenReady() && ADXL345hasChanged(X_AXIS) && !holdingValues)
-		  SSD1306_printAngleTenths(getAngleDegreesTenths(X_AXIS), ROLL);
-
-	  //if Y axis angle changed, update the screen
-	  if(isScreenReady() && ADXL345hasChanged(Y_AXIS) && !holdingValues)
-		  SSD1306_printAngleTenths(getAngleDegreesTenths(Y_AXIS), PITCH);
+    //if no task is due, sleep until the next interrupt (SysTick, ADXL watermark EXTI or DMA)
+    PROFILE_IDLE(schedulerIdle());
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -188,6 +245,14 @@ void SystemClock_Config(void)
   {
 
   }
+  LL_PWR_EnableBkUpAccess();
+  if(LL_RCC_GetRTCClockSource() != LL_RCC_RTC_CLKSOURCE_LSI)
+  {
+    LL_RCC_ForceBackupDomainReset();
+    LL_RCC_ReleaseBackupDomainReset();
+    LL_RCC_SetRTCClockSource(LL_RCC_RTC_CLKSOURCE_LSI);
+  }
+  LL_RCC_EnableRTC();
   LL_RCC_PLL_ConfigDomain_SYS(LL_RCC_PLLSOURCE_HSE_DIV_1, LL_RCC_PLL_MUL_9);
   LL_RCC_PLL_Enable();
 
@@ -240,6 +305,49 @@ static void MX_IWDG_Init(void)
 
 }
 
+/**
+  * @brief RTC Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_RTC_Init(void)
+{
+
+  /* USER CODE BEGIN RTC_Init 0 */
+
+  /* USER CODE END RTC_Init 0 */
+
+  LL_RTC_InitTypeDef RTC_InitStruct = {0};
+
+  LL_PWR_EnableBkUpAccess();
+  /* Enable BKP CLK enable for backup registers */
+  LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_BKP);
+  /* Peripheral clock enable */
+  LL_RCC_EnableRTC();
+
+  /* RTC interrupt Init */
+  NVIC_SetPriority(RTC_Alarm_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(),0, 0));
+  NVIC_EnableIRQ(RTC_Alarm_IRQn);
+
+  /* USER CODE BEGIN RTC_Init 1 */
+
+  /* USER CODE END RTC_Init 1 */
+
+  /** Initialize RTC and set the Time and Date
+  */
+  RTC_InitStruct.AsynchPrescaler = 39999;
+  LL_RTC_Init(RTC, &RTC_InitStruct);
+  LL_RTC_SetAsynchPrescaler(RTC, 39999);
+  /* USER CODE BEGIN RTC_Init 2 */
+  //route the alarm to the EXTI line 17 so that it wakes the MCU up from Stop mode
+  LL_RTC_ClearFlag_ALR(RTC);
+  LL_RTC_EnableIT_ALR(RTC);
+  LL_EXTI_EnableRisingTrig_0_31(LL_EXTI_LINE_17);
+  LL_EXTI_EnableIT_0_31(LL_EXTI_LINE_17);
+  /* USER CODE END RTC_Init 2 */
+
+}
+
 /**
   * @brief SPI1 Initialization Function
   * @param None
@@ -276,6 +384,38 @@ static void MX_SPI1_Init(void)
   GPIO_InitStruct.Mode = LL_GPIO_MODE_FLOATING;
   LL_GPIO_Init(ADXL_SDO_GPIO_Port, &GPIO_InitStruct);
 
+  /* SPI1 DMA Init */
+
+  /* SPI1_RX Init */
+  LL_DMA_SetDataTransferDirection(DMA1, LL_DMA_CHANNEL_2, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+
+  LL_DMA_SetChannelPriorityLevel(DMA1, LL_DMA_CHANNEL_2, LL_DMA_PRIORITY_HIGH);
+
+  LL_DMA_SetMode(DMA1, LL_DMA_CHANNEL_2, LL_DMA_MODE_NORMAL);
+
+  LL_DMA_SetPeriphIncMode(DMA1, LL_DMA_CHANNEL_2, LL_DMA_PERIPH_NOINCREMENT);
+
+  LL_DMA_SetMemoryIncMode(DMA1, LL_DMA_CHANNEL_2, LL_DMA_MEMORY_INCREMENT);
+
+  LL_DMA_SetPeriphSize(DMA1, LL_DMA_CHANNEL_2, LL_DMA_PDATAALIGN_BYTE);
+
+  LL_DMA_SetMemorySize(DMA1, LL_DMA_CHANNEL_2, LL_DMA_MDATAALIGN_BYTE);
+
+  /* SPI1_TX Init */
+  LL_DMA_SetDataTransferDirection(DMA1, LL_DMA_CHANNEL_3, LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+
+  LL_DMA_SetChannelPriorityLevel(DMA1, LL_DMA_CHANNEL_3, LL_DMA_PRIORITY_MEDIUM);
+
+  LL_DMA_SetMode(DMA1, LL_DMA_CHANNEL_3, LL_DMA_MODE_NORMAL);
+
+  LL_DMA_SetPeriphIncMode(DMA1, LL_DMA_CHANNEL_3, LL_DMA_PERIPH_NOINCREMENT);
+
+  LL_DMA_SetMemoryIncMode(DMA1, LL_DMA_CHANNEL_3, LL_DMA_MEMORY_INCREMENT);
+
+  LL_DMA_SetPeriphSize(DMA1, LL_DMA_CHANNEL_3, LL_DMA_PDATAALIGN_BYTE);
+
+  LL_DMA_SetMemorySize(DMA1, LL_DMA_CHANNEL_3, LL_DMA_MDATAALIGN_BYTE);
+
   /* USER CODE BEGIN SPI1_Init 1 */
 
   /* USER CODE END SPI1_Init 1 */
@@ -366,6 +506,111 @@ static void MX_SPI2_Init(void)
 
 }
 
+/**
+  * @brief TIM2 Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_TIM2_Init(void)
+{
+
+  /* USER CODE BEGIN TIM2_Init 0 */
+
+  /* USER CODE END TIM2_Init 0 */
+
+  LL_TIM_InitTypeDef TIM_InitStruct = {0};
+
+  /* Peripheral clock enable */
+  LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM2);
+
+  /* TIM2 interrupt Init */
+  NVIC_SetPriority(TIM2_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(),0, 0));
+  NVIC_EnableIRQ(TIM2_IRQn);
+
+  /* USER CODE BEGIN TIM2_Init 1 */
+
+  /* USER CODE END TIM2_Init 1 */
+  TIM_InitStruct.Prescaler = 71;
+  TIM_InitStruct.CounterMode = LL_TIM_COUNTERMODE_UP;
+  TIM_InitStruct.Autoreload = 4;
+  TIM_InitStruct.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1;
+  LL_TIM_Init(TIM2, &TIM_InitStruct);
+  LL_TIM_DisableARRPreload(TIM2);
+  LL_TIM_SetClockSource(TIM2, LL_TIM_CLOCKSOURCE_INTERNAL);
+  LL_TIM_SetOnePulseMode(TIM2, LL_TIM_ONEPULSEMODE_SINGLE);
+  LL_TIM_SetTriggerOutput(TIM2, LL_TIM_TRGO_RESET);
+  LL_TIM_DisableMasterSlaveMode(TIM2);
+  /* USER CODE BEGIN TIM2_Init 2 */
+  LL_TIM_SetUpdateSource(TIM2, LL_TIM_UPDATESOURCE_COUNTER);
+  /* USER CODE END TIM2_Init 2 */
+
+}
+
+/**
+  * @brief USART2 Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_USART2_UART_Init(void)
+{
+
+  /* USER CODE BEGIN USART2_Init 0 */
+
+  /* USER CODE END USART2_Init 0 */
+
+  LL_USART_InitTypeDef USART_InitStruct = {0};
+
+  LL_GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  /* Peripheral clock enable */
+  LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_USART2);
+
+  LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_GPIOA);
+  /**USART2 GPIO Configuration
+  PA2   ------> USART2_TX
+  */
+  GPIO_InitStruct.Pin = LL_GPIO_PIN_2;
+  GPIO_InitStruct.Mode = LL_GPIO_MODE_ALTERNATE;
+  GPIO_InitStruct.Speed = LL_GPIO_SPEED_FREQ_HIGH;
+  GPIO_InitStruct.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
+  LL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+  /* USART2 DMA Init */
+
+  /* USART2_TX Init */
+  LL_DMA_SetDataTransferDirection(DMA1, LL_DMA_CHANNEL_7, LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+
+  LL_DMA_SetChannelPriorityLevel(DMA1, LL_DMA_CHANNEL_7, LL_DMA_PRIORITY_LOW);
+
+  LL_DMA_SetMode(DMA1, LL_DMA_CHANNEL_7, LL_DMA_MODE_NORMAL);
+
+  LL_DMA_SetPeriphIncMode(DMA1, LL_DMA_CHANNEL_7, LL_DMA_PERIPH_NOINCREMENT);
+
+  LL_DMA_SetMemoryIncMode(DMA1, LL_DMA_CHANNEL_7, LL_DMA_MEMORY_INCREMENT);
+
+  LL_DMA_SetPeriphSize(DMA1, LL_DMA_CHANNEL_7, LL_DMA_PDATAALIGN_BYTE);
+
+  LL_DMA_SetMemorySize(DMA1, LL_DMA_CHANNEL_7, LL_DMA_MDATAALIGN_BYTE);
+
+  /* USER CODE BEGIN USART2_Init 1 */
+
+  /* USER CODE END USART2_Init 1 */
+  USART_InitStruct.BaudRate = 460800;
+  USART_InitStruct.DataWidth = LL_USART_DATAWIDTH_8B;
+  USART_InitStruct.StopBits = LL_USART_STOPBITS_1;
+  USART_InitStruct.Parity = LL_USART_PARITY_NONE;
+  USART_InitStruct.TransferDirection = LL_USART_DIRECTION_TX;
+  USART_InitStruct.HardwareFlowControl = LL_USART_HWCONTROL_NONE;
+  USART_InitStruct.OverSampling = LL_USART_OVERSAMPLING_16;
+  LL_USART_Init(USART2, &USART_InitStruct);
+  LL_USART_ConfigAsyncMode(USART2);
+  LL_USART_Enable(USART2);
+  /* USER CODE BEGIN USART2_Init 2 */
+
+  /* USER CODE END USART2_Init 2 */
+
+}
+
 /**
   * Enable DMA controller clock
   */
@@ -376,6 +621,14 @@ static void MX_DMA_Init(void)
   /* DMA controller clock enable */
   LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
 
+  /* DMA interrupt init */
+  /* DMA1_Channel2_IRQn interrupt configuration */
+  NVIC_SetPriority(DMA1_Channel2_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(),0, 0));
+  NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+  /* DMA1_Channel5_IRQn interrupt configuration */
+  NVIC_SetPriority(DMA1_Channel5_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(),0, 0));
+  NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+
 }
 
 /**
@@ -385,6 +638,7 @@ static void MX_DMA_Init(void)
   */
 static void MX_GPIO_Init(void)
 {
+  LL_EXTI_InitTypeDef EXTI_InitStruct = {0};
   LL_GPIO_InitTypeDef GPIO_InitStruct = {0};
 /* USER CODE BEGIN MX_GPIO_Init_1 */
 /* USER CODE END MX_GPIO_Init_1 */
@@ -397,12 +651,6 @@ static void MX_GPIO_Init(void)
   /**/
   LL_GPIO_ResetOutputPin(GPIOA, SSD1306_DC_Pin|SSD1306_RES_Pin);
 
-  /**/
-  GPIO_InitStruct.Pin = ADXL_INT1_Pin|ZERO_BUTTON_Pin|HOLD_BUTTON_Pin;
-  GPIO_InitStruct.Mode = LL_GPIO_MODE_INPUT;
-  GPIO_InitStruct.Pull = LL_GPIO_PULL_UP;
-  LL_GPIO_Init(GPIOB, &GPIO_InitStruct);
-
   /**/
   GPIO_InitStruct.Pin = SSD1306_DC_Pin|SSD1306_RES_Pin;
   GPIO_InitStruct.Mode = LL_GPIO_MODE_OUTPUT;
@@ -410,12 +658,438 @@ static void MX_GPIO_Init(void)
   GPIO_InitStruct.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
   LL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
+  /**/
+  LL_GPIO_AF_SetEXTISource(LL_GPIO_AF_EXTI_PORTB, LL_GPIO_AF_EXTI_LINE0);
+
+  /**/
+  LL_GPIO_AF_SetEXTISource(LL_GPIO_AF_EXTI_PORTB, LL_GPIO_AF_EXTI_LINE10);
+
+  /**/
+  LL_GPIO_AF_SetEXTISource(LL_GPIO_AF_EXTI_PORTB, LL_GPIO_AF_EXTI_LINE11);
+
+  /**/
+  EXTI_InitStruct.Line_0_31 = LL_EXTI_LINE_0;
+  EXTI_InitStruct.LineCommand = ENABLE;
+  EXTI_InitStruct.Mode = LL_EXTI_MODE_IT;
+  EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_FALLING;
+  LL_EXTI_Init(&EXTI_InitStruct);
+
+  /**/
+  EXTI_InitStruct.Line_0_31 = LL_EXTI_LINE_10;
+  EXTI_InitStruct.LineCommand = ENABLE;
+  EXTI_InitStruct.Mode = LL_EXTI_MODE_IT;
+  EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_RISING_FALLING;
+  LL_EXTI_Init(&EXTI_InitStruct);
+
+  /**/
+  EXTI_InitStruct.Line_0_31 = LL_EXTI_LINE_11;
+  EXTI_InitStruct.LineCommand = ENABLE;
+  EXTI_InitStruct.Mode = LL_EXTI_MODE_IT;
+  EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_RISING_FALLING;
+  LL_EXTI_Init(&EXTI_InitStruct);
+
+  /**/
+  LL_GPIO_SetPinPull(ADXL_INT1_GPIO_Port, ADXL_INT1_Pin, LL_GPIO_PULL_UP);
+
+  /**/
+  LL_GPIO_SetPinPull(ZERO_BUTTON_GPIO_Port, ZERO_BUTTON_Pin, LL_GPIO_PULL_UP);
+
+  /**/
+  LL_GPIO_SetPinPull(HOLD_BUTTON_GPIO_Port, HOLD_BUTTON_Pin, LL_GPIO_PULL_UP);
+
+  /**/
+  LL_GPIO_SetPinMode(ADXL_INT1_GPIO_Port, ADXL_INT1_Pin, LL_GPIO_MODE_INPUT);
+
+  /**/
+  LL_GPIO_SetPinMode(ZERO_BUTTON_GPIO_Port, ZERO_BUTTON_Pin, LL_GPIO_MODE_INPUT);
+
+  /**/
+  LL_GPIO_SetPinMode(HOLD_BUTTON_GPIO_Port, HOLD_BUTTON_Pin, LL_GPIO_MODE_INPUT);
+
+  /* EXTI interrupt init*/
+  NVIC_SetPriority(EXTI0_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(),0, 0));
+  NVIC_EnableIRQ(EXTI0_IRQn);
+  NVIC_SetPriority(EXTI15_10_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(),0, 0));
+  NVIC_EnableIRQ(EXTI15_10_IRQn);
+
 /* USER CODE BEGIN MX_GPIO_Init_2 */
 /* USER CODE END MX_GPIO_Init_2 */
 }
 
 /* USER CODE BEGIN 4 */
+/**
+ * @brief Suspend the peripherals and put the MCU in Stop mode until a motion or a button press
+ * @details The IWDG cannot be stopped : its prescaler is raised while sleeping,
+ *          and the RTC alarm wakes the MCU up periodically to reload it.
+ *          Both are clocked by the LSI, so their ratio holds whatever its accuracy.
+ * @note SysTick timers are frozen while in Stop mode, each module restarts its own when resuming
+ *
+ * @retval 0 A peripheral is busy, nothing done
+ * @retval 1 MCU went to sleep and woke up
+ */
+static uint8_t sleepUntilWokenUp(){
+  //suspend the screen, then the accelerometer (exit if any busy)
+  if(isError(SSD1306suspend()))
+    return 0;
+
+  if(isError(ADXL345suspend())){
+    SSD1306resume();
+    return 0;
+  }
+
+  //sleep until the ADXL signals an activity (latched on INT1) or a button is pressed
+  setWatchdogPrescaler(IWDG_PRESCALER_STOP);
+  do{
+    LL_IWDG_ReloadCounter(IWDG);
+    setRTCalarm(STOP_WAKEUP_PERIOD_S);
+
+    LL_PWR_SetPowerMode(LL_PWR_MODE_STOP_LPREGU);
+    LL_LPM_EnableDeepSleep();
+    __WFI();
+    LL_LPM_EnableSleep();
+  }while(LL_GPIO_IsInputPinSet(ADXL_INT1_GPIO_Port, ADXL_INT1_Pin) && !isAnyButtonDown());
+
+  //restore the clocks (HSI is selected when waking up from Stop mode) and the watchdog timeout
+  SystemClock_Config();
+  setWatchdogPrescaler(IWDG_PRESCALER_RUN);
+
+  //resume the peripherals
+  buttonsResume();
+  ADXL345resume();
+  SSD1306resume();
+  schedulerRealign();
+  return 1;
+}
+
+/**
+ * @brief Change the watchdog prescaler (its reload value remains unchanged)
+ *
+ * @param prescaler New prescaler
+ */
+static void setWatchdogPrescaler(uint32_t prescaler){
+  LL_IWDG_EnableWriteAccess(IWDG);
+  LL_IWDG_SetPrescaler(IWDG, prescaler);
+  while (LL_IWDG_IsReady(IWDG) != 1)
+  {
+  }
+
+  LL_IWDG_ReloadCounter(IWDG);
+}
+
+/**
+ * @brief Set the RTC alarm to fire after a number of seconds
+ *
+ * @param seconds Number of seconds before the alarm
+ */
+static void setRTCalarm(uint32_t seconds){
+  //make sure the RTC registers are synchronised (APB1 clock stopped in Stop mode)
+  LL_RTC_WaitForSynchro(RTC);
+  LL_RTC_ClearFlag_ALR(RTC);
+  LL_EXTI_ClearFlag_0_31(LL_EXTI_LINE_17);
+
+  LL_RTC_EnterInitMode(RTC);
+  LL_RTC_ALARM_Set(RTC, LL_RTC_TIME_Get(RTC) + seconds);
+  LL_RTC_ExitInitMode(RTC);
+}
+
+/**
+ * @brief Persist the ADXL calibration and zeroing in flash
+ * @note Nothing is written if the calibration did not change since the latest record
+ * @note A page erase stalls the CPU for tens of milliseconds, which is not counted as a tasks overrun
+ */
+static void saveCalibration(){
+  EEPROMwrite(ADXL345getCalibration(), sizeof(adxlCalibration_t));
+  schedulerRealign();
+}
+
+/**
+ * @brief Get an angle of a snapshot in the unit to print
+ *
+ * @param snapshot  Snapshot from which get the angle
+ * @param axis      Rotation axis of the angle
+ * @param unit      Unit in which get the angle
+ * @return Angle in tenths of the unit
+ */
+static int16_t getMeasureTenths(const adxlSnapshot_t* snapshot, rotationAxis_e axis, measureUnit_e unit){
+  int16_t grade = (axis == ROLL ? snapshot->rollGradeTenths : snapshot->pitchGradeTenths);
+
+  switch(unit){
+    case UNIT_PERCENT:
+      return (grade);
+
+    case UNIT_TOPO:
+      return ((int16_t)(((int32_t)grade * TOPO_PER_PERCENT) / 100));
+
+    case UNIT_DEGREES:
+    case NB_UNITS:
+    default:
+      return (axis == ROLL ? snapshot->rollTenths : snapshot->pitchTenths);
+  }
+}
+
+/**
+ * @brief Print the statistics recorded in the history next to the graphs
+ */
+static void printGraphStats(){
+  const historyStats_t* stats = historyGetStats(HISTORY_ROLL);
+  SSD1306_printGraphStats(ROLL, stats->minimum, stats->maximum);
+
+  stats = historyGetStats(HISTORY_PITCH);
+  SSD1306_printGraphStats(PITCH, stats->minimum, stats->maximum);
+}
+
+/**
+ * @brief Run the accelerometer state machine, and signal the application when a new snapshot is published
+ *
+ * @return Return code of the state machine
+ */
+static errorCode_u accelerometerTask(){
+  uint32_t sequence = ADXL345getSnapshot()->sequence;
+  errorCode_u result = ADXL345update();
+
+  if(ADXL345getSnapshot()->sequence != sequence)
+    schedulerSignal(TASK_APPLICATION);
+
+  return (result);
+}
+
+/**
+ * @brief Run the buttons state machines
+ *
+ * @return Success
+ */
+static errorCode_u buttonsTask(){
+  //keep polling only while a button is busy, the next edge signals the task otherwise
+  schedulerSetPeriod(TASK_BUTTONS, (buttonsUpdate() ? BUTTONS_PERIOD_MS : 0));
+  return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Handle the buttons actions and print the latest measurements
+ *
+ * @return Success
+ */
+static errorCode_u applicationTask(){
+  const adxlSnapshot_t* measurements;
+  historySpan_t span;
+  int16_t measure;
+
+  //once the screen is ready, print the referential restored at start-up
+  if(!referentialPrinted && isScreenReady()){
+    SSD1306_printReferentialIcon(ADXL345isZeroed() ? RELATIVE : ABSOLUTE);
+    referentialPrinted = 1;
+  }
+
+  //if zero button is pressed, zero down measurements
+  if(buttonHasRisingEdge(ZERO)){
+    ADXLzeroDown();
+    SSD1306_printReferentialIcon(RELATIVE);
+    saveCalibration();
+    historyReset();
+  }
+
+  //if both buttons are held down, calibrate the hardware offsets with the device lying flat
+  //  otherwise, if zero button is held down, get back to absolute measurements
+  if(isButtonHeldDown(ZERO) && isButtonHeldDown(HOLD)){
+    if(!calibrated && !isError(ADXL345calibrateFlat())){
+      calibrated = 1;
+      holdingValues = 0;
+      SSD1306_printHoldIcon(holdingValues);
+      SSD1306_printReferentialIcon(ABSOLUTE);
+      saveCalibration();
+      historyReset();
+    }
+  }
+  else if(isButtonHeldDown(ZERO)){
+    if(ADXL345isZeroed())
+      historyReset();
+    ADXLcancelZeroing();
+    SSD1306_printReferentialIcon(ABSOLUTE);
+    saveCalibration();
+  }
+  else
+    calibrated = 0;
+
+  switch(buttonPopGesture(HOLD)){
+    //if hold button is clicked, toggle the hold function
+    case GESTURE_CLICK:
+      holdingValues = !holdingValues;
+      SSD1306_printHoldIcon(holdingValues);
+      break;
+
+    //if hold button is double-clicked, switch to the next measurement profile
+    case GESTURE_DOUBLE_CLICK:
+      ADXL345setProfile((adxlProfile_e)((ADXL345getProfile() + 1U) % ADXL_NB_PROFILES));
+      break;
+
+    //if hold button is held down alone, switch to the next unit
+    //  after the last unit comes the graphs view, then the angles in degrees again
+    case GESTURE_LONG_PRESS:
+      if(!isButtonReleased(ZERO))
+        break;
+
+      if(graphsView){
+        graphsView = 0;
+        spansToReplay = 0;
+        unit = UNIT_DEGREES;
+        SSD1306drawBaseScreen();
+        SSD1306_printReferentialIcon(ADXL345isZeroed() ? RELATIVE : ABSOLUTE);
+        SSD1306_printHoldIcon(holdingValues);
+      }
+      else if(unit == (NB_UNITS - 1U)){
+        //replay the latest spans recorded (leaving the sweep gap blank), then keep plotting the new ones
+        graphsView = 1;
+        SSD1306drawGraphScreen();
+        printGraphStats();
+        spansToReplay = historyCount();
+        if(spansToReplay > (SSD1306_GRAPH_NB_COLUMNS - 1U))
+          spansToReplay = (SSD1306_GRAPH_NB_COLUMNS - 1U);
+      }
+      else
+        unit = (measureUnit_e)(unit + 1U);
+
+      displayedRoll = INT16_MAX;
+      displayedPitch = INT16_MAX;
+      displayedSettled = UINT8_MAX;
+      break;
+
+    case GESTURE_NONE:
+    default:
+      break;
+  }
+
+  //record each new snapshot in the history, and plot its envelope once per graph column period
+  measurements = ADXL345getSnapshot();
+  if(measurements->sequence != lastSequence){
+    lastSequence = measurements->sequence;
+    historyAdd((const int16_t[HISTORY_NB_AXIS]){measurements->rollTenths, measurements->pitchTenths});
+
+    if((measurements->timestamp_ms - graphColumnStart_ms) >= GRAPH_COLUMN_MS){
+      graphColumnStart_ms = measurements->timestamp_ms;
+      span = historyTakeSpan();
+      if(graphsView && span.nbSamples){
+        //while replaying, the new span is plotted by the replay, after the older ones
+        if(spansToReplay){
+          if(spansToReplay < (SSD1306_GRAPH_NB_COLUMNS - 1U))
+            spansToReplay++;
+        }
+        else if(!holdingValues){
+          SSD1306_printGraphColumn(ROLL, span.minimum[HISTORY_ROLL], span.maximum[HISTORY_ROLL]);
+          SSD1306_printGraphColumn(PITCH, span.minimum[HISTORY_PITCH], span.maximum[HISTORY_PITCH]);
+          printGraphStats();
+        }
+      }
+    }
+  }
+
+  //replay the history a few columns at a time, once the screen flushed the previous ones (the drawing queue is short)
+  if(graphsView && spansToReplay && !holdingValues && isScreenReady()){
+    for(uint8_t i = 0 ; (i < GRAPH_REPLAY_COLUMNS) && spansToReplay ; i++){
+      spansToReplay--;
+      if(isError(historyGet(spansToReplay, &span))){
+        spansToReplay = 0;
+        break;
+      }
+
+      SSD1306_printGraphColumn(ROLL, span.minimum[HISTORY_ROLL], span.maximum[HISTORY_ROLL]);
+      SSD1306_printGraphColumn(PITCH, span.minimum[HISTORY_PITCH], span.maximum[HISTORY_PITCH]);
+    }
+
+    if(!spansToReplay)
+      printGraphStats();
+  }
+
+  //get the angles computed with the latest measurements (if any)
+  if(graphsView){
+    if(measurements->sequence && !holdingValues)
+      SSD1306_printBubble(measurements->rollTenths, measurements->pitchTenths);
+  }
+  else if(measurements->sequence && !holdingValues){
+    //if roll angle changed, update the screen
+    measure = getMeasureTenths(measurements, ROLL, unit);
+    if(measure != displayedRoll){
+      PROFILE(SSD1306_printMeasureTenths, SSD1306_printMeasureTenths(measure, ROLL, unit));
+      displayedRoll = measure;
+    }
 
+    //if pitch angle changed, update the screen
+    measure = getMeasureTenths(measurements, PITCH, unit);
+    if(measure != displayedPitch){
+      PROFILE(SSD1306_printMeasureTenths, SSD1306_printMeasureTenths(measure, PITCH, unit));
+      displayedPitch = measure;
+    }
+
+    //if the measurements settled or started moving, update the stability icon
+    if(measurements->settled != displayedSettled){
+      SSD1306_printStabilityIcon(measurements->settled);
+      displayedSettled = measurements->settled;
+    }
+  }
+
+  return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Send the oldest events recorded to the telemetry sink
+ *
+ * @return Success
+ */
+static errorCode_u eventsTask(){
+  event_t event;
+
+  for(uint8_t i = 0 ; (i < EVENTS_PER_DRAIN) && eventsPop(&event) ; i++)
+    sendEvent(&event);
+
+  return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Send an event over SWO, as three words (timestamp, type and source, value)
+ * @note Nothing is sent if no debugger enabled the ITM and the port
+ *
+ * @param event Event to send
+ */
+static void sendEvent(const event_t* event){
+  profilerSendWord(EVENTS_ITM_PORT, event->timestamp_ms);
+  profilerSendWord(EVENTS_ITM_PORT, ((uint32_t)event->source << 8) | event->type);
+  profilerSendWord(EVENTS_ITM_PORT, event->value);
+}
+
+#if defined(BENCHMARK)
+/**
+ * @brief Measure the drivers kernels with the DWT cycle counter, then report the metrics and the accuracy verdict over SWO (ITM port 3)
+ * @details The angle kernel accuracy is checked from -89° to +89° by tenths of degrees (against BENCHMARK_ANGLE_TOLERANCE),
+ *          then a simulated tilt sweep is replayed from the raw FIFO entries to the angles rendered in the framebuffer
+ * @note To be run before the drivers are initialised, as it overwrites their filter and framebuffer
+ */
+static void runBenchmark(){
+  static const int16_t ACCURACY_SWEEP_TENTHS = 890;
+  int16_t angles[NB_ROTATIONS];
+
+  profilerInitialise();
+  benchmarkReset();
+
+  for(int16_t tenths = -ACCURACY_SWEEP_TENTHS ; tenths <= ACCURACY_SWEEP_TENTHS ; tenths++){
+    ADXL345benchmarkAccuracy(tenths);
+    LL_IWDG_ReloadCounter(IWDG);
+  }
+
+  for(uint8_t pass = 0 ; pass < BENCHMARK_NB_PASSES ; pass++){
+    for(uint16_t step = 0 ; step < BENCHMARK_NB_STEPS ; step++){
+      ADXL345benchmarkLoad(step);
+
+      uint32_t start = profilerNow();
+      ADXL345benchmarkStep(angles);
+      SSD1306benchmarkRender(angles);
+      benchmarkRecord(BENCH_SAMPLE_TO_PIXEL, profilerNow() - start);
+
+      LL_IWDG_ReloadCounter(IWDG);
+    }
+  }
+
+  benchmarkReport();
+}
+#endif
 /* USER CODE END 4 */
 
 /**
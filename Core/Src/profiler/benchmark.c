@@ -0,0 +1,120 @@
+/**
+ * @file benchmark.c
+ * @brief Implement the statistics of the on-target benchmark, reported over ITM/SWO
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The benchmark image (BENCHMARK defined) replays a simulated tilt sweep through the drivers kernels at start-up,
+ * before the devices are initialised. The drivers record the durations measured with the DWT cycle counter
+ * (see profilerNow()), as well as the deviation of the angle kernel from the libm.
+ *
+ * The report is sent once on the ITM stimulus port BENCHMARK_ITM_PORT, as 32 bits words,
+ * so that the numbers can be compared across commits (nothing is sent if no debugger enabled the port) :
+ *   - report start : BENCHMARK_REPORT_TAG, number of metrics
+ *   - each metric (in the benchmarkMetric_e order) : number of values, min., max., mean
+ *   - report end : verdict (1 if the angle kernel stayed within BENCHMARK_ANGLE_TOLERANCE, 0 otherwise)
+ *
+ * The same drivers are built for the host by tests/host, which replays the telemetry traces as well.
+ */
+#include "benchmark.h"
+#include "profiler.h"
+
+//definitions
+#define BENCHMARK_ITM_PORT		3U			///< ITM stimulus port on which the report is sent
+#define BENCHMARK_REPORT_TAG	0x30434E42U	///< First word of a report ("BNC0")
+
+//tool functions
+static inline void sendWord(uint32_t word);
+
+//state variables
+static benchmarkResult_t	_results[NB_BENCH_METRICS];	///< Statistics of each metric
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Clear the statistics of all the metrics
+ */
+void benchmarkReset(){
+    for(uint8_t metric = 0 ; metric < NB_BENCH_METRICS ; metric++)
+        _results[metric] = (benchmarkResult_t){.minimum = UINT32_MAX};
+}
+
+/**
+ * @brief Record a value in the statistics of a metric
+ *
+ * @param metric	Metric measured
+ * @param value		Value measured
+ */
+void benchmarkRecord(benchmarkMetric_e metric, uint32_t value){
+    if(metric >= NB_BENCH_METRICS)
+        return;
+
+    benchmarkResult_t* result = &_results[metric];
+    result->nbSamples++;
+    result->total += value;
+    if(value < result->minimum)
+        result->minimum = value;
+    if(value > result->maximum)
+        result->maximum = value;
+}
+
+/**
+ * @brief Get the statistics of a metric
+ *
+ * @param metric Metric of which get the statistics
+ * @return Statistics (minimum is UINT32_MAX until a value is recorded)
+ */
+const benchmarkResult_t* benchmarkGetResult(benchmarkMetric_e metric){
+    if(metric >= NB_BENCH_METRICS)
+        metric = BENCH_INTEGRATE_FIFO;
+
+    return (&_results[metric]);
+}
+
+/**
+ * @brief Check if the angle kernel stayed within the accuracy tolerance
+ *
+ * @retval 0 No deviation recorded, or highest deviation above BENCHMARK_ANGLE_TOLERANCE
+ * @retval 1 Highest deviation within BENCHMARK_ANGLE_TOLERANCE
+ */
+uint8_t benchmarkPassed(){
+    const benchmarkResult_t* result = &_results[BENCH_ANGLE_ERROR];
+    return (result->nbSamples && (result->maximum <= BENCHMARK_ANGLE_TOLERANCE));
+}
+
+/**
+ * @brief Send the statistics of all the metrics over SWO, followed by the accuracy verdict
+ */
+void benchmarkReport(){
+    sendWord(BENCHMARK_REPORT_TAG);
+    sendWord(NB_BENCH_METRICS);
+
+    for(uint8_t metric = 0 ; metric < NB_BENCH_METRICS ; metric++){
+        const benchmarkResult_t* result = &_results[metric];
+
+        sendWord(result->nbSamples);
+        sendWord(result->nbSamples ? result->minimum : 0U);
+        sendWord(result->maximum);
+        sendWord(result->nbSamples ? (uint32_t)(result->total / result->nbSamples) : 0U);
+    }
+
+    sendWord(benchmarkPassed());
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Send a word on the benchmark ITM port
+ *
+ * @param word Word to send
+ */
+static inline void sendWord(uint32_t word){
+    profilerSendWord(BENCHMARK_ITM_PORT, word);
+}
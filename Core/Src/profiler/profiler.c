@@ -0,0 +1,226 @@
+/**
+ * @file profiler.c
+ * @brief Implement the execution time profiling with the DWT cycle counter, reported over ITM/SWO
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The measurements are only compiled in when PROFILING is defined : otherwise, the macros of profiler.h expand to the bare calls.
+ *
+ * Each function profiled gets a probe the first time it is recorded, identified by its address
+ * (the firmware map file gives its name). The states of the state machines are recorded
+ * by the update functions, so each state gets its own probe.
+ *
+ * Once per report period, one record is sent per main loop iteration on the ITM stimulus port PROFILER_ITM_PORT,
+ * as 32 bits words (nothing is sent if no debugger enabled the port) :
+ *   - report start : PROFILER_REPORT_TAG, number of probes used
+ *   - main loop (key 0) : 0, number of iterations, min., max., mean, idle fraction (per mille)
+ *   - each probe : address, number of calls, min., max., mean, then the histogram (2 buckets per word, lowest first)
+ *
+ * The durations include the few cycles of the measurement itself.
+ */
+#include "profiler.h"
+#include "timers.h"
+
+//definitions
+#define PROFILER_ITM_PORT		1U			///< ITM stimulus port on which the reports are sent
+#define PROFILER_REPORT_TAG		0x30465250U	///< First word of a report ("PRF0")
+#define REPORT_PERIOD_MS		1000U		///< Number of milliseconds between two reports
+#define REPORT_IDLE				0xFFU		///< Index of the record to send when no report is in progress
+#define REPORT_LOOP				0xFEU		///< Index of the record of the main loop
+
+//tool functions
+static profilerProbe_t* findProbe(uintptr_t key);
+static inline void sendWord(uint32_t word);
+static void sendRecord();
+
+//state variables
+static profilerProbe_t	_probes[PROFILER_NB_PROBES];	///< Probes of the functions profiled
+static uint8_t			_nbProbes = 0;					///< Number of probes used
+static profilerLoop_t	_loop;							///< Main loop statistics of the current report window
+static uint32_t			_iterationStart = 0;			///< Cycle at which the current main loop iteration started
+static softTimer_t		_reportTimer;					///< Timer used to wait for the next report
+static uint8_t			_nextRecord = REPORT_IDLE;		///< Index of the next record of the report to send
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Start the cycle counter, and keep it running while the core sleeps
+ */
+void profilerInitialise(){
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    _loop = (profilerLoop_t){.minimum = UINT32_MAX};
+    _iterationStart = profilerNow();
+    timerStart(&_reportTimer, REPORT_PERIOD_MS);
+}
+
+/**
+ * @brief Record the duration of a call in the probe of a function
+ * @note Calls are ignored once all the probes are used
+ *
+ * @param key	Address of the function profiled
+ * @param start	Cycle at which the call started
+ */
+void profilerRecord(uintptr_t key, uint32_t start){
+    uint32_t cycles = profilerNow() - start;
+    profilerProbe_t* probe = findProbe(key);
+
+    if(!probe)
+        return;
+
+    uint8_t bucket = (cycles ? (uint8_t)(31U - __CLZ(cycles)) : 0U);
+    if(bucket >= PROFILER_NB_BUCKETS)
+        bucket = PROFILER_NB_BUCKETS - 1U;
+
+    probe->nbCalls++;
+    probe->total += cycles;
+    if(cycles < probe->minimum)
+        probe->minimum = cycles;
+    if(cycles > probe->maximum)
+        probe->maximum = cycles;
+    if(probe->histogram[bucket] < UINT16_MAX)
+        probe->histogram[bucket]++;
+}
+
+/**
+ * @brief Record the cycles spent sleeping
+ *
+ * @param start Cycle at which the core went to sleep
+ */
+void profilerIdle(uint32_t start){
+    _loop.idle += profilerNow() - start;
+}
+
+/**
+ * @brief Record the duration of the main loop iteration which just ended, and send the next record of the report (if any)
+ */
+void profilerLoopIteration(){
+    uint32_t now = profilerNow();
+    uint32_t cycles = now - _iterationStart;
+
+    _iterationStart = now;
+    _loop.nbIterations++;
+    _loop.total += cycles;
+    if(cycles < _loop.minimum)
+        _loop.minimum = cycles;
+    if(cycles > _loop.maximum)
+        _loop.maximum = cycles;
+
+    //if the report period elapsed, start a new report
+    if((_nextRecord == REPORT_IDLE) && !timerIsRunning(&_reportTimer)){
+        timerStart(&_reportTimer, REPORT_PERIOD_MS);
+        sendWord(PROFILER_REPORT_TAG);
+        sendWord(_nbProbes);
+        _nextRecord = REPORT_LOOP;
+    }
+
+    if(_nextRecord != REPORT_IDLE)
+        sendRecord();
+}
+
+/**
+ * @brief Get the probe of a function
+ *
+ * @param key Address of the function
+ * @return Probe (null if the function has never been recorded)
+ */
+const profilerProbe_t* profilerGetProbe(uintptr_t key){
+    for(uint8_t i = 0 ; i < _nbProbes ; i++){
+        if(_probes[i].key == key)
+            return (&_probes[i]);
+    }
+
+    return ((void*)0);
+}
+
+/**
+ * @brief Send a word on an ITM stimulus port
+ * @note Nothing is sent if no debugger enabled the ITM and the port
+ *
+ * @param port	ITM stimulus port
+ * @param word	Word to send
+ */
+void profilerSendWord(uint8_t port, uint32_t word){
+    if(!(ITM->TCR & ITM_TCR_ITMENA_Msk) || !(ITM->TER & (1UL << port)))
+        return;
+
+    //wait for the stimulus port FIFO to accept a word
+    while(!ITM->PORT[port].u32);
+    ITM->PORT[port].u32 = word;
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Find the probe of a function, or assign it a free one
+ *
+ * @param key Address of the function
+ * @return Probe (null if none left)
+ */
+static profilerProbe_t* findProbe(uintptr_t key){
+    profilerProbe_t* probe = (profilerProbe_t*)profilerGetProbe(key);
+
+    if(probe || (_nbProbes >= PROFILER_NB_PROBES))
+        return (probe);
+
+    probe = &_probes[_nbProbes++];
+    *probe = (profilerProbe_t){.key = key, .minimum = UINT32_MAX};
+    return (probe);
+}
+
+/**
+ * @brief Send a word on the profiler ITM port
+ *
+ * @param word Word to send
+ */
+static inline void sendWord(uint32_t word){
+    profilerSendWord(PROFILER_ITM_PORT, word);
+}
+
+/**
+ * @brief Send the next record of the report in progress
+ * @details The main loop record is sent first (then its window restarts), followed by the probes
+ */
+static void sendRecord(){
+    const profilerProbe_t* probe;
+
+    if(_nextRecord == REPORT_LOOP){
+        uint32_t mean = (_loop.nbIterations ? (uint32_t)(_loop.total / _loop.nbIterations) : 0U);
+        uint32_t idlePerMille = (_loop.total ? (uint32_t)((_loop.idle * 1000U) / _loop.total) : 0U);
+
+        sendWord(0);
+        sendWord(_loop.nbIterations);
+        sendWord(_loop.minimum);
+        sendWord(_loop.maximum);
+        sendWord(mean);
+        sendWord(idlePerMille);
+
+        _loop = (profilerLoop_t){.minimum = UINT32_MAX};
+        _nextRecord = 0;
+        return;
+    }
+
+    if(_nextRecord >= _nbProbes){
+        _nextRecord = REPORT_IDLE;
+        return;
+    }
+
+    probe = &_probes[_nextRecord++];
+    sendWord((uint32_t)probe->key);
+    sendWord(probe->nbCalls);
+    sendWord(probe->minimum);
+    sendWord(probe->maximum);
+    sendWord(probe->nbCalls ? (uint32_t)(probe->total / probe->nbCalls) : 0U);
+    for(uint8_t bucket = 0 ; bucket < PROFILER_NB_BUCKETS ; bucket += 2U)
+        sendWord((uint32_t)probe->histogram[bucket] | ((uint32_t)probe->histogram[bucket + 1U] << 16));
+}
@@ -0,0 +1,230 @@
+/**
+ * @file scheduler.c
+ * @brief Implement a static cooperative scheduler running the tasks when due or signaled
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * Each task is run either periodically, when signaled (e.g. from an interrupt handler), or both.
+ * A pass of the scheduler only runs the most urgent task due, so that a task of high priority
+ * is never delayed by more than the longest run of another task.
+ *
+ * A run pushes the next periodic deadline of the task back, so a task signaled often is not polled in vain.
+ * A periodic run started a whole period (or more) after it was due is counted as an overrun.
+ *
+ * Errors returned by the tasks and overruns are also pushed in the events ring, the task ID being used as module ID.
+ */
+#include <main.h>
+#include "scheduler.h"
+#include "events.h"
+
+/**
+ * @brief Enumeration of the function IDs of the scheduler
+ */
+typedef enum _schedulerFunctionCodes_e{
+    REGISTER = 0,	///< schedulerRegister()
+}schedulerFunctionCodes_e;
+
+/**
+ * @brief Structure defining a task registered in the scheduler
+ */
+typedef struct{
+    taskFunction	function;		///< Function run (null if the task is not registered)
+    uint16_t		period_ms;		///< Number of milliseconds between two periodic runs (0 if only run when signaled)
+    uint32_t		nextDue_ms;		///< System tick at which the next periodic run is due
+    taskStats_t		stats;			///< Statistics of the task
+}task_t;
+
+//tool functions
+static uint8_t isDue(taskID_e task, uint32_t now);
+static void runTask(taskID_e task, uint32_t now);
+
+//state variables
+static task_t			_tasks[NB_TASKS];	///< Tasks registered, by decreasing priority
+static volatile uint8_t	_signals[NB_TASKS];	///< Flags set when a task must be run regardless of its period
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Register the function run by a task
+ * @note The first run of a periodic task is due right away
+ *
+ * @param task		Task to register
+ * @param function	Function to run
+ * @param period_ms	Number of milliseconds between two runs (0 to only run the task when signaled)
+ * @return Success
+ * @retval 1	Unknown task
+ * @retval 2	Function null
+ */
+errorCode_u schedulerRegister(taskID_e task, taskFunction function, uint16_t period_ms){
+    if(task >= NB_TASKS)
+        return (createErrorCode(REGISTER, 1, ERR_WARNING));
+
+    if(!function)
+        return (createErrorCode(REGISTER, 2, ERR_WARNING));
+
+    _tasks[task] = (task_t){
+        .function = function,
+        .period_ms = period_ms,
+        .nextDue_ms = systemTick_ms,
+        .stats = {.lastError = ERR_SUCCESS},
+    };
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Request a task to be run as soon as possible
+ * @note Can be called from an interrupt handler
+ *
+ * @param task Task to signal
+ */
+void schedulerSignal(taskID_e task){
+    if(task < NB_TASKS)
+        _signals[task] = 1;
+}
+
+/**
+ * @brief Change the period of a task
+ * @note Can be called by the task itself, the next periodic run is then due a period after the call
+ *
+ * @param task		Task of which change the period
+ * @param period_ms	Number of milliseconds between two runs (0 to only run the task when signaled)
+ */
+void schedulerSetPeriod(taskID_e task, uint16_t period_ms){
+    if(task >= NB_TASKS)
+        return;
+
+    _tasks[task].period_ms = period_ms;
+    _tasks[task].nextDue_ms = systemTick_ms + period_ms;
+}
+
+/**
+ * @brief Make the periodic runs of all the tasks due right away, without counting them as overruns
+ * @note To be called after a deliberately blocking operation (e.g. a flash page erase, or a wake-up from Stop mode)
+ */
+void schedulerRealign(){
+    uint32_t now = systemTick_ms;
+
+    for(uint8_t task = 0 ; task < NB_TASKS ; task++)
+        _tasks[task].nextDue_ms = now;
+}
+
+/**
+ * @brief Run the most urgent task due (if any)
+ *
+ * @retval 0 No task due
+ * @retval 1 A task has been run
+ */
+uint8_t schedulerRun(){
+    uint32_t now = systemTick_ms;
+
+    for(uint8_t task = 0 ; task < NB_TASKS ; task++){
+        if(isDue(task, now)){
+            runTask(task, now);
+            return (1);
+        }
+    }
+
+    return (0);
+}
+
+/**
+ * @brief Sleep until the next interrupt, unless a task is due
+ * @details Interrupts are masked while checking the tasks, so that a signal raised right after the check
+ *          still wakes the core up (WFI returns on any pending interrupt, even masked)
+ */
+void schedulerIdle(){
+    uint32_t now;
+    uint8_t due = 0;
+
+    __disable_irq();
+    now = systemTick_ms;
+    for(uint8_t task = 0 ; (task < NB_TASKS) && !due ; task++)
+        due = isDue(task, now);
+
+    if(!due)
+        __WFI();
+    __enable_irq();
+}
+
+/**
+ * @brief Get the statistics of a task
+ *
+ * @param task Task of which get the statistics
+ * @return Statistics since start-up
+ */
+const taskStats_t* schedulerGetStats(taskID_e task){
+    if(task >= NB_TASKS)
+        task = TASK_ACCELEROMETER;
+
+    return (&_tasks[task].stats);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Check if a task must be run
+ *
+ * @param task	Task to check
+ * @param now	Current system tick
+ * @retval 0 Task not registered, or not due yet
+ * @retval 1 Task signaled, or its period elapsed
+ */
+static uint8_t isDue(taskID_e task, uint32_t now){
+    if(!_tasks[task].function)
+        return (0);
+
+    if(_signals[task])
+        return (1);
+
+    return (_tasks[task].period_ms && ((int32_t)(now - _tasks[task].nextDue_ms) >= 0));
+}
+
+/**
+ * @brief Run a task, then update its deadline and its statistics
+ *
+ * @param task	Task to run
+ * @param now	Current system tick
+ */
+static void runTask(taskID_e task, uint32_t now){
+    task_t* current = &_tasks[task];
+    uint32_t lateness = now - current->nextDue_ms;
+
+    //clear the signal first, so that one raised during the run triggers another one
+    _signals[task] = 0;
+
+    //if the periodic run is due, keep the phase unless late by a whole period
+    //	otherwise (signaled before the deadline), push the deadline back
+    if(current->period_ms && ((int32_t)lateness >= 0)){
+        if(lateness > current->stats.maxLateness_ms)
+            current->stats.maxLateness_ms = (uint16_t)(lateness > UINT16_MAX ? UINT16_MAX : lateness);
+
+        if(lateness >= current->period_ms){
+            current->stats.nbOverruns++;
+            eventsPush(EVENT_TASK_OVERRUN, (uint8_t)task, lateness);
+            current->nextDue_ms = now + current->period_ms;
+        }
+        else
+            current->nextDue_ms += current->period_ms;
+    }
+    else
+        current->nextDue_ms = now + current->period_ms;
+
+    errorCode_u result = (*current->function)();
+    uint32_t duration = systemTick_ms - now;
+
+    current->stats.nbRuns++;
+    if(duration > current->stats.maxDuration_ms)
+        current->stats.maxDuration_ms = (uint16_t)(duration > UINT16_MAX ? UINT16_MAX : duration);
+    if(isError(result)){
+        result.fields.moduleID = (task & 0x7FU);
+        current->stats.lastError = result;
+        eventsPush(EVENT_ERROR, (uint8_t)task, result.dword);
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file timers.c
+ * @brief Implement software timers computed on demand from the system tick
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The SysTick interrupt only increments the system tick. Each timer stores the tick at which it has been started,
+ * and whether it is elapsed is computed when checked, so that adding timers costs nothing at interrupt time.
+ *
+ * The elapsed time is computed with unsigned arithmetic, which stays correct when the tick wraps around.
+ * A timer found elapsed is stopped, so that it does not appear running again once the tick wraps around (about 49 days).
+ */
+#include <main.h>
+#include "timers.h"
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Start (or restart) a timer
+ *
+ * @param timer			Timer to start
+ * @param duration_ms	Number of milliseconds after which the timer expires
+ */
+void timerStart(softTimer_t* timer, uint16_t duration_ms){
+    timer->start_ms = systemTick_ms;
+    timer->duration_ms = duration_ms;
+}
+
+/**
+ * @brief Stop a timer, making it elapsed right away
+ *
+ * @param timer Timer to stop
+ */
+void timerStop(softTimer_t* timer){
+    timer->duration_ms = 0;
+}
+
+/**
+ * @brief Check if a timer is still running
+ *
+ * @param timer Timer to check
+ * @retval 0 Timer elapsed (or stopped)
+ * @retval 1 Timer running
+ */
+uint8_t timerIsRunning(softTimer_t* timer){
+    if(!timer->duration_ms)
+        return (0);
+
+    if((systemTick_ms - timer->start_ms) < timer->duration_ms)
+        return (1);
+
+    timer->duration_ms = 0;
+    return (0);
+}
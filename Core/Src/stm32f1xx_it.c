@@ -23,7 +23,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "ADXL345.h"
-#include "SSD1306.h"
+#include "spiBus.h"
+#include "scheduler.h"
 #include "buttons.h"
 /* USER CODE END Includes */
 
@@ -183,34 +184,11 @@ void PendSV_Handler(void)
 /**
   * @brief This function handles System tick timer.
   */
-void SysTick_Handler(void)
+RAMFUNC void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-	if(adxlTimer_ms)
-		adxlTimer_ms = adxlTimer_ms - 1;
-
-  if(adxlSPITimer_ms)
-    adxlSPITimer_ms = adxlSPITimer_ms - 1;
-
-	if(screenTimer_ms)
-		screenTimer_ms = screenTimer_ms - 1;
-
-  if(ssd1306SPITimer_ms)
-    ssd1306SPITimer_ms = ssd1306SPITimer_ms - 1;
-
-  for(uint8_t i = 0 ; i < NB_BUTTONS ; i++){
-    if(buttonsTimers[i].debouncing_ms)
-      buttonsTimers[i].debouncing_ms = buttonsTimers[i].debouncing_ms - 1;
-
-    if(buttonsTimers[i].holding_ms)
-      buttonsTimers[i].holding_ms = buttonsTimers[i].holding_ms - 1;
-
-    if(buttonsTimers[i].risingEdge_ms)
-      buttonsTimers[i].risingEdge_ms = buttonsTimers[i].risingEdge_ms - 1;
-
-    if(buttonsTimers[i].fallingEdge_ms)
-      buttonsTimers[i].fallingEdge_ms = buttonsTimers[i].fallingEdge_ms - 1;
-  }
+  //software timers are computed from the system tick when checked
+  systemTick_ms++;
   /* USER CODE END SysTick_IRQn 0 */
   /* USER CODE BEGIN SysTick_IRQn 1 */
 
@@ -224,6 +202,112 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32f1xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles EXTI line0 interrupt.
+  */
+void EXTI0_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI0_IRQn 0 */
+
+  /* USER CODE END EXTI0_IRQn 0 */
+  if (LL_EXTI_IsActiveFlag_0_31(LL_EXTI_LINE_0) != RESET)
+  {
+    LL_EXTI_ClearFlag_0_31(LL_EXTI_LINE_0);
+    /* USER CODE BEGIN LL_EXTI_LINE_0 */
+    ADXL345watermarkInterrupt();
+    schedulerSignal(TASK_ACCELEROMETER);
+    /* USER CODE END LL_EXTI_LINE_0 */
+  }
+  /* USER CODE BEGIN EXTI0_IRQn 1 */
+
+  /* USER CODE END EXTI0_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA1 channel2 global interrupt.
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel2_IRQn 0 */
+  spiBusInterrupt(SPI_BUS_1);
+  schedulerSignal(TASK_ACCELEROMETER);
+  /* USER CODE END DMA1_Channel2_IRQn 0 */
+  /* USER CODE BEGIN DMA1_Channel2_IRQn 1 */
+
+  /* USER CODE END DMA1_Channel2_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA1 channel5 global interrupt.
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel5_IRQn 0 */
+  spiBusInterrupt(SPI_BUS_2);
+  schedulerSignal(TASK_SCREEN);
+  /* USER CODE END DMA1_Channel5_IRQn 0 */
+  /* USER CODE BEGIN DMA1_Channel5_IRQn 1 */
+
+  /* USER CODE END DMA1_Channel5_IRQn 1 */
+}
+
+/**
+  * @brief This function handles TIM2 global interrupt.
+  */
+void TIM2_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM2_IRQn 0 */
+  ADXL345timerInterrupt();
+  /* USER CODE END TIM2_IRQn 0 */
+  /* USER CODE BEGIN TIM2_IRQn 1 */
+
+  /* USER CODE END TIM2_IRQn 1 */
+}
+
+/**
+  * @brief This function handles RTC alarm interrupt through EXTI line 17.
+  */
+void RTC_Alarm_IRQHandler(void)
+{
+  /* USER CODE BEGIN RTC_Alarm_IRQn 0 */
+  //only used to wake the MCU up from Stop mode to reload the watchdog
+  LL_RTC_ClearFlag_ALR(RTC);
+  LL_EXTI_ClearFlag_0_31(LL_EXTI_LINE_17);
+  /* USER CODE END RTC_Alarm_IRQn 0 */
+  /* USER CODE BEGIN RTC_Alarm_IRQn 1 */
+
+  /* USER CODE END RTC_Alarm_IRQn 1 */
+}
+
+/**
+  * @brief This function handles EXTI line[15:10] interrupts.
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI15_10_IRQn 0 */
+  //timestamp the buttons edges (flags cleared), then get their state machines run (also wakes the MCU up from Stop mode)
+  buttonsInterrupt();
+  schedulerSignal(TASK_BUTTONS);
+  /* USER CODE END EXTI15_10_IRQn 0 */
+  if (LL_EXTI_IsActiveFlag_0_31(LL_EXTI_LINE_10) != RESET)
+  {
+    LL_EXTI_ClearFlag_0_31(LL_EXTI_LINE_10);
+    /* USER CODE BEGIN LL_EXTI_LINE_10 */
+
+    /* USER CODE END LL_EXTI_LINE_10 */
+  }
+  if (LL_EXTI_IsActiveFlag_0_31(LL_EXTI_LINE_11) != RESET)
+  {
+    LL_EXTI_ClearFlag_0_31(LL_EXTI_LINE_11);
+    /* USER CODE BEGIN LL_EXTI_LINE_11 */
+
+    /* USER CODE END LL_EXTI_LINE_11 */
+  }
+  /* USER CODE BEGIN EXTI15_10_IRQn 1 */
+
+  /* USER CODE END EXTI15_10_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
 
 /* USER CODE END 1 */
@@ -0,0 +1,495 @@
+/**
+ * @file eeprom.c
+ * @brief Implement a crude EEPROM emulation in the last two pages of the flash memory
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * Records are appended one after the other in the active page, the last valid one being the current value.
+ * When the active page is full, the new record is written in the other page, which then becomes the active one.
+ * This spreads the erase cycles between both pages, and a power loss only loses the record being written.
+ *
+ * As in AN2594, a page swap goes through the following steps, so that a reset at any point can be recovered from at start-up :
+ *   1. the new page is marked as receiving, and the record is written in it
+ *   2. the old page is erased
+ *   3. the new page is marked as valid
+ *
+ * Page layout (in half-words) : | status | record 0 | record 1 | ... | 0xFFFF (erased) |
+ * Record layout (in half-words) : | tag (0xEE00 + nb. of data half-words) | data... | checksum |
+ *
+ * @note Both pages are kept out of the firmware image by the linker script (STM32F103C8TX_FLASH.ld)
+ * @note Flash programming stalls the CPU fetches (page erase lasts up to 40ms)
+ *
+ * @note Additional information can be found in :
+ *   - PM0075 (STM32F10xxx Flash memory programming manual) : https://www.st.com/resource/en/programming_manual/pm0075-stm32f10xxx-flash-memory-microcontrollers-stmicroelectronics.pdf
+ *   - AN2594 (EEPROM emulation in STM32F10x microcontrollers) : https://www.st.com/resource/en/application_note/an2594-eeprom-emulation-in-stm32f10x-microcontrollers-stmicroelectronics.pdf
+ */
+#include "eeprom.h"
+#include "timers.h"
+#include <assert.h>
+
+//definitions
+#define EEPROM_PAGE_SIZE	0x400U			///< Size of a flash page (in bytes)
+#define EEPROM_PAGE0		0x0800F800U		///< Address of the first page used (second to last page of the 64k flash)
+#define EEPROM_PAGE1		(EEPROM_PAGE0 + EEPROM_PAGE_SIZE)	///< Address of the second page used (last page of the 64k flash)
+#define NB_PAGES			2U				///< Number of flash pages used
+#define PAGE_NB_HALFWORDS	(EEPROM_PAGE_SIZE >> 1)				///< Number of half-words in a flash page
+#define FLASH_TIMEOUT_MS	50U				///< Maximum number of milliseconds a flash operation should last
+#define PAGE_RECEIVING		0xEEEEU			///< Status of a page being filled with the latest record
+#define PAGE_VALID			0x0000U			///< Status of the active page
+#define ERASED_HALFWORD		0xFFFFU			///< Value of an erased flash half-word
+#define RECORD_TAG			0xEE00U			///< Tag marking the beginning of a record
+#define RECORD_TAG_MASK		0xFF00U			///< Mask used to retrieve the tag of a record
+#define UNLOCK_KEY1			0x45670123U		///< First key to write to unlock the flash programming
+#define UNLOCK_KEY2			0xCDEF89ABU		///< Second key to write to unlock the flash programming
+
+//static assertions (ran at compile time)
+_Static_assert(((EEPROM_MAX_RECORD_SIZE + 1U) >> 1) < (uint16_t)~RECORD_TAG_MASK, "EEPROM_MAX_RECORD_SIZE does not fit in a record tag");
+
+/**
+ * @brief Enumeration of the function IDs of the EEPROM emulation
+ */
+typedef enum _EEPROMfunctionCodes_e{
+    INIT = 0,			///< EEPROMinitialise()
+    READ,				///< EEPROMread()
+    WRITE,				///< EEPROMwrite()
+    ERASE_PAGE,			///< erasePage()
+    PROGRAM,			///< programHalfword()
+    PROGRAM_RECORD,		///< programRecord()
+    SWAP_PAGES,			///< swapPages()
+    WAIT_FLASH			///< waitForFlash()
+}EEPROMfunctionCodes_e;
+
+//flash manipulation functions
+static errorCode_u erasePage(uint8_t page);
+static errorCode_u programHalfword(volatile uint16_t* address, uint16_t value);
+static errorCode_u programRecord(volatile uint16_t* address, const uint8_t data[], uint8_t size);
+static errorCode_u swapPages(const uint8_t data[], uint8_t size);
+static errorCode_u waitForFlash();
+static inline void unlockFlash();
+static inline void lockFlash();
+
+//tool functions
+static void scanActivePage();
+static uint8_t isPageErased(uint8_t page);
+static uint8_t isRecordIdentical(const uint8_t data[], uint8_t size);
+static uint16_t recordChecksum(const volatile uint16_t* record);
+static inline uint16_t dataHalfword(const uint8_t data[], uint8_t size, uint8_t index);
+
+//state variables
+static volatile uint16_t* const PAGES[NB_PAGES] = {(volatile uint16_t*)EEPROM_PAGE0, (volatile uint16_t*)EEPROM_PAGE1};	///< Flash pages used
+static softTimer_t				_timer;						///< Timer used to make sure flash operations do not time out
+static uint8_t					_activePage = 0;			///< Index of the page in which the records are appended
+static volatile uint16_t*		_latestRecord = (void*)0;	///< Latest valid record in the active page (null if none)
+static volatile uint16_t*		_nextFree = (void*)0;		///< First erased half-word in the active page
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Initialise the EEPROM emulation and recover from an interrupted page swap
+ *
+ * @return Success
+ * @retval 1	Error while formatting the first page
+ * @retval 2	Error while erasing the inactive page
+ * @retval 3	Error while promoting the receiving page
+ */
+errorCode_u EEPROMinitialise(){
+    errorCode_u result;
+
+    //get the valid page
+    //	(if the other one is receiving, the swap has been interrupted before erasing the old page : the record being written is dropped)
+    if(*PAGES[0] == PAGE_VALID)
+        _activePage = 0;
+    else if(*PAGES[1] == PAGE_VALID)
+        _activePage = 1;
+    else if((*PAGES[0] == PAGE_RECEIVING) || (*PAGES[1] == PAGE_RECEIVING)){
+        //if receiving page without a valid one, the swap has been interrupted while erasing the old page
+        //	the receiving page already holds the latest record : finish erasing the old page, then mark the new one as valid
+        _activePage = ((*PAGES[0] == PAGE_RECEIVING) ? 0 : 1);
+
+        unlockFlash();
+        result = ERR_SUCCESS;
+        if(!isPageErased(_activePage ^ 1U))
+            result = erasePage(_activePage ^ 1U);
+        if(!isError(result))
+            result = programHalfword(PAGES[_activePage], PAGE_VALID);
+        lockFlash();
+
+        if(isError(result))
+            return (pushErrorCode(result, INIT, 3));
+    }
+    else{
+        //if no valid page, format the first one
+        unlockFlash();
+        result = erasePage(0);
+        if(!isError(result))
+            result = programHalfword(PAGES[0], PAGE_VALID);
+        lockFlash();
+
+        if(isError(result))
+            return (pushErrorCode(result, INIT, 1));
+        _activePage = 0;
+    }
+
+    //make sure the other page is blank
+    if(!isPageErased(_activePage ^ 1U)){
+        unlockFlash();
+        result = erasePage(_activePage ^ 1U);
+        lockFlash();
+
+        if(isError(result))
+            return (pushErrorCode(result, INIT, 2));
+    }
+
+    scanActivePage();
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Read the latest record written
+ *
+ * @param[out] record Buffer in which copy the record
+ * @param size Size of the record (in bytes)
+ * @return Success
+ * @retval 1	Size above maximum
+ * @retval 2	No record written yet
+ * @retval 3	Latest record does not have the requested size
+ */
+errorCode_u EEPROMread(void* record, uint8_t size){
+    uint8_t* iterator = (uint8_t*)record;
+
+    //assertions
+    assert(record);
+
+    if(size > EEPROM_MAX_RECORD_SIZE)
+        return (createErrorCode(READ, 1, ERR_WARNING));
+
+    if(!_latestRecord)
+        return (createErrorCode(READ, 2, ERR_WARNING));
+
+    //if the record stored has another size (e.g. layout change), error
+    if((uint8_t)(*_latestRecord & ~RECORD_TAG_MASK) != ((size + 1U) >> 1))
+        return (createErrorCode(READ, 3, ERR_WARNING));
+
+    //copy the data bytes (LSB first)
+    for(uint8_t i = 0 ; i < size ; i++)
+        *(iterator++) = (uint8_t)(_latestRecord[(i >> 1) + 1] >> ((i & 1U) << 3));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Write a new record, if it differs from the latest one
+ *
+ * @param record Record to write
+ * @param size Size of the record (in bytes)
+ * @return Success
+ * @retval 1	Size above maximum
+ * @retval 2	Error while swapping the pages
+ * @retval 3	Error while appending the record
+ */
+errorCode_u EEPROMwrite(const void* record, uint8_t size){
+    const uint8_t* data = (const uint8_t*)record;
+    const volatile uint16_t* pageEnd = PAGES[_activePage] + PAGE_NB_HALFWORDS;
+    uint8_t nbHalfwords = (uint8_t)((size + 1U) >> 1);
+    errorCode_u result;
+
+    //assertions
+    assert(record);
+    assert(_nextFree);
+
+    if(size > EEPROM_MAX_RECORD_SIZE)
+        return (createErrorCode(WRITE, 1, ERR_WARNING));
+
+    //if the record is already stored, exit (saves erase cycles)
+    if(isRecordIdentical(data, size))
+        return (ERR_SUCCESS);
+
+    unlockFlash();
+
+    //if not enough room left in the active page (tag and checksum included), write the record in the other page
+    if((_nextFree + nbHalfwords + 2) > pageEnd){
+        result = swapPages(data, size);
+        lockFlash();
+        scanActivePage();
+
+        if(isError(result))
+            return (pushErrorCode(result, WRITE, 2));
+        return (ERR_SUCCESS);
+    }
+
+    //append the record
+    result = programRecord(_nextFree, data, size);
+    lockFlash();
+    scanActivePage();
+
+    if(isError(result))
+        return (pushErrorCode(result, WRITE, 3));
+    return (ERR_SUCCESS);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Unlock the flash programming
+ */
+static inline void unlockFlash(){
+    if(FLASH->CR & FLASH_CR_LOCK){
+        FLASH->KEYR = UNLOCK_KEY1;
+        FLASH->KEYR = UNLOCK_KEY2;
+    }
+}
+
+/**
+ * @brief Lock the flash programming
+ */
+static inline void lockFlash(){
+    FLASH->CR |= FLASH_CR_LOCK;
+}
+
+/**
+ * @brief Wait for the current flash operation to end
+ *
+ * @return Success
+ * @retval 1	Timeout
+ * @retval 2	Programming or write protection error
+ */
+static errorCode_u waitForFlash(){
+    timerStart(&_timer, FLASH_TIMEOUT_MS);
+    while((FLASH->SR & FLASH_SR_BSY) && timerIsRunning(&_timer));
+
+    if(FLASH->SR & FLASH_SR_BSY)
+        return (createErrorCode(WAIT_FLASH, 1, ERR_ERROR));
+
+    //if error, clear the flags (cleared by writing 1)
+    if(FLASH->SR & (FLASH_SR_PGERR | FLASH_SR_WRPRTERR)){
+        FLASH->SR = (FLASH_SR_PGERR | FLASH_SR_WRPRTERR | FLASH_SR_EOP);
+        return (createErrorCode(WAIT_FLASH, 2, ERR_ERROR));
+    }
+
+    FLASH->SR = FLASH_SR_EOP;
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Erase a flash page
+ * @note Flash must be unlocked
+ *
+ * @param page Index of the page to erase
+ * @return Success
+ * @retval 1	Error while erasing
+ */
+static errorCode_u erasePage(uint8_t page){
+    FLASH->CR |= FLASH_CR_PER;
+    FLASH->AR = (uint32_t)PAGES[page];
+    FLASH->CR |= FLASH_CR_STRT;
+    errorCode_u result = waitForFlash();
+    FLASH->CR &= ~FLASH_CR_PER;
+
+    if(isError(result))
+        return (pushErrorCode(result, ERASE_PAGE, 1));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Program a half-word in flash
+ * @note Flash must be unlocked, and the half-word erased (or the value must be 0x0000)
+ *
+ * @param address Address of the half-word
+ * @param value Value to program
+ * @return Success
+ * @retval 1	Error while programming
+ * @retval 2	Value read back differs
+ */
+static errorCode_u programHalfword(volatile uint16_t* address, uint16_t value){
+    FLASH->CR |= FLASH_CR_PG;
+    *address = value;
+    errorCode_u result = waitForFlash();
+    FLASH->CR &= ~FLASH_CR_PG;
+
+    if(isError(result))
+        return (pushErrorCode(result, PROGRAM, 1));
+
+    if(*address != value)
+        return (createErrorCode(PROGRAM, 2, ERR_ERROR));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Program a record (tag, data and checksum) in flash
+ * @note Flash must be unlocked
+ *
+ * @param address Address at which program the record
+ * @param data Data bytes of the record
+ * @param size Number of data bytes
+ * @return Success
+ * @retval 1	Error while programming the tag
+ * @retval 2	Error while programming the data
+ * @retval 3	Error while programming the checksum
+ */
+static errorCode_u programRecord(volatile uint16_t* address, const uint8_t data[], uint8_t size){
+    uint8_t nbHalfwords = (uint8_t)((size + 1U) >> 1);
+    uint16_t checksum = (uint16_t)(RECORD_TAG | nbHalfwords);
+    errorCode_u result;
+
+    result = programHalfword(address++, RECORD_TAG | nbHalfwords);
+    if(isError(result))
+        return (pushErrorCode(result, PROGRAM_RECORD, 1));
+
+    for(uint8_t i = 0 ; i < nbHalfwords ; i++){
+        uint16_t halfword = dataHalfword(data, size, i);
+        checksum = (uint16_t)(checksum + halfword);
+
+        result = programHalfword(address++, halfword);
+        if(isError(result))
+            return (pushErrorCode(result, PROGRAM_RECORD, 2));
+    }
+
+    result = programHalfword(address, (uint16_t)~checksum);
+    if(isError(result))
+        return (pushErrorCode(result, PROGRAM_RECORD, 3));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Write a record in the inactive page, then make it the active one
+ * @note Flash must be unlocked
+ *
+ * @param data Data bytes of the record
+ * @param size Number of data bytes
+ * @return Success
+ * @retval 1	Error while marking the new page as receiving
+ * @retval 2	Error while writing the record
+ * @retval 3	Error while erasing the old page
+ * @retval 4	Error while marking the new page as valid
+ */
+static errorCode_u swapPages(const uint8_t data[], uint8_t size){
+    uint8_t newPage = _activePage ^ 1U;
+    errorCode_u result;
+
+    //the inactive page is always kept erased (see EEPROMinitialise())
+    result = programHalfword(PAGES[newPage], PAGE_RECEIVING);
+    if(isError(result))
+        return (pushErrorCode(result, SWAP_PAGES, 1));
+
+    result = programRecord(PAGES[newPage] + 1, data, size);
+    if(isError(result))
+        return (pushErrorCode(result, SWAP_PAGES, 2));
+
+    //the new page now holds the latest record, the old one can be erased
+    _activePage = newPage;
+    result = erasePage(newPage ^ 1U);
+    if(isError(result))
+        return (pushErrorCode(result, SWAP_PAGES, 3));
+
+    result = programHalfword(PAGES[newPage], PAGE_VALID);
+    if(isError(result))
+        return (pushErrorCode(result, SWAP_PAGES, 4));
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Look for the latest valid record and the first erased half-word in the active page
+ */
+static void scanActivePage(){
+    volatile uint16_t* iterator = PAGES[_activePage] + 1;
+    const volatile uint16_t* pageEnd = PAGES[_activePage] + PAGE_NB_HALFWORDS;
+
+    _latestRecord = (void*)0;
+    while((iterator < pageEnd) && (*iterator != ERASED_HALFWORD)){
+        uint8_t nbHalfwords = (uint8_t)(*iterator & ~RECORD_TAG_MASK);
+
+        //if not a record or going past the page end, consider the rest of the page unusable
+        if(((*iterator & RECORD_TAG_MASK) != RECORD_TAG) || ((iterator + nbHalfwords + 2) > pageEnd)){
+            iterator = (volatile uint16_t*)pageEnd;
+            break;
+        }
+
+        //if record complete (checksum valid), it's the latest one so far
+        if(iterator[nbHalfwords + 1] == recordChecksum(iterator))
+            _latestRecord = iterator;
+
+        iterator += nbHalfwords + 2;
+    }
+
+    _nextFree = iterator;
+}
+
+/**
+ * @brief Check if a page is completely erased
+ *
+ * @param page Index of the page to check
+ * @retval 0	Page not erased
+ * @retval 1	Page erased
+ */
+static uint8_t isPageErased(uint8_t page){
+    for(uint16_t i = 0 ; i < PAGE_NB_HALFWORDS ; i++){
+        if(PAGES[page][i] != ERASED_HALFWORD)
+            return (0);
+    }
+
+    return (1);
+}
+
+/**
+ * @brief Check if the latest record holds the same data
+ *
+ * @param data Data bytes to compare
+ * @param size Number of data bytes
+ * @retval 0	Record differs or does not exist
+ * @retval 1	Record identical
+ */
+static uint8_t isRecordIdentical(const uint8_t data[], uint8_t size){
+    uint8_t nbHalfwords = (uint8_t)((size + 1U) >> 1);
+
+    if(!_latestRecord || ((uint8_t)(*_latestRecord & ~RECORD_TAG_MASK) != nbHalfwords))
+        return (0);
+
+    for(uint8_t i = 0 ; i < nbHalfwords ; i++){
+        if(_latestRecord[i + 1] != dataHalfword(data, size, i))
+            return (0);
+    }
+
+    return (1);
+}
+
+/**
+ * @brief Compute the checksum of a record (complement of the sum of its tag and data half-words)
+ *
+ * @param record Address of the record tag
+ * @return Checksum
+ */
+static uint16_t recordChecksum(const volatile uint16_t* record){
+    uint8_t nbHalfwords = (uint8_t)(*record & ~RECORD_TAG_MASK);
+    uint16_t checksum = 0;
+
+    for(uint8_t i = 0 ; i <= nbHalfwords ; i++)
+        checksum = (uint16_t)(checksum + record[i]);
+
+    return ((uint16_t)~checksum);
+}
+
+/**
+ * @brief Get a data half-word (LSB first, padded with 0xFF)
+ *
+ * @param data Data bytes
+ * @param size Number of data bytes
+ * @param index Index of the half-word
+ * @return Half-word
+ */
+static inline uint16_t dataHalfword(const uint8_t data[], uint8_t size, uint8_t index){
+    uint8_t first = (uint8_t)(index << 1);
+    uint8_t second = ((first + 1U) < size) ? data[first + 1] : 0xFFU;
+
+    return ((uint16_t)(((uint16_t)second << 8) | data[first]));
+}
@@ -0,0 +1,161 @@
+/**
+ * @file history.c
+ * @brief Implement a RAM ring buffer holding the envelopes of the latest angles measured, with their statistics
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * Each sample holds the roll and pitch angles of an accelerometer snapshot, in tenths.
+ * Samples are not stored one by one : only the envelope (min., max.) of each span is kept in the ring,
+ * a span being closed by historyTakeSpan() (e.g. once per graph column). Once the ring is full,
+ * the oldest span is overwritten by the newest one.
+ *
+ * The statistics (min., max., peak) and the envelope of the current span are updated each time a sample is added,
+ * so that reading them never requires going through the ring.
+ */
+#include "history.h"
+
+//definitions
+#define HISTORY_MASK	(HISTORY_NB_SPANS - 1U)	///< Mask used to wrap an index in the ring
+
+//static assertions (ran at compile time)
+_Static_assert((HISTORY_NB_SPANS & HISTORY_MASK) == 0, "HISTORY_NB_SPANS must be a power of two.");
+_Static_assert(HISTORY_NB_SPANS <= UINT16_MAX, "HISTORY_NB_SPANS does not fit in the spans counter.");
+
+/**
+ * @brief Enumeration of the function IDs of the history
+ */
+typedef enum _historyFunctionCodes_e{
+    GET = 0,	///< historyGet()
+}historyFunctionCodes_e;
+
+//tool functions
+static void resetSpan();
+
+//state variables
+static historySpan_t	_spans[HISTORY_NB_SPANS];	///< Ring of the spans recorded
+static uint16_t			_newest = HISTORY_MASK;		///< Index of the newest span in the ring
+static uint16_t			_count = 0;					///< Number of spans in the ring
+static historyStats_t	_stats[HISTORY_NB_AXIS];	///< Statistics of each angle since the latest reset
+static historySpan_t	_span;						///< Envelope of the samples added since the latest span taken
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Empty the history and reset the statistics
+ */
+void historyReset(){
+    _newest = HISTORY_MASK;
+    _count = 0;
+
+    for(uint8_t axis = 0 ; axis < HISTORY_NB_AXIS ; axis++)
+        _stats[axis] = (historyStats_t){INT16_MAX, INT16_MIN, 0};
+
+    resetSpan();
+}
+
+/**
+ * @brief Add a sample in the statistics and in the current span
+ *
+ * @param samples Angle of each axis (in tenths)
+ */
+void historyAdd(const int16_t samples[HISTORY_NB_AXIS]){
+    for(uint8_t axis = 0 ; axis < HISTORY_NB_AXIS ; axis++){
+        int16_t value = samples[axis];
+
+        //update the statistics since the latest reset
+        if(value < _stats[axis].minimum)
+            _stats[axis].minimum = value;
+        if(value > _stats[axis].maximum)
+            _stats[axis].maximum = value;
+        if((value < 0 ? -value : value) > (_stats[axis].peak < 0 ? -_stats[axis].peak : _stats[axis].peak))
+            _stats[axis].peak = value;
+
+        //update the envelope of the current span
+        if(value < _span.minimum[axis])
+            _span.minimum[axis] = value;
+        if(value > _span.maximum[axis])
+            _span.maximum[axis] = value;
+    }
+
+    _span.nbSamples++;
+}
+
+/**
+ * @brief Get the number of spans in the history
+ *
+ * @return Number of spans
+ */
+uint16_t historyCount(){
+    return (_count);
+}
+
+/**
+ * @brief Get a span from the history
+ *
+ * @param age		Age of the span (0 for the newest one)
+ * @param[out] span	Envelope of the span
+ * @return Success
+ * @retval 1	No span this old in the history
+ */
+errorCode_u historyGet(uint16_t age, historySpan_t* span){
+    if(age >= _count)
+        return (createErrorCode(GET, 1, ERR_WARNING));
+
+    *span = _spans[(_newest - age) & HISTORY_MASK];
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Get the statistics of an angle since the latest reset
+ * @note The minimum and the maximum are respectively INT16_MAX and INT16_MIN until a sample is added
+ *
+ * @param axis Axis of which get the statistics
+ * @return Statistics
+ */
+const historyStats_t* historyGetStats(historyAxis_e axis){
+    if(axis >= HISTORY_NB_AXIS)
+        axis = HISTORY_ROLL;
+
+    return (&_stats[axis]);
+}
+
+/**
+ * @brief Get the envelope of the samples added since the latest span taken, record it in the ring, then start a new span
+ * @note An empty span is not recorded
+ *
+ * @return Envelope of the span (nbSamples is 0 if no sample has been added)
+ */
+historySpan_t historyTakeSpan(){
+    historySpan_t span = _span;
+
+    if(span.nbSamples){
+        _newest = (uint16_t)((_newest + 1U) & HISTORY_MASK);
+        _spans[_newest] = span;
+        if(_count < HISTORY_NB_SPANS)
+            _count++;
+    }
+
+    resetSpan();
+    return (span);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Start a new span, without any sample
+ */
+static void resetSpan(){
+    for(uint8_t axis = 0 ; axis < HISTORY_NB_AXIS ; axis++){
+        _span.minimum[axis] = INT16_MAX;
+        _span.maximum[axis] = INT16_MIN;
+    }
+
+    _span.nbSamples = 0;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file telemetry.c
+ * @brief Implement a binary stream of the raw accelerometer samples, sent over an USART with DMA
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The samples are packed in fixed-size frames, each one sent in the background by a single DMA transfer.
+ * Two frames are used in turn : one is filled while the other one is being sent.
+ * If a frame is full while the previous one is still being sent, it is dropped (its sequence number is skipped).
+ * When the producer loses samples (e.g. the ADXL345 FIFO is cleared), the frame being filled is discarded the same way,
+ * so that a frame never holds samples from both sides of the gap.
+ *
+ * Frame structure (106 bytes, all fields little-endian) :
+ *
+ * | Offset | Size | Field                                                         |
+ * |--------|------|---------------------------------------------------------------|
+ * | 0      | 2    | Synchronisation word (0x5AA5, sent 0xA5 then 0x5A)            |
+ * | 2      | 2    | Sequence number (incremented for each frame, sent or dropped) |
+ * | 4      | 4    | System tick at which the first sample was pushed (ms)         |
+ * | 8      | 96   | 16 samples, each one X, Y, Z (int16_t, raw ADXL345 LSB)       |
+ * | 104    | 2    | CRC-16/CCITT-FALSE of the bytes 2 to 103                      |
+ *
+ * tools/decodeTelemetry.py decodes the stream on the host side.
+ *
+ * @note The DMA channel transfer flags used are the ones of channel 7 (USART2 TX)
+ */
+#include "telemetry.h"
+
+//definitions
+#define TELEMETRY_SYNC			0x5AA5U		///< Synchronisation word starting each frame
+#define CRC_INITIAL				0xFFFFU		///< Initial value of the frames CRC
+#define SAMPLE_SIZE				(TELEMETRY_NB_AXIS << 1)	///< Number of bytes in a sample
+#define FRAME_SEQUENCE_OFFSET	2U			///< Offset of the sequence number in a frame
+#define FRAME_TIMESTAMP_OFFSET	4U			///< Offset of the timestamp in a frame
+#define FRAME_SAMPLES_OFFSET	8U			///< Offset of the first sample in a frame
+#define FRAME_CRC_OFFSET		(FRAME_SAMPLES_OFFSET + (TELEMETRY_SAMPLES_PER_FRAME * SAMPLE_SIZE))	///< Offset of the CRC in a frame
+#define TELEMETRY_FRAME_SIZE	(FRAME_CRC_OFFSET + 2U)	///< Number of bytes in a frame
+#define DMA_CHANNEL_FLAGS		4U			///< Number of bits of each channel flags in the DMA ISR and IFCR registers
+
+//static assertions (ran at compile time)
+_Static_assert(TELEMETRY_FRAME_SIZE <= UINT8_MAX, "A telemetry frame must fit in 255 bytes.");
+
+//tool functions
+static uint8_t isTransmitting();
+static void startTransmission(const uint8_t frame[]);
+static uint16_t computeCRC(const uint8_t data[], uint8_t length);
+static void writeHalfWord(uint8_t destination[], uint16_t value);
+static inline uint32_t channelFlag(uint32_t flag);
+
+//state variables
+static USART_TypeDef*	_usartHandle = (void*)0;	///< USART used to send the frames
+static DMA_TypeDef*		_dmaHandle = (void*)0;		///< DMA used to send the frames
+static uint32_t			_dmaChannel = 0;			///< DMA channel used to send the frames
+static uint8_t			_frames[2][TELEMETRY_FRAME_SIZE];	///< Frames used in turn (one filled while the other one is sent)
+static uint8_t			_filling = 0;				///< Index of the frame being filled
+static uint8_t			_nbSamples = 0;				///< Number of samples in the frame being filled
+static uint16_t			_sequence = 0;				///< Sequence number of the frame being filled
+static telemetryStats_t	_stats;						///< Statistics of the stream
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Initialise the telemetry stream
+ * @note The USART must be configured and enabled, and the DMA channel configured as memory-to-peripheral
+ *
+ * @param handle		USART used to send the frames
+ * @param dma			DMA used to send the frames
+ * @param dmaChannel	DMA channel used to send the frames
+ */
+void telemetryInitialise(USART_TypeDef* handle, DMA_TypeDef* dma, uint32_t dmaChannel){
+    _usartHandle = handle;
+    _dmaHandle = dma;
+    _dmaChannel = dmaChannel;
+
+    //set the DMA destination address (source address is set for each frame sent)
+    LL_DMA_DisableChannel(_dmaHandle, _dmaChannel);
+    LL_DMA_SetPeriphAddress(_dmaHandle, _dmaChannel, LL_USART_DMA_GetRegAddr(_usartHandle));
+    LL_USART_EnableDMAReq_TX(_usartHandle);
+
+    //stamp the frames synchronisation word once and for all
+    for(uint8_t i = 0 ; i < 2U ; i++)
+        writeHalfWord(_frames[i], TELEMETRY_SYNC);
+
+    _filling = 0;
+    _nbSamples = 0;
+    _stats = (telemetryStats_t){0};
+}
+
+/**
+ * @brief Add a raw sample to the frame being filled, and send the frame once full
+ * @note Samples pushed before the initialisation are ignored
+ *
+ * @param sample Raw X, Y and Z values
+ */
+void telemetryPushSample(const int16_t sample[TELEMETRY_NB_AXIS]){
+    uint8_t* frame = _frames[_filling];
+
+    if(!_usartHandle)
+        return;
+
+    //timestamp the frame with its first sample
+    if(!_nbSamples){
+        uint32_t now = systemTick_ms;
+        writeHalfWord(&frame[FRAME_TIMESTAMP_OFFSET], (uint16_t)now);
+        writeHalfWord(&frame[FRAME_TIMESTAMP_OFFSET + 2U], (uint16_t)(now >> 16));
+    }
+
+    uint8_t* destination = &frame[FRAME_SAMPLES_OFFSET + (_nbSamples * SAMPLE_SIZE)];
+    for(uint8_t axis = 0 ; axis < TELEMETRY_NB_AXIS ; axis++)
+        writeHalfWord(&destination[axis << 1], (uint16_t)sample[axis]);
+
+    //if the frame is not full yet, exit
+    _nbSamples++;
+    if(_nbSamples < TELEMETRY_SAMPLES_PER_FRAME)
+        return;
+
+    //seal the frame
+    _nbSamples = 0;
+    writeHalfWord(&frame[FRAME_SEQUENCE_OFFSET], _sequence++);
+
+    //if the previous frame is still being sent, drop this one and fill it again
+    if(isTransmitting()){
+        _stats.nbDroppedFrames++;
+        return;
+    }
+
+    writeHalfWord(&frame[FRAME_CRC_OFFSET], computeCRC(&frame[FRAME_SEQUENCE_OFFSET], FRAME_CRC_OFFSET - FRAME_SEQUENCE_OFFSET));
+    startTransmission(frame);
+    _filling ^= 1U;
+}
+
+/**
+ * @brief Account for samples lost before being pushed, and discard the frame being filled
+ * @details The sequence number of the frame discarded is skipped, so that the decoder sees the gap
+ * @note Samples lost before the initialisation are ignored
+ *
+ * @param nbSamples Number of samples lost (nothing is done if 0)
+ */
+void telemetryDropSamples(uint16_t nbSamples){
+    if(!_usartHandle || !nbSamples)
+        return;
+
+    _stats.nbDroppedSamples += (uint32_t)nbSamples + _nbSamples;
+    _nbSamples = 0;
+    _sequence++;
+}
+
+/**
+ * @brief Get the statistics of the telemetry stream
+ *
+ * @return Statistics
+ */
+const telemetryStats_t* telemetryGetStats(){
+    return (&_stats);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Check if a frame is still being sent
+ *
+ * @retval 0 No frame being sent
+ * @retval 1 Frame being sent
+ */
+static uint8_t isTransmitting(){
+    return (LL_DMA_IsEnabledChannel(_dmaHandle, _dmaChannel) && !(_dmaHandle->ISR & channelFlag(DMA_ISR_TCIF1 | DMA_ISR_TEIF1)));
+}
+
+/**
+ * @brief Start the DMA transfer sending a frame
+ *
+ * @param frame Frame to send
+ */
+static void startTransmission(const uint8_t frame[]){
+    //if the previous transfer failed, count it
+    if(_dmaHandle->ISR & channelFlag(DMA_ISR_TEIF1))
+        _stats.nbErrors++;
+
+    LL_DMA_DisableChannel(_dmaHandle, _dmaChannel);
+    _dmaHandle->IFCR = channelFlag(DMA_IFCR_CGIF1);
+    LL_DMA_SetMemoryAddress(_dmaHandle, _dmaChannel, (uint32_t)frame);
+    LL_DMA_SetDataLength(_dmaHandle, _dmaChannel, TELEMETRY_FRAME_SIZE);
+    LL_DMA_EnableChannel(_dmaHandle, _dmaChannel);
+
+    _stats.nbFrames++;
+}
+
+/**
+ * @brief Compute the CRC-16/CCITT-FALSE of a buffer (polynomial 0x1021, initial value 0xFFFF)
+ * @details The CRC is computed a nibble at a time, to keep the table small
+ *
+ * @param data		Buffer of which compute the CRC
+ * @param length	Number of bytes in the buffer
+ * @return CRC
+ */
+static uint16_t computeCRC(const uint8_t data[], uint8_t length){
+    static const uint16_t NIBBLES_CRC[16] = {
+        0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+        0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+    };
+    uint16_t crc = CRC_INITIAL;
+
+    for(uint8_t i = 0 ; i < length ; i++){
+        crc = (uint16_t)((crc << 4) ^ NIBBLES_CRC[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ NIBBLES_CRC[(crc >> 12) ^ (data[i] & 0x0FU)]);
+    }
+
+    return (crc);
+}
+
+/**
+ * @brief Write a half-word in a frame, least significant byte first
+ *
+ * @param destination	Address at which write the half-word
+ * @param value			Half-word to write
+ */
+static void writeHalfWord(uint8_t destination[], uint16_t value){
+    destination[0] = (uint8_t)value;
+    destination[1] = (uint8_t)(value >> 8);
+}
+
+/**
+ * @brief Get the mask of a flag of the DMA channel used, in the ISR and IFCR registers
+ *
+ * @param flag Flag of the channel 1 (e.g. DMA_ISR_TCIF1)
+ * @return Flag of the channel used
+ */
+static inline uint32_t channelFlag(uint32_t flag){
+    return (flag << ((_dmaChannel - 1U) * DMA_CHANNEL_FLAGS));
+}
@@ -0,0 +1,206 @@
+#############################################################################################################################
+# file:  packBitmaps.cmake
+# date:  14/10/2026
+# brief: Pack ASCII-art bitmaps into C arrays matching the SSD1306 horizontal addressing order
+#
+# usage: cmake -DINPUT=<assets file> -DOUTPUT_DIR=<directory> -DNAME=<file name> -P packBitmaps.cmake
+#        Generates <OUTPUT_DIR>/<NAME>.h and <OUTPUT_DIR>/<NAME>.c
+#
+# note:  Assets file syntax (empty lines and lines starting with // are ignored) :
+#        font <array> <enum type> <enum count> <prefix> <width> <height>
+#            declares a font of same-sized glyphs, followed by blocks of :
+#            glyph <enum value>
+#            <height rows of width pixels>
+#        bitmap <array> <prefix> <width> <height>
+#            declares a single bitmap, followed by its <height rows of width pixels>
+#
+#        Pixels are drawn with # (lit) or . (blank), and the height must be a multiple of 8 (one SSD1306 page).
+#        Bytes are packed page by page, then column by column, with the top pixel as the LSB.
+#        Bitmaps sharing the same prefix must have the same dimensions.
+#############################################################################################################################
+cmake_minimum_required(VERSION 3.20)
+
+foreach(variable INPUT OUTPUT_DIR NAME)
+	if(NOT DEFINED ${variable})
+		message(FATAL_ERROR "packBitmaps : ${variable} is not defined")
+	endif()
+endforeach()
+
+set(HEX_DIGITS 0 1 2 3 4 5 6 7 8 9 A B C D E F)
+
+#pack the rows of a bitmap into the SSD1306 page-major layout, one line of bytes per page
+function(pack_rows width height result)
+	math(EXPR lastPage "(${height} / 8) - 1")
+	math(EXPR lastColumn "${width} - 1")
+	set(text "")
+
+	foreach(page RANGE ${lastPage})
+		set(line "       ")
+		foreach(column RANGE ${lastColumn})
+			set(byte 0)
+			foreach(bit RANGE 7)
+				math(EXPR row "(${page} * 8) + ${bit}")
+				list(GET ROWS ${row} pixels)
+				string(SUBSTRING "${pixels}" ${column} 1 pixel)
+				if(pixel STREQUAL "#")
+					math(EXPR byte "${byte} | (1 << ${bit})")
+				endif()
+			endforeach()
+
+			math(EXPR high "${byte} >> 4")
+			math(EXPR low "${byte} & 15")
+			list(GET HEX_DIGITS ${high} high)
+			list(GET HEX_DIGITS ${low} low)
+			string(APPEND line " 0x${high}${low},")
+		endforeach()
+		string(APPEND text "${line}\n")
+	endforeach()
+
+	set(${result} "${text}" PARENT_SCOPE)
+endfunction()
+
+#declare the dimensions of a prefix in the header (once per prefix)
+function(declare_dimensions prefix width height description)
+	math(EXPR nbPages "${height} / 8")
+	math(EXPR nbBytes "${width} * ${nbPages}")
+
+	if(DEFINED DIMENSIONS_${prefix})
+		if(NOT DIMENSIONS_${prefix} STREQUAL "${width}x${height}")
+			message(FATAL_ERROR "packBitmaps : ${prefix} bitmaps do not all have the same dimensions")
+		endif()
+		return()
+	endif()
+	set(DIMENSIONS_${prefix} "${width}x${height}" PARENT_SCOPE)
+
+	string(APPEND HEADER_DEFINES "#define ${prefix}_WIDTH\t\t${width}U\t///< Width of ${description} in pixels\n")
+	string(APPEND HEADER_DEFINES "#define ${prefix}_NB_PAGES\t${nbPages}U\t///< Number of SSD pages used by ${description}\n")
+	string(APPEND HEADER_DEFINES "#define ${prefix}_NB_BYTES\t${nbBytes}U\t///< Number of bytes of ${description}\n\n")
+	set(HEADER_DEFINES "${HEADER_DEFINES}" PARENT_SCOPE)
+endfunction()
+
+#close the block being parsed, once all its rows have been read
+macro(close_block)
+	if(BLOCK STREQUAL "glyph")
+		pack_rows(${WIDTH} ${HEIGHT} bytes)
+		string(APPEND SOURCE_ARRAYS "    [${GLYPH}] = {\n${bytes}    },\n")
+	elseif(BLOCK STREQUAL "bitmap")
+		pack_rows(${WIDTH} ${HEIGHT} bytes)
+		string(APPEND SOURCE_ARRAYS "const uint8_t ${ARRAY}[] = {\n${bytes}};\n")
+		string(APPEND SOURCE_ARRAYS "_Static_assert(sizeof(${ARRAY}) == ${PREFIX}_NB_BYTES, \"${ARRAY} does not match the ${PREFIX} dimensions\");\n\n")
+		string(APPEND HEADER_ARRAYS "extern const uint8_t ${ARRAY}[${PREFIX}_NB_BYTES];\n")
+	endif()
+	set(BLOCK "")
+	set(ROWS "")
+endmacro()
+
+#close the font being parsed, once all its glyphs have been read
+macro(close_font)
+	if(FONT_ARRAY)
+		string(APPEND HEADER_ENUMS "typedef enum{\n${FONT_GLYPHS}    ${FONT_COUNT}\n}${FONT_ENUM};\n\n")
+		string(APPEND HEADER_ARRAYS "extern const uint8_t ${FONT_ARRAY}[${FONT_COUNT}][${PREFIX}_NB_BYTES];\n")
+		string(APPEND SOURCE_ARRAYS "};\n")
+		string(APPEND SOURCE_ARRAYS "_Static_assert(sizeof(${FONT_ARRAY}) == (${FONT_COUNT} * ${PREFIX}_NB_BYTES), \"${FONT_ARRAY} does not hold one glyph per ${FONT_ENUM} value\");\n\n")
+		set(FONT_ARRAY "")
+	endif()
+endmacro()
+
+set(BLOCK "")
+set(ROWS "")
+set(FONT_ARRAY "")
+set(HEADER_DEFINES "")
+set(HEADER_ENUMS "")
+set(HEADER_ARRAYS "")
+set(SOURCE_ARRAYS "")
+set(NAME_PATTERN "[A-Za-z_][A-Za-z0-9_]*")
+
+#parse the assets file line by line
+file(STRINGS "${INPUT}" LINES ENCODING UTF-8)
+foreach(LINE IN LISTS LINES)
+	string(STRIP "${LINE}" LINE)
+	if((LINE STREQUAL "") OR (LINE MATCHES "^//"))
+		continue()
+	endif()
+
+	if(LINE MATCHES "^[#.]+$")
+		if(BLOCK STREQUAL "")
+			message(FATAL_ERROR "packBitmaps : pixels found outside of a glyph or a bitmap : ${LINE}")
+		endif()
+
+		string(LENGTH "${LINE}" length)
+		if(NOT length EQUAL WIDTH)
+			message(FATAL_ERROR "packBitmaps : row of ${length} pixels instead of ${WIDTH} : ${LINE}")
+		endif()
+
+		list(APPEND ROWS "${LINE}")
+		list(LENGTH ROWS nbRows)
+		if(nbRows EQUAL HEIGHT)
+			close_block()
+		endif()
+		continue()
+	endif()
+
+	if(NOT BLOCK STREQUAL "")
+		message(FATAL_ERROR "packBitmaps : ${BLOCK} ${GLYPH}${ARRAY} has fewer than ${HEIGHT} rows")
+	endif()
+
+	if(LINE MATCHES "^font +(${NAME_PATTERN}) +(${NAME_PATTERN}) +(${NAME_PATTERN}) +(${NAME_PATTERN}) +([0-9]+) +([0-9]+)$")
+		close_font()
+		set(FONT_ARRAY ${CMAKE_MATCH_1})
+		set(FONT_ENUM ${CMAKE_MATCH_2})
+		set(FONT_COUNT ${CMAKE_MATCH_3})
+		set(PREFIX ${CMAKE_MATCH_4})
+		set(WIDTH ${CMAKE_MATCH_5})
+		set(HEIGHT ${CMAKE_MATCH_6})
+		set(FONT_GLYPHS "")
+		declare_dimensions(${PREFIX} ${WIDTH} ${HEIGHT} "a ${FONT_ARRAY} character")
+		string(APPEND SOURCE_ARRAYS "const uint8_t ${FONT_ARRAY}[][${PREFIX}_NB_BYTES] = {\n")
+	elseif(LINE MATCHES "^glyph +(${NAME_PATTERN})$")
+		if(NOT FONT_ARRAY)
+			message(FATAL_ERROR "packBitmaps : glyph ${CMAKE_MATCH_1} declared outside of a font")
+		endif()
+		set(GLYPH ${CMAKE_MATCH_1})
+		set(ARRAY "")
+		set(BLOCK "glyph")
+		if(FONT_GLYPHS STREQUAL "")
+			string(APPEND FONT_GLYPHS "    ${GLYPH} = 0,\n")
+		else()
+			string(APPEND FONT_GLYPHS "    ${GLYPH},\n")
+		endif()
+	elseif(LINE MATCHES "^bitmap +(${NAME_PATTERN}) +(${NAME_PATTERN}) +([0-9]+) +([0-9]+)$")
+		close_font()
+		set(ARRAY ${CMAKE_MATCH_1})
+		set(PREFIX ${CMAKE_MATCH_2})
+		set(WIDTH ${CMAKE_MATCH_3})
+		set(HEIGHT ${CMAKE_MATCH_4})
+		set(GLYPH "")
+		set(BLOCK "bitmap")
+		declare_dimensions(${PREFIX} ${WIDTH} ${HEIGHT} "the ${PREFIX} bitmaps")
+	else()
+		message(FATAL_ERROR "packBitmaps : unknown line : ${LINE}")
+	endif()
+
+	math(EXPR remainder "${HEIGHT} % 8")
+	if(remainder OR (WIDTH EQUAL 0) OR (HEIGHT EQUAL 0))
+		message(FATAL_ERROR "packBitmaps : ${LINE} has dimensions which do not fit in SSD1306 pages")
+	endif()
+endforeach()
+
+if(NOT BLOCK STREQUAL "")
+	message(FATAL_ERROR "packBitmaps : ${BLOCK} ${GLYPH}${ARRAY} has fewer than ${HEIGHT} rows")
+endif()
+close_font()
+
+#write the header and the source files (only if changed, to avoid useless rebuilds)
+string(TOUPPER "${NAME}" GUARD)
+get_filename_component(INPUT_NAME "${INPUT}" NAME)
+set(BANNER "/**\n * @file ${NAME}.%EXT%\n * @brief Bitmaps generated from ${INPUT_NAME} by packBitmaps.cmake (do not edit)\n */\n")
+
+string(REPLACE "%EXT%" "h" HEADER "${BANNER}")
+string(APPEND HEADER "#ifndef ${GUARD}_H_INCLUDED\n#define ${GUARD}_H_INCLUDED\n#include <stdint.h>\n\n")
+string(APPEND HEADER "${HEADER_DEFINES}${HEADER_ENUMS}${HEADER_ARRAYS}\n#endif\n")
+
+string(REPLACE "%EXT%" "c" SOURCE "${BANNER}")
+string(APPEND SOURCE "#include \"${NAME}.h\"\n\n${SOURCE_ARRAYS}")
+
+file(CONFIGURE OUTPUT "${OUTPUT_DIR}/${NAME}.h" CONTENT "${HEADER}" @ONLY)
+file(CONFIGURE OUTPUT "${OUTPUT_DIR}/${NAME}.c" CONTENT "${SOURCE}" @ONLY)
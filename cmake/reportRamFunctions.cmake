@@ -0,0 +1,34 @@
+#############################################################################################################################
+# file:  reportRamFunctions.cmake
+# date:  14/10/2026
+# brief: Report the memory used by the functions executed from SRAM (.ramfunc section)
+#
+# usage: cmake -DSIZE_TOOL=<arm-none-eabi-size> -DELF=<executable> -P reportRamFunctions.cmake
+#
+# note:  The section is stored in flash and copied to SRAM at start-up, so its size is counted in both memories.
+#############################################################################################################################
+cmake_minimum_required(VERSION 3.20)
+
+foreach(variable SIZE_TOOL ELF)
+	if(NOT DEFINED ${variable})
+		message(FATAL_ERROR "reportRamFunctions : ${variable} is not defined")
+	endif()
+endforeach()
+
+#list the sections sizes of the executable
+execute_process(
+	COMMAND ${SIZE_TOOL} -A ${ELF}
+	OUTPUT_VARIABLE sections
+	RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "reportRamFunctions : unable to list the sections of ${ELF}")
+endif()
+
+#retrieve the .ramfunc section size (absent if no function is executed from SRAM)
+set(ramfuncSize 0)
+if(sections MATCHES "\n\\.ramfunc[ \t]+([0-9]+)")
+	set(ramfuncSize ${CMAKE_MATCH_1})
+endif()
+
+message(STATUS "RAM functions : ${ramfuncSize} bytes of SRAM, ${ramfuncSize} bytes of flash (copied at start-up)")
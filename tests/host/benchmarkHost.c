@@ -0,0 +1,541 @@
+/**
+ * @file benchmarkHost.c
+ * @brief Run the drivers benchmark on the host, and replay a raw samples trace recorded with the telemetry stream
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The same kernels as the on-target benchmark (see runBenchmark() in main.c) are run :
+ *   - the angle kernel accuracy, from -89° to +89° by tenths of degrees
+ *   - the simulated tilt sweep, from the raw FIFO entries to the angles rendered in the framebuffer
+ *
+ * Then the trace given is measured by the ADXL345 model (see hostADXL345.c), and the firmware runs as main() does :
+ * the ADXL345 and SSD1306 state machines and the application are run by the scheduler, over the SPI buses,
+ * with the interrupts of the EXTI line, the DMA channels, TIM2 and SysTick fired by the peripherals simulation.
+ *   - BENCH_WATERMARK_TO_PIXEL is measured from the watermark interrupt of a batch,
+ *     to the end of the flush after which the screen model displays the angle printed with it
+ *   - the angles displayed are checked against the ones stored with the trace, in <trace>.expected.csv
+ *     (timestamp, roll and pitch in degrees), once the sample at each timestamp has been measured
+ *
+ * The traces are the CSV files written by tools/decodeTelemetry.py
+ * (frame sequence, timestamp (ms), sample index in the frame, X, Y, Z).
+ * The drivers state machines only start once per process, so a single trace is replayed per run.
+ *
+ * The metrics are printed in the benchmarkMetric_e order, followed by the accuracy verdict.
+ * The exit code is non-zero if the angle kernel exceeded BENCHMARK_ANGLE_TOLERANCE,
+ * or if an angle displayed differs from the expected one by more than CHECKPOINT_TOLERANCE_TENTHS.
+ *
+ * usage: benchmarkHost [trace.csv]
+ */
+#include "main.h"
+#include "ADXL345.h"
+#include "SSD1306.h"
+#include "spiBus.h"
+#include "scheduler.h"
+#include "events.h"
+#include "profiler.h"
+#include "benchmark.h"
+#include "numbersVerdana16.h"
+#include "hostDevice.h"
+#include "hostADXL345.h"
+#include "hostSSD1306.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//definitions
+#define ACCURACY_SWEEP_TENTHS		890		///< Largest angle of the accuracy sweep (in tenths of degrees)
+#define TRACE_MAX_SAMPLES			16384U	///< Maximum number of samples replayed from a trace
+#define TRACE_SAMPLE_PERIOD_MS		5U		///< Period between two samples of a frame (200Hz, precise profile)
+#define TRACE_MARGIN_SAMPLES		100U	///< Number of samples measured after the end of the trace (its last one repeated)
+#define MAX_CHECKPOINTS				64U		///< Maximum number of angles checked in a trace
+#define CHECKPOINT_TOLERANCE_TENTHS	5		///< Highest deviation of an angle displayed from the expected one (in tenths of degrees)
+#define EXPECTED_SUFFIX				".expected.csv"	///< Suffix replacing ".csv" in the path of the expected angles of a trace
+#define PATH_MAX_LENGTH				512U	///< Maximum length of a path
+#define DRIVERS_STACK_SIZE			(256U * 1024U)	///< Size of the stack on which the drivers run
+#define SELF_TEST_PASSED_RECORD		0xAD45U	///< ADXL345 self-test record in the backup registers (the model does not simulate the self-test)
+#define ANGLE_COLUMN				40U		///< Column of the first character of an angle (see renderAngle())
+#define ANGLE_NB_CHARS				6U		///< Number of characters of an angle (sign, number field and unit)
+
+/**
+ * @brief Structure holding an angle checked while replaying a trace
+ */
+typedef struct{
+    uint32_t	sample;					///< Index of the sample after which the angles are checked
+    uint32_t	timestamp_ms;			///< Timestamp of the sample
+    int16_t		tenths[NB_ROTATIONS];	///< Angles expected (in tenths of degrees)
+}checkpoint_t;
+
+/**
+ * @brief Structure holding an angle printed, until the screen displays it
+ */
+typedef struct{
+    uint8_t		pending;		///< Flag indicating the angle is not displayed yet
+    int16_t		tenths;			///< Angle printed (in tenths of degrees)
+    uint64_t	watermark;		///< Simulated clock at the watermark interrupt of the batch from which the angle is computed
+}pixelProbe_t;
+
+//tool functions
+static void runSweeps();
+static uint8_t loadTrace(const char* path);
+static uint8_t loadCheckpoints(const char* path);
+static void* replayTrace(void* argument);
+static void startDrivers();
+static uint8_t checkDisplay(const checkpoint_t* checkpoint);
+static uint8_t decodeAngle(rotationAxis_e axis, int16_t* tenths);
+static void screenWritten();
+static errorCode_u accelerometerTask();
+static errorCode_u applicationTask();
+static void printResults();
+
+//global variables
+volatile uint32_t systemTick_ms = 0;
+
+//state variables
+static int16_t		_samples[TRACE_MAX_SAMPLES][HOST_ADXL_NB_AXIS];	///< Raw samples of the trace being replayed
+static uint32_t		_timestamps_ms[TRACE_MAX_SAMPLES];		///< Time at which each sample of the trace has been measured
+static uint32_t		_nbSamples = 0;							///< Number of samples in the trace
+static checkpoint_t	_checkpoints[MAX_CHECKPOINTS];			///< Angles checked while replaying the trace
+static uint8_t		_nbCheckpoints = 0;						///< Number of angles checked
+static uint8_t		_driversStack[DRIVERS_STACK_SIZE] __attribute__((aligned(16)));	///< Stack of the drivers (its buffers addresses must fit in the DMA registers)
+static uint64_t		_batchWatermark = 0;					///< Simulated clock at the watermark interrupt of the latest snapshot
+static uint32_t		_printedSequence = 0;					///< Sequence of the latest snapshot printed
+static int16_t		_printedTenths[NB_ROTATIONS] = {INT16_MIN, INT16_MIN};	///< Latest angles printed
+static pixelProbe_t	_probes[NB_ROTATIONS];					///< Angles printed, until the screen displays them
+static uint8_t		_replayed = 0;							///< Flag indicating the trace has been replayed with all the angles displayed as expected
+
+
+/**
+ * @brief Run the benchmark, and replay the trace given
+ *
+ * @param argc Number of arguments
+ * @param argv Path of the trace to replay
+ * @retval EXIT_SUCCESS Angle kernel within the tolerance, and the trace replayed with the angles expected
+ * @retval EXIT_FAILURE Angle kernel out of the tolerance, or the trace not replayed as expected
+ */
+int main(int argc, char* argv[]){
+    uint8_t traceReplayed = 1;
+
+    if(argc > 2){
+        fprintf(stderr, "usage: %s [trace.csv]\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    profilerInitialise();
+    benchmarkReset();
+    runSweeps();
+
+    //run the drivers on a stack placed with the static variables, as the DMA registers only hold 32 bits addresses
+    if(argc == 2){
+        pthread_t thread;
+        pthread_attr_t attributes;
+
+        pthread_attr_init(&attributes);
+        pthread_attr_setstack(&attributes, _driversStack, sizeof(_driversStack));
+        if(pthread_create(&thread, &attributes, replayTrace, argv[1]) || pthread_join(thread, NULL)){
+            fprintf(stderr, "%s : could not start the drivers\n", argv[1]);
+            _replayed = 0;
+        }
+        pthread_attr_destroy(&attributes);
+        traceReplayed = _replayed;
+    }
+
+    printResults();
+    return ((benchmarkPassed() && traceReplayed) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Handle the SysTick interrupt, as stm32f1xx_it.c does
+ */
+void SysTick_Handler(void){
+    systemTick_ms++;
+}
+
+/**
+ * @brief Handle the EXTI line 0 interrupt (ADXL345 INT1), as stm32f1xx_it.c does
+ */
+void EXTI0_IRQHandler(void){
+    if(LL_EXTI_IsActiveFlag_0_31(LL_EXTI_LINE_0)){
+        LL_EXTI_ClearFlag_0_31(LL_EXTI_LINE_0);
+        ADXL345watermarkInterrupt();
+        schedulerSignal(TASK_ACCELEROMETER);
+    }
+}
+
+/**
+ * @brief Handle the DMA1 channel 2 interrupt (SPI1 reception), as stm32f1xx_it.c does
+ */
+void DMA1_Channel2_IRQHandler(void){
+    spiBusInterrupt(SPI_BUS_1);
+    schedulerSignal(TASK_ACCELEROMETER);
+}
+
+/**
+ * @brief Handle the DMA1 channel 5 interrupt (SPI2 transmission), as stm32f1xx_it.c does
+ */
+void DMA1_Channel5_IRQHandler(void){
+    spiBusInterrupt(SPI_BUS_2);
+    schedulerSignal(TASK_SCREEN);
+}
+
+/**
+ * @brief Handle the TIM2 interrupt (ADXL345 timeouts), as stm32f1xx_it.c does
+ */
+void TIM2_IRQHandler(void){
+    ADXL345timerInterrupt();
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Run the accuracy sweep and the simulated tilt sweep, as on the target
+ */
+static void runSweeps(){
+    int16_t angles[NB_ROTATIONS];
+
+    for(int16_t tenths = -ACCURACY_SWEEP_TENTHS ; tenths <= ACCURACY_SWEEP_TENTHS ; tenths++)
+        ADXL345benchmarkAccuracy(tenths);
+
+    for(uint8_t pass = 0 ; pass < BENCHMARK_NB_PASSES ; pass++){
+        for(uint16_t step = 0 ; step < BENCHMARK_NB_STEPS ; step++){
+            uint32_t start = profilerNow();
+
+            ADXL345benchmarkLoad(step);
+            ADXL345benchmarkStep(angles);
+            SSD1306benchmarkRender(angles);
+            benchmarkRecord(BENCH_SAMPLE_TO_PIXEL, profilerNow() - start);
+        }
+    }
+}
+
+/**
+ * @brief Parse the raw samples of a trace, skipping the header and the malformed lines
+ *
+ * @param path Path of the CSV trace
+ * @retval 0 Trace could not be read, or holds no sample
+ * @retval 1 Trace loaded
+ */
+static uint8_t loadTrace(const char* path){
+    FILE* file = fopen(path, "r");
+    char line[128];
+
+    if(!file){
+        fprintf(stderr, "%s : could not be opened\n", path);
+        return (0);
+    }
+
+    _nbSamples = 0;
+    while(fgets(line, sizeof(line), file) && (_nbSamples < TRACE_MAX_SAMPLES)){
+        unsigned sequence, timestamp_ms, index;
+        short x, y, z;
+
+        if(sscanf(line, "%u,%u,%u,%hd,%hd,%hd", &sequence, &timestamp_ms, &index, &x, &y, &z) != 6)
+            continue;
+
+        _samples[_nbSamples][X_AXIS] = x;
+        _samples[_nbSamples][Y_AXIS] = y;
+        _samples[_nbSamples][Z_AXIS] = z;
+        _timestamps_ms[_nbSamples] = (uint32_t)timestamp_ms + ((uint32_t)index * TRACE_SAMPLE_PERIOD_MS);
+        _nbSamples++;
+    }
+    fclose(file);
+
+    if(!_nbSamples)
+        fprintf(stderr, "%s : no sample found\n", path);
+    return (_nbSamples > 0);
+}
+
+/**
+ * @brief Parse the angles expected while replaying a trace, skipping the comments, the header and the malformed lines
+ *
+ * @param path Path of the CSV trace (the expected angles are read from the file with EXPECTED_SUFFIX)
+ * @retval 0 Expected angles could not be read, or none is found
+ * @retval 1 Expected angles loaded
+ */
+static uint8_t loadCheckpoints(const char* path){
+    char expectedPath[PATH_MAX_LENGTH];
+    char line[128];
+    size_t length = strlen(path);
+
+    if((length < 4U) || strcmp(&path[length - 4U], ".csv")
+       || (snprintf(expectedPath, sizeof(expectedPath), "%.*s%s", (int)(length - 4U), path, EXPECTED_SUFFIX) >= (int)sizeof(expectedPath))){
+        fprintf(stderr, "%s : not a CSV trace\n", path);
+        return (0);
+    }
+
+    FILE* file = fopen(expectedPath, "r");
+    if(!file){
+        fprintf(stderr, "%s : could not be opened\n", expectedPath);
+        return (0);
+    }
+
+    _nbCheckpoints = 0;
+    while(fgets(line, sizeof(line), file) && (_nbCheckpoints < MAX_CHECKPOINTS)){
+        unsigned timestamp_ms;
+        double roll, pitch;
+
+        if((line[0] == '#') || (sscanf(line, "%u,%lf,%lf", &timestamp_ms, &roll, &pitch) != 3))
+            continue;
+
+        //check the angles once the first sample measured at (or after) the timestamp is
+        uint32_t sample = 0;
+        while((sample < (_nbSamples - 1U)) && (_timestamps_ms[sample] < timestamp_ms))
+            sample++;
+
+        _checkpoints[_nbCheckpoints++] = (checkpoint_t){
+            .sample = sample,
+            .timestamp_ms = timestamp_ms,
+            .tenths = {(int16_t)lround(roll * 10.0), (int16_t)lround(pitch * 10.0)},
+        };
+    }
+    fclose(file);
+
+    if(!_nbCheckpoints)
+        fprintf(stderr, "%s : no expected angle found\n", expectedPath);
+    return (_nbCheckpoints > 0);
+}
+
+/**
+ * @brief Replay a raw samples trace through the drivers, and check the angles displayed
+ * @note Run on the drivers stack
+ *
+ * @param argument Path of the CSV trace
+ * @return NULL (the verdict is stored in _replayed)
+ */
+static void* replayTrace(void* argument){
+    const char* path = argument;
+    uint8_t checked = 0;
+    uint8_t matched = 0;
+
+    _replayed = 0;
+    if(((uintptr_t)&_driversStack[DRIVERS_STACK_SIZE - 1U] > UINT32_MAX) || ((uintptr_t)_samples > UINT32_MAX)){
+        fprintf(stderr, "%s : the drivers buffers do not fit in the DMA registers (position-independent executable ?)\n", path);
+        return (NULL);
+    }
+    if(!loadTrace(path) || !loadCheckpoints(path))
+        return (NULL);
+
+    startDrivers();
+
+    //run the main loop as main() does, and check the angles once the sample of each checkpoint has been measured
+    while(hostADXL345getMeasured() < (_nbSamples + TRACE_MARGIN_SAMPLES)){
+        if(!schedulerRun())
+            schedulerIdle();
+
+        while((checked < _nbCheckpoints) && (hostADXL345getMeasured() > _checkpoints[checked].sample))
+            matched = (uint8_t)(matched + checkDisplay(&_checkpoints[checked++]));
+    }
+
+    printf("%s : %u samples measured over %u ms, %u snapshots published, %u/%u angles displayed as expected\n",
+           path, (unsigned)_nbSamples, (unsigned)(_timestamps_ms[_nbSamples - 1U] - _timestamps_ms[0]),
+           (unsigned)ADXL345getSnapshot()->sequence, matched, _nbCheckpoints);
+    _replayed = ((checked == _nbCheckpoints) && (matched == _nbCheckpoints));
+    return (NULL);
+}
+
+/**
+ * @brief Configure the peripherals and start the drivers and the tasks, as main() does
+ * @details The ADXL345 boots warm with its self-test passed, as the model does not simulate it
+ */
+static void startDrivers(){
+    //peripherals configuration of the MX_xxx_Init() functions used
+    EXTI->IMR |= LL_EXTI_LINE_0;
+    EXTI->FTSR |= LL_EXTI_LINE_0;
+    TIM2->PSC = 71U;
+    TIM2->ARR = 4U;
+    LL_SYSTICK_EnableIT();
+
+    //devices connected to the SPI buses
+    hostADXL345initialise((const int16_t (*)[HOST_ADXL_NB_AXIS])_samples, _nbSamples);
+    hostSSD1306initialise(screenWritten);
+
+    eventsInitialise();
+    spiBusInitialise(SPI_BUS_1, SPI1, DMA1, LL_DMA_CHANNEL_3, LL_DMA_CHANNEL_2);
+    spiBusInitialise(SPI_BUS_2, SPI2, DMA1, LL_DMA_CHANNEL_5, SPI_NO_DMA_CHANNEL);
+
+    LL_RTC_BKP_SetRegister(BKP, LL_RTC_BKP_DR1, SELF_TEST_PASSED_RECORD);
+    ADXL345initialise(SPI_BUS_1, TIM2, ADXL_BOOT_WARM);
+    ADXL345setProfile(ADXL_PROFILE_ADAPTIVE);
+    SSD1306initialise(SPI_BUS_2);
+
+    schedulerRegister(TASK_ACCELEROMETER, accelerometerTask, 10);
+    schedulerRegister(TASK_SCREEN, SSD1306update, 5);
+    schedulerRegister(TASK_APPLICATION, applicationTask, 10);
+}
+
+/**
+ * @brief Check the angles displayed against the ones expected at a checkpoint
+ *
+ * @param checkpoint Checkpoint reached
+ * @retval 0 An angle is not displayed, or deviates from the expected one by more than the tolerance
+ * @retval 1 Angles displayed as expected
+ */
+static uint8_t checkDisplay(const checkpoint_t* checkpoint){
+    static const char* AXIS_NAMES[NB_ROTATIONS] = {[ROLL] = "roll", [PITCH] = "pitch"};
+    uint8_t matched = 1;
+
+    for(uint8_t axis = 0 ; axis < NB_ROTATIONS ; axis++){
+        int16_t tenths;
+
+        if(!decodeAngle((rotationAxis_e)axis, &tenths)){
+            printf("  %u ms : %s not displayed (%d expected)\n", (unsigned)checkpoint->timestamp_ms, AXIS_NAMES[axis], checkpoint->tenths[axis]);
+            matched = 0;
+            continue;
+        }
+
+        int16_t deviation = (int16_t)(tenths - checkpoint->tenths[axis]);
+        uint8_t passed = ((deviation <= CHECKPOINT_TOLERANCE_TENTHS) && (deviation >= -CHECKPOINT_TOLERANCE_TENTHS));
+        printf("  %u ms : %s displayed %d, expected %d (tenths of degrees) : %s\n", (unsigned)checkpoint->timestamp_ms,
+               AXIS_NAMES[axis], tenths, checkpoint->tenths[axis], (passed ? "PASSED" : "FAILED"));
+        matched &= passed;
+    }
+
+    return (matched);
+}
+
+/**
+ * @brief Decode the angle displayed by the screen model, from the glyphs of the numbers font
+ *
+ * @param axis			Axis of which decode the angle
+ * @param[out] tenths	Angle displayed (in tenths of degrees)
+ * @retval 0 No angle in degrees displayed (unknown glyph, or not formatted as renderAngle() does)
+ * @retval 1 Angle decoded
+ */
+static uint8_t decodeAngle(rotationAxis_e axis, int16_t* tenths){
+    static const uint8_t ANGLE_PAGES[NB_ROTATIONS] = {[ROLL] = 1U, [PITCH] = 5U};
+    const uint8_t* ram = hostSSD1306getRAM();
+    uint8_t glyphs[ANGLE_NB_CHARS];
+
+    //find the glyph displayed at each character position (stored page by page, then column by column)
+    for(uint8_t character = 0 ; character < ANGLE_NB_CHARS ; character++){
+        uint8_t column = (uint8_t)(ANGLE_COLUMN + (character * VERDANA_WIDTH));
+        uint8_t glyph;
+
+        for(glyph = 0 ; glyph < NB_NUMBERS ; glyph++){
+            uint8_t same = 1;
+
+            for(uint8_t page = 0 ; (page < VERDANA_NB_PAGES) && same ; page++)
+                same = !memcmp(&ram[((ANGLE_PAGES[axis] + page) * HOST_SSD_NB_COLUMNS) + column], &verdana_16ptNumbers[glyph][page * VERDANA_WIDTH], VERDANA_WIDTH);
+            if(same)
+                break;
+        }
+        if(glyph >= NB_NUMBERS)
+            return (0);
+
+        glyphs[character] = glyph;
+    }
+
+    //sign, number field (digits, with or without the dot and the tenths) and unit
+    if(((glyphs[0] != INDEX_PLUS) && (glyphs[0] != INDEX_MINUS)) || (glyphs[ANGLE_NB_CHARS - 1U] != INDEX_DEG))
+        return (0);
+
+    int32_t value = 0;
+    uint8_t dot = 0;
+    for(uint8_t character = 1 ; character < (ANGLE_NB_CHARS - 1U) ; character++){
+        if(glyphs[character] <= INDEX_9)
+            value = (value * 10) + glyphs[character];
+        else if(glyphs[character] == INDEX_DOT)
+            dot = 1;
+        else if(glyphs[character] != INDEX_SPACE)
+            return (0);
+    }
+
+    *tenths = (int16_t)((glyphs[0] == INDEX_MINUS ? -1 : 1) * (dot ? value : (value * 10)));
+    return (1);
+}
+
+/**
+ * @brief Record the latency of the angles printed which the screen displays once a data transfer ended
+ * @note Called by the screen model (chip released)
+ */
+static void screenWritten(){
+    for(uint8_t axis = 0 ; axis < NB_ROTATIONS ; axis++){
+        pixelProbe_t* probe = &_probes[axis];
+        int16_t tenths;
+
+        if(probe->pending && decodeAngle((rotationAxis_e)axis, &tenths) && (tenths == probe->tenths)){
+            benchmarkRecord(BENCH_WATERMARK_TO_PIXEL, (uint32_t)(hostCycles() - probe->watermark));
+            probe->pending = 0;
+        }
+    }
+}
+
+/**
+ * @brief Run the ADXL345 state machine, and signal the application when a new snapshot is published
+ *
+ * @return Return code of the state machine
+ */
+static errorCode_u accelerometerTask(){
+    uint32_t sequence = ADXL345getSnapshot()->sequence;
+    errorCode_u result = ADXL345update();
+
+    if(ADXL345getSnapshot()->sequence != sequence){
+        _batchWatermark = hostADXL345getWatermarkCycles();
+        schedulerSignal(TASK_APPLICATION);
+    }
+
+    return (result);
+}
+
+/**
+ * @brief Print the angles of the latest snapshot (if they changed), and start measuring their latency
+ *
+ * @return Success
+ */
+static errorCode_u applicationTask(){
+    const adxlSnapshot_t* snapshot = ADXL345getSnapshot();
+
+    if(snapshot->sequence == _printedSequence)
+        return (ERR_SUCCESS);
+    _printedSequence = snapshot->sequence;
+
+    const int16_t angles[NB_ROTATIONS] = {[ROLL] = snapshot->rollTenths, [PITCH] = snapshot->pitchTenths};
+    for(uint8_t axis = 0 ; axis < NB_ROTATIONS ; axis++){
+        if(angles[axis] == _printedTenths[axis])
+            continue;
+
+        SSD1306_printMeasureTenths(angles[axis], (rotationAxis_e)axis, UNIT_DEGREES);
+        _printedTenths[axis] = angles[axis];
+        _probes[axis] = (pixelProbe_t){.pending = 1, .tenths = angles[axis], .watermark = _batchWatermark};
+    }
+
+    return (ERR_SUCCESS);
+}
+
+/**
+ * @brief Print the statistics of all the metrics, followed by the accuracy verdict
+ */
+static void printResults(){
+    static const char* METRIC_NAMES[NB_BENCH_METRICS] = {
+        [BENCH_INTEGRATE_FIFO]		= "BENCH_INTEGRATE_FIFO",
+        [BENCH_ANGLE]				= "BENCH_ANGLE",
+        [BENCH_ANGLE_ERROR]			= "BENCH_ANGLE_ERROR",
+        [BENCH_RENDER_ANGLE]		= "BENCH_RENDER_ANGLE",
+        [BENCH_RENDER_BUBBLE]		= "BENCH_RENDER_BUBBLE",
+        [BENCH_RENDER_GRAPH]		= "BENCH_RENDER_GRAPH",
+        [BENCH_SAMPLE_TO_PIXEL]		= "BENCH_SAMPLE_TO_PIXEL",
+        [BENCH_WATERMARK_TO_PIXEL]	= "BENCH_WATERMARK_TO_PIXEL",
+    };
+
+    printf("%-24s %10s %10s %10s %10s\n", "metric", "samples", "min", "max", "mean");
+    for(uint8_t metric = 0 ; metric < NB_BENCH_METRICS ; metric++){
+        const benchmarkResult_t* result = benchmarkGetResult((benchmarkMetric_e)metric);
+
+        printf("%-24s %10u %10u %10u %10u\n", METRIC_NAMES[metric], result->nbSamples,
+               (result->nbSamples ? result->minimum : 0U), result->maximum,
+               (result->nbSamples ? (uint32_t)(result->total / result->nbSamples) : 0U));
+    }
+
+    printf("angle kernel deviation : %u tenths of degrees at most (tolerance %u) : %s\n",
+           benchmarkGetResult(BENCH_ANGLE_ERROR)->maximum, BENCHMARK_ANGLE_TOLERANCE, (benchmarkPassed() ? "PASSED" : "FAILED"));
+}
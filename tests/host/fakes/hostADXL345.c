@@ -0,0 +1,322 @@
+/**
+ * @file hostADXL345.c
+ * @brief Model of the ADXL345 accelerometer connected to SPI1, measuring the samples of a trace
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The registers are read and written as on the device : byte 0 of a transaction holds the read and multiple bits
+ * and the first register number, the following ones are exchanged with the registers (auto-incremented if multiple).
+ *
+ * Once in measurement mode (POWER CONTROL), one sample of the trace is measured per output data period (BW RATE),
+ * and stored in the 32 entries FIFO (FIFO CONTROL mode). The last sample is repeated once the trace is exhausted.
+ * The data registers show the oldest FIFO entry, which is popped once a transaction including them ends.
+ *
+ * The interrupt sources are the data ready, watermark and overrun ones :
+ *   - the watermark is reached with one entry more than the samples field (as noted in ADXL345registers.h)
+ *   - the overrun is latched when a sample is lost (FIFO full), and cleared once the data registers are read
+ * Their enabled and mapped ones drive INT1 (PB0), with the polarity of DATA FORMAT.
+ *
+ * Not modelled : the activity, inactivity, tap and free-fall detections, the self-test and the offsets.
+ */
+#include "hostADXL345.h"
+#include "stm32f1xx_ll_gpio.h"
+#include "ADXL345registers.h"
+
+//definitions
+#define FIFO_DEPTH			32U		///< Number of entries of the FIFO
+#define FIFO_MODE_MASK		0xC0U	///< Mask of the mode in FIFO CONTROL
+#define FIFO_SAMPLES_MASK	0x1FU	///< Mask of the samples field in FIFO CONTROL
+#define RATE_MASK			0x0FU	///< Mask of the rate code in BW RATE
+#define RATE_CODE_3200HZ	0x0FU	///< Rate code of the highest output data rate (3200Hz)
+#define RATE_3200HZ			3200U	///< Highest output data rate (in Hz)
+#define RESET_BW_RATE		0x0AU	///< BW RATE value at power-up (100Hz)
+
+//SPI device functions
+static void selected();
+static uint8_t exchanged(uint8_t byte);
+static void released();
+
+//tool functions
+static uint8_t readRegister(uint8_t address);
+static void writeRegister(uint8_t address, uint8_t value);
+static void restartMeasurements();
+static void measure(hostEvent_e event);
+static uint8_t interruptSources();
+static void updateINT1();
+
+//state variables
+static const hostSPIdevice_t ADXL345_DEVICE = {selected, exchanged, released};	///< SPI device connected to SPI1
+static uint8_t			_registers[ADXL_REGISTER_MAXNB];	///< Registers values
+static int16_t			_fifo[FIFO_DEPTH][HOST_ADXL_NB_AXIS];	///< FIFO entries (circular buffer)
+static uint8_t			_fifoFirst = 0;			///< Index of the oldest FIFO entry
+static uint8_t			_fifoCount = 0;			///< Number of FIFO entries stored
+static int16_t			_latest[HOST_ADXL_NB_AXIS];	///< Latest sample measured (shown when the FIFO is empty)
+static uint8_t			_overrun = 0;			///< Flag indicating a sample has been lost
+static const int16_t	(*_trace)[HOST_ADXL_NB_AXIS] = NULL;	///< Samples of the trace measured
+static uint32_t			_traceLength = 0;		///< Number of samples in the trace
+static uint32_t			_measured = 0;			///< Number of samples measured so far
+static uint64_t			_period = 0;			///< Output data period applied (in cycles, 0 if in standby)
+static uint8_t			_byteIndex = 0;			///< Index of the byte exchanged in the current transaction
+static uint8_t			_address = 0;			///< Register exchanged with the next byte
+static uint8_t			_reading = 0;			///< Flag indicating the current transaction reads the registers
+static uint8_t			_multiple = 0;			///< Flag indicating the register number is incremented after each byte
+static uint8_t			_dataRead = 0;			///< Flag indicating the data registers have been read in the current transaction
+static uint8_t			_int1Sources = 0;		///< Interrupt sources currently driving INT1
+static uint64_t			_watermarkCycles = 0;	///< Simulated clock at which the watermark has been reached for the latest time
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Power the ADXL up and connect it to SPI1
+ *
+ * @param samples	Samples to measure (X, Y, Z raw values)
+ * @param nbSamples	Number of samples
+ */
+void hostADXL345initialise(const int16_t samples[][HOST_ADXL_NB_AXIS], uint32_t nbSamples){
+    for(uint8_t i = 0 ; i < ADXL_REGISTER_MAXNB ; i++)
+        _registers[i] = 0;
+    _registers[DEVICE_ID] = ADXL_DEVICE_ID;
+    _registers[BANDWIDTH_POWERMODE] = RESET_BW_RATE;
+
+    _trace = samples;
+    _traceLength = nbSamples;
+    _measured = 0;
+    _fifoFirst = _fifoCount = 0;
+    _overrun = 0;
+    _period = 0;
+
+    hostSPIattach(SPI1, &ADXL345_DEVICE);
+    updateINT1();
+}
+
+/**
+ * @brief Get the number of samples measured so far
+ *
+ * @return Number of samples (the trace is exhausted once it reaches its length)
+ */
+uint32_t hostADXL345getMeasured(){
+    return (_measured);
+}
+
+/**
+ * @brief Get the moment at which the watermark interrupt has been raised for the latest time
+ *
+ * @return Simulated clock (in cycles)
+ */
+uint64_t hostADXL345getWatermarkCycles(){
+    return (_watermarkCycles);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Start a transaction (chip selected)
+ */
+static void selected(){
+    _byteIndex = 0;
+    _dataRead = 0;
+}
+
+/**
+ * @brief Exchange a byte of the current transaction
+ *
+ * @param byte Byte received
+ * @return Byte sent back (register value when reading, 0xFF otherwise)
+ */
+static uint8_t exchanged(uint8_t byte){
+    uint8_t reply = 0xFFU;
+
+    //the first byte holds the access type and the first register
+    if(!_byteIndex++){
+        _reading = ((byte & ADXL_READ) == ADXL_READ);
+        _multiple = ((byte & ADXL_MULTIPLE) == ADXL_MULTIPLE);
+        _address = (uint8_t)(byte & ~(ADXL_READ | ADXL_MULTIPLE));
+        return (reply);
+    }
+
+    if(_reading)
+        reply = readRegister(_address);
+    else
+        writeRegister(_address, byte);
+
+    if(_multiple)
+        _address++;
+    return (reply);
+}
+
+/**
+ * @brief End a transaction (chip released), popping the oldest FIFO entry if the data registers have been read
+ */
+static void released(){
+    if(_dataRead && _fifoCount){
+        _fifoFirst = (uint8_t)((_fifoFirst + 1U) % FIFO_DEPTH);
+        _fifoCount--;
+    }
+    if(_dataRead)
+        _overrun = 0;
+
+    updateINT1();
+}
+
+/**
+ * @brief Read a register
+ *
+ * @param address Register number
+ * @return Register value
+ */
+static uint8_t readRegister(uint8_t address){
+    if((address >= DATA_X0) && (address <= DATA_Z1)){
+        const int16_t* entry = (_fifoCount ? _fifo[_fifoFirst] : _latest);
+        uint8_t index = (uint8_t)(address - DATA_X0);
+        uint16_t value = (uint16_t)entry[index >> 1];
+
+        _dataRead = 1;
+        return ((uint8_t)((index & 1U) ? (value >> 8) : value));
+    }
+
+    switch(address){
+        case INTERRUPT_SOURCE:
+            return (interruptSources());
+
+        case FIFO_STATUS:
+            return ((uint8_t)(_fifoCount & ADXL_FIFO_ENTRIES));
+
+        default:
+            return ((address < ADXL_REGISTER_MAXNB) ? _registers[address] : 0);
+    }
+}
+
+/**
+ * @brief Write a register, and apply its value
+ *
+ * @param address	Register number
+ * @param value		Register value
+ */
+static void writeRegister(uint8_t address, uint8_t value){
+    if((address >= ADXL_REGISTER_MAXNB) || (address == DEVICE_ID) || (address == INTERRUPT_SOURCE) || (address == FIFO_STATUS))
+        return;
+    if((address >= DATA_X0) && (address <= DATA_Z1))
+        return;
+
+    _registers[address] = value;
+
+    switch(address){
+        //the bypass mode clears the FIFO
+        case FIFO_CONTROL:
+            if((value & FIFO_MODE_MASK) == ADXL_MODE_BYPASS)
+                _fifoFirst = _fifoCount = 0;
+            break;
+
+        case BANDWIDTH_POWERMODE:
+        case POWER_CONTROL:
+            restartMeasurements();
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Restart the measurements if the measurement mode or the output data rate changed
+ */
+static void restartMeasurements(){
+    uint64_t period = 0;
+
+    if(_registers[POWER_CONTROL] & ADXL_MEASURE_MODE){
+        uint8_t code = (_registers[BANDWIDTH_POWERMODE] & RATE_MASK);
+        period = ((uint64_t)SystemCoreClock << (RATE_CODE_3200HZ - code)) / RATE_3200HZ;
+    }
+
+    if(period == _period)
+        return;
+
+    _period = period;
+    if(period)
+        hostSchedule(HOST_EVENT_SENSOR, period, period, measure);
+    else
+        hostCancel(HOST_EVENT_SENSOR);
+}
+
+/**
+ * @brief Measure the next sample of the trace, and store it in the FIFO
+ *
+ * @param event Event fired
+ */
+static void measure(hostEvent_e event){
+    (void)event;
+
+    if(!_traceLength)
+        return;
+
+    uint32_t index = ((_measured < _traceLength) ? _measured : (_traceLength - 1U));
+    for(uint8_t axis = 0 ; axis < HOST_ADXL_NB_AXIS ; axis++)
+        _latest[axis] = _trace[index][axis];
+    _measured++;
+
+    //in bypass mode, only the data registers are updated
+    uint8_t mode = (_registers[FIFO_CONTROL] & FIFO_MODE_MASK);
+    if(mode == ADXL_MODE_BYPASS){
+        updateINT1();
+        return;
+    }
+
+    //when full, the FIFO mode drops the new sample, the other ones drop the oldest entry
+    if(_fifoCount >= FIFO_DEPTH){
+        _overrun = 1;
+        if(mode == ADXL_MODE_FIFO){
+            updateINT1();
+            return;
+        }
+
+        _fifoFirst = (uint8_t)((_fifoFirst + 1U) % FIFO_DEPTH);
+        _fifoCount--;
+    }
+
+    int16_t* entry = _fifo[(_fifoFirst + _fifoCount) % FIFO_DEPTH];
+    for(uint8_t axis = 0 ; axis < HOST_ADXL_NB_AXIS ; axis++)
+        entry[axis] = _latest[axis];
+    _fifoCount++;
+
+    updateINT1();
+}
+
+/**
+ * @brief Get the interrupt sources currently active
+ *
+ * @return INT SOURCE register value
+ */
+static uint8_t interruptSources(){
+    uint8_t sources = 0;
+    uint8_t mode = (_registers[FIFO_CONTROL] & FIFO_MODE_MASK);
+
+    if(_fifoCount)
+        sources |= ADXL_INT_DATARDY;
+    if((mode != ADXL_MODE_BYPASS) && (_fifoCount > (_registers[FIFO_CONTROL] & FIFO_SAMPLES_MASK)))
+        sources |= ADXL_INT_WATERMARK;
+    if(_overrun)
+        sources |= ADXL_INT_OVERRUN;
+
+    return (sources);
+}
+
+/**
+ * @brief Drive INT1 with the interrupt sources enabled and mapped to it
+ */
+static void updateINT1(){
+    uint8_t sources = (interruptSources() & _registers[INTERRUPT_ENABLE] & (uint8_t)~_registers[INTERRUPT_MAPPING]);
+    uint8_t activeLow = ((_registers[DATA_FORMAT] & ADXL_INT_ACTIV_LOW) == ADXL_INT_ACTIV_LOW);
+
+    if((sources & ADXL_INT_WATERMARK) && !(_int1Sources & ADXL_INT_WATERMARK))
+        _watermarkCycles = hostCycles();
+
+    _int1Sources = sources;
+    hostSetInputPin(GPIOB, LL_GPIO_PIN_0, (uint8_t)(sources ? !activeLow : activeLow));
+}
@@ -0,0 +1,17 @@
+/**
+ * @file hostADXL345.h
+ * @brief Model of the ADXL345 accelerometer connected to SPI1, measuring the samples of a trace
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_HOSTADXL345_H_
+#define TESTS_HOST_FAKES_HOSTADXL345_H_
+#include "hostDevice.h"
+
+#define HOST_ADXL_NB_AXIS	3U	///< Number of axis of a sample (X, Y, Z)
+
+void hostADXL345initialise(const int16_t samples[][HOST_ADXL_NB_AXIS], uint32_t nbSamples);
+uint32_t hostADXL345getMeasured();
+uint64_t hostADXL345getWatermarkCycles();
+
+#endif /* TESTS_HOST_FAKES_HOSTADXL345_H_ */
@@ -0,0 +1,493 @@
+/**
+ * @file hostDevice.c
+ * @brief Implement the RAM-backed peripherals of the host build, the simulated clock and the peripherals simulation
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The peripherals start in their idle state : the SPI transmit buffers are empty,
+ * and the input pins are pulled up (the ADXL345 INT1 and the buttons are active low).
+ *
+ * The simulated clock never reads the host time : the drivers are built with -finstrument-functions,
+ * so each of their function calls (inlined ones included) spends HOST_CALL_CYCLES,
+ * and each fake LL function spends HOST_ACCESS_CYCLES. The fakes, the harness and the profiler are excluded,
+ * so that measuring does not add to the durations measured. The library calls (libm) are not counted.
+ * The durations are therefore deterministic, and comparable from one host build to the next, not to the target ones.
+ *
+ * Each time the clock advances, the events due are fired and the interrupts pending are served (if unmasked).
+ * The interrupt flags clear registers (DMA IFCR) are written directly by the drivers : they are applied on the next cycles spent.
+ *
+ * The SPI buses are wired as in main() : SPI1 (ADXL345) on the DMA1 channels 3 (TX) and 2 (RX), prescaled by 16 on APB2,
+ * and SPI2 (SSD1306) on the DMA1 channel 5 (TX only), prescaled by 2 on APB1. Only the EXTI line 0 (PB0, falling edge) is wired.
+ */
+#include "hostDevice.h"
+#include "stm32f1xx_ll_dma.h"
+#include "stm32f1xx_ll_exti.h"
+#include "stm32f1xx_ll_gpio.h"
+
+//definitions
+#define INPUTS_PULLED_UP		0x0000FFFFU		///< Input data register value with all the pins pulled up
+#define DMA_CHANNEL_FLAGS		4U				///< Number of flags of each DMA channel in the ISR and IFCR registers
+#define DMA_CHANNEL_MASK		0x0000000FU		///< Mask of all the flags of the DMA channel 1
+#define SPI1_BYTE_CYCLES		128U			///< CPU cycles to shift a byte on SPI1 (72MHz APB2, prescaled by 16)
+#define SPI2_BYTE_CYCLES		32U				///< CPU cycles to shift a byte on SPI2 (36MHz APB1, prescaled by 2)
+#define SYSTICK_HZ				1000U			///< SysTick frequency (LL_Init1msTick())
+
+/**
+ * @brief Structure holding an event scheduled
+ */
+typedef struct{
+    uint64_t			due;		///< Simulated clock at which the event fires
+    uint64_t			period;		///< Number of cycles after which the event is armed again (0 if one-shot)
+    hostEventHandler	handler;	///< Function called when the event fires (NULL if not armed)
+}hostEventSlot_t;
+
+/**
+ * @brief Structure holding the wiring and the state of an SPI bus
+ */
+typedef struct{
+    SPI_TypeDef*			handle;		///< SPI peripheral
+    uint32_t				channelTX;	///< DMA1 transmission channel
+    uint32_t				channelRX;	///< DMA1 reception channel (0 if none)
+    uint32_t				byteCycles;	///< CPU cycles to shift a byte
+    hostEvent_e				event;		///< Event signalling the end of the transfer
+    const hostSPIdevice_t*	device;		///< Device connected to the bus (NULL if none)
+}hostSPIbus_t;
+
+//instrumentation hooks called by gcc on each function entry and exit
+void __cyg_profile_func_enter(void* function, void* caller);
+void __cyg_profile_func_exit(void* function, void* caller);
+
+//tool functions
+static void fireEvents();
+static void applyClearRegisters();
+static void transferEnded(hostEvent_e event);
+static void channelTransferred(DMA_Channel_TypeDef* channel, uint32_t channelNumber);
+static void timerUpdated(hostEvent_e event);
+static void sysTickElapsed(hostEvent_e event);
+
+GPIO_TypeDef	hostGPIOA = {.IDR = INPUTS_PULLED_UP};
+GPIO_TypeDef	hostGPIOB = {.IDR = INPUTS_PULLED_UP};
+GPIO_TypeDef	hostGPIOC = {.IDR = INPUTS_PULLED_UP};
+SPI_TypeDef		hostSPI1 = {.SR = SPI_SR_TXE};
+SPI_TypeDef		hostSPI2 = {.SR = SPI_SR_TXE};
+DMA_TypeDef		hostDMA1;
+TIM_TypeDef		hostTIM2;
+USART_TypeDef	hostUSART2;
+BKP_TypeDef		hostBKP;
+IWDG_TypeDef	hostIWDG;
+EXTI_TypeDef	hostEXTI;
+CoreDebug_Type	hostCoreDebug;
+DBGMCU_TypeDef	hostDBGMCU;
+ITM_Type		hostITM;
+uint32_t		hostPRIMASK = 0;
+uint32_t		hostExclusiveMonitor = 0;
+uint32_t		SystemCoreClock = 72000000U;
+
+//state variables
+static DWT_Type			_dwt;							///< Data watchpoint and trace unit registers
+static uint64_t			_cycles = 0;					///< Simulated clock (in cycles since the start)
+static uint64_t			_lastAccess = 0;				///< Simulated clock at the previous access to the DWT
+static hostEventSlot_t	_events[HOST_NB_EVENTS];		///< Events scheduled
+static uint8_t			_firing = 0;					///< Flag indicating events are being fired
+static uint32_t			_pendingIRQs = 0;				///< Bit field of the interrupts pending (indexed by hostIRQ_e)
+static uint8_t			_inHandler = 0;					///< Flag indicating an interrupt handler is running
+static hostSPIbus_t		_spiBuses[] = {
+    {SPI1, LL_DMA_CHANNEL_3, LL_DMA_CHANNEL_2, SPI1_BYTE_CYCLES, HOST_EVENT_SPI1, NULL},
+    {SPI2, LL_DMA_CHANNEL_5, 0, SPI2_BYTE_CYCLES, HOST_EVENT_SPI2, NULL},
+};
+static void (*const VECTORS[HOST_NB_IRQS])(void) = {	///< Interrupt handlers, by priority
+    [HOST_IRQ_EXTI0]			= EXTI0_IRQHandler,
+    [HOST_IRQ_DMA1_CHANNEL2]	= DMA1_Channel2_IRQHandler,
+    [HOST_IRQ_DMA1_CHANNEL5]	= DMA1_Channel5_IRQHandler,
+    [HOST_IRQ_TIM2]				= TIM2_IRQHandler,
+    [HOST_IRQ_SYSTICK]			= SysTick_Handler,
+};
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Get the DWT registers, with the cycle counter advanced by the simulated cycles spent since the previous access
+ * @note The counter only runs once enabled (DWT_CTRL_CYCCNTENA_Msk), and wraps around as on the target
+ *
+ * @return DWT registers
+ */
+DWT_Type* hostDWT(){
+    if(_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+        _dwt.CYCCNT += (uint32_t)(_cycles - _lastAccess);
+
+    _lastAccess = _cycles;
+    return (&_dwt);
+}
+
+/**
+ * @brief Advance the simulated clock, fire the events due and serve the interrupts pending
+ *
+ * @param cycles Number of cycles spent
+ */
+void hostSpend(uint32_t cycles){
+    _cycles += cycles;
+    applyClearRegisters();
+    fireEvents();
+    hostServeInterrupts();
+}
+
+/**
+ * @brief Get the simulated clock
+ *
+ * @return Number of cycles spent since the start
+ */
+uint64_t hostCycles(){
+    return (_cycles);
+}
+
+/**
+ * @brief Serve the interrupts pending, by priority, unless they are masked or a handler is already running
+ */
+void hostServeInterrupts(){
+    if(_inHandler)
+        return;
+
+    while(_pendingIRQs && !hostPRIMASK){
+        hostIRQ_e irq = (hostIRQ_e)__builtin_ctz(_pendingIRQs);
+
+        _pendingIRQs &= ~(1U << irq);
+        _inHandler = 1;
+        hostExclusiveMonitor = 0;
+        _cycles += HOST_IRQ_CYCLES;
+        (*VECTORS[irq])();
+        _inHandler = 0;
+    }
+}
+
+/**
+ * @brief Sleep until an interrupt is pending (even masked, as WFI does), the clock skipping to the next events
+ * @note Returns right away if no event is scheduled, as nothing could wake the core up
+ */
+void hostWaitForInterrupt(){
+    while(!_pendingIRQs){
+        uint64_t next = UINT64_MAX;
+
+        for(uint8_t event = 0 ; event < HOST_NB_EVENTS ; event++){
+            if(_events[event].handler && (_events[event].due < next))
+                next = _events[event].due;
+        }
+        if(next == UINT64_MAX)
+            return;
+
+        if(next > _cycles)
+            _cycles = next;
+        applyClearRegisters();
+        fireEvents();
+    }
+
+    hostServeInterrupts();
+}
+
+/**
+ * @brief Schedule an event, replacing the previous one (if any)
+ *
+ * @param event		Event to schedule
+ * @param delay		Number of cycles from now after which the event fires
+ * @param period	Number of cycles after which the event fires again (0 if one-shot)
+ * @param handler	Function to call when the event fires
+ */
+void hostSchedule(hostEvent_e event, uint64_t delay, uint64_t period, hostEventHandler handler){
+    if(event >= HOST_NB_EVENTS)
+        return;
+
+    _events[event] = (hostEventSlot_t){
+        .due = _cycles + delay,
+        .period = period,
+        .handler = handler,
+    };
+}
+
+/**
+ * @brief Cancel an event scheduled
+ *
+ * @param event Event to cancel
+ */
+void hostCancel(hostEvent_e event){
+    if(event < HOST_NB_EVENTS)
+        _events[event].handler = NULL;
+}
+
+/**
+ * @brief Make an interrupt pending
+ *
+ * @param irq Interrupt to raise
+ */
+void hostRaiseIRQ(hostIRQ_e irq){
+    if(irq < HOST_NB_IRQS)
+        _pendingIRQs |= (1U << irq);
+}
+
+/**
+ * @brief Start the SysTick interrupt, every millisecond
+ * @note Called by LL_SYSTICK_EnableIT()
+ */
+void hostEnableSysTick(){
+    uint64_t period = SystemCoreClock / SYSTICK_HZ;
+
+    hostSchedule(HOST_EVENT_SYSTICK, period, period, sysTickElapsed);
+}
+
+/**
+ * @brief Connect a device to an SPI bus
+ *
+ * @param spi		SPI bus
+ * @param device	Device to connect
+ */
+void hostSPIattach(SPI_TypeDef* spi, const hostSPIdevice_t* device){
+    for(uint8_t bus = 0 ; bus < (sizeof(_spiBuses) / sizeof(_spiBuses[0])) ; bus++){
+        if(_spiBuses[bus].handle == spi)
+            _spiBuses[bus].device = device;
+    }
+}
+
+/**
+ * @brief Start the DMA transfer of an SPI bus, which ends once all its bytes are shifted
+ * @note Called by LL_SPI_EnableDMAReq_TX()
+ *
+ * @param spi SPI bus
+ */
+void hostSPIstart(SPI_TypeDef* spi){
+    for(uint8_t bus = 0 ; bus < (sizeof(_spiBuses) / sizeof(_spiBuses[0])) ; bus++){
+        const hostSPIbus_t* instance = &_spiBuses[bus];
+
+        if(instance->handle == spi){
+            uint32_t length = DMA1->CHANNEL[instance->channelTX - 1U].CNDTR;
+            hostSchedule(instance->event, (uint64_t)length * instance->byteCycles, 0, transferEnded);
+        }
+    }
+}
+
+/**
+ * @brief Stop the DMA transfer of an SPI bus (the bytes not shifted yet are not exchanged)
+ * @note Called by LL_SPI_DisableDMAReq_TX()
+ *
+ * @param spi SPI bus
+ */
+void hostSPIstop(SPI_TypeDef* spi){
+    for(uint8_t bus = 0 ; bus < (sizeof(_spiBuses) / sizeof(_spiBuses[0])) ; bus++){
+        if(_spiBuses[bus].handle == spi)
+            hostCancel(_spiBuses[bus].event);
+    }
+}
+
+/**
+ * @brief Start the TIM2 counter, which stops at the update event (one-pulse mode)
+ * @note Called by LL_TIM_EnableCounter()
+ *
+ * @param timer Timer to start
+ */
+void hostTimerStart(TIM_TypeDef* timer){
+    if(timer != TIM2)
+        return;
+
+    //TIM2 is clocked at 72MHz (APB1 timers clock doubled)
+    uint64_t delay = (uint64_t)(timer->PSC + 1U) * (timer->ARR + 1U);
+    hostSchedule(HOST_EVENT_TIM2, delay, 0, timerUpdated);
+}
+
+/**
+ * @brief Drive an input pin, and signal its falling edge on the EXTI line 0 (PB0) if enabled
+ *
+ * @param port	GPIO port of the pin
+ * @param pin	Pin mask
+ * @param level	Level to drive (0 : low, otherwise high)
+ */
+void hostSetInputPin(GPIO_TypeDef* port, uint32_t pin, uint8_t level){
+    uint8_t wasHigh = ((port->IDR & pin) == pin);
+
+    if(level)
+        port->IDR |= pin;
+    else
+        port->IDR &= ~pin;
+
+    if((port != GPIOB) || (pin != LL_GPIO_PIN_0) || !wasHigh || level)
+        return;
+
+    if(EXTI->FTSR & LL_EXTI_LINE_0){
+        EXTI->PR |= LL_EXTI_LINE_0;
+        if(EXTI->IMR & LL_EXTI_LINE_0)
+            hostRaiseIRQ(HOST_IRQ_EXTI0);
+    }
+}
+
+/**
+ * @brief Spend the call budget on each function entry of the drivers
+ *
+ * @param function Address of the function entered
+ * @param caller Address of the call
+ */
+void __cyg_profile_func_enter(void* function, void* caller){
+    (void)function;
+    (void)caller;
+    hostSpend(HOST_CALL_CYCLES);
+}
+
+/**
+ * @brief Function exit hook (the call budget is spent on entry)
+ *
+ * @param function Address of the function exited
+ * @param caller Address of the call
+ */
+void __cyg_profile_func_exit(void* function, void* caller){
+    (void)function;
+    (void)caller;
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Fire all the events due, by order of due time
+ * @note The handlers may schedule other events, fired as well if already due
+ */
+static void fireEvents(){
+    if(_firing)
+        return;
+
+    _firing = 1;
+    for(;;){
+        hostEventSlot_t* earliest = NULL;
+
+        for(uint8_t event = 0 ; event < HOST_NB_EVENTS ; event++){
+            hostEventSlot_t* slot = &_events[event];
+
+            if(slot->handler && (slot->due <= _cycles) && (!earliest || (slot->due < earliest->due)))
+                earliest = slot;
+        }
+        if(!earliest)
+            break;
+
+        //re-arm a periodic event from its due time (so that it does not drift), or disarm it
+        hostEventHandler handler = earliest->handler;
+        if(earliest->period)
+            earliest->due += earliest->period;
+        else
+            earliest->handler = NULL;
+
+        (*handler)((hostEvent_e)(earliest - _events));
+    }
+    _firing = 0;
+}
+
+/**
+ * @brief Apply the interrupt flags clear registers written by the drivers
+ */
+static void applyClearRegisters(){
+    uint32_t clear = DMA1->IFCR;
+
+    if(!clear)
+        return;
+
+    //the global flag clear bit of a channel clears all its flags
+    for(uint8_t channel = 0 ; channel < 7U ; channel++){
+        uint8_t shift = (uint8_t)(channel * DMA_CHANNEL_FLAGS);
+
+        if(clear & (DMA_IFCR_CGIF1 << shift))
+            clear |= (DMA_CHANNEL_MASK << shift);
+    }
+
+    DMA1->ISR &= ~clear;
+    DMA1->IFCR = 0;
+}
+
+/**
+ * @brief Exchange the bytes of the DMA transfer of an SPI bus with its device, then signal the transfer complete
+ *
+ * @param event Event of the bus of which the transfer ended
+ */
+static void transferEnded(hostEvent_e event){
+    const hostSPIbus_t* instance = NULL;
+
+    for(uint8_t bus = 0 ; bus < (sizeof(_spiBuses) / sizeof(_spiBuses[0])) ; bus++){
+        if(_spiBuses[bus].event == event)
+            instance = &_spiBuses[bus];
+    }
+
+    DMA_Channel_TypeDef* tx = &DMA1->CHANNEL[instance->channelTX - 1U];
+    DMA_Channel_TypeDef* rx = (instance->channelRX ? &DMA1->CHANNEL[instance->channelRX - 1U] : NULL);
+    if(!(tx->CCR & DMA_CCR_EN))
+        return;
+
+    //the DMA registers hold the addresses of the buffers, which the host build keeps below 4GB
+    const uint8_t* bytesTX = (const uint8_t*)(uintptr_t)tx->CMAR;
+    uint8_t* bytesRX = (rx ? (uint8_t*)(uintptr_t)rx->CMAR : NULL);
+    uint32_t length = tx->CNDTR;
+
+    if(instance->device && instance->device->select)
+        (*instance->device->select)();
+
+    for(uint32_t i = 0 ; i < length ; i++){
+        uint8_t reply = 0xFFU;
+
+        if(instance->device)
+            reply = (*instance->device->exchange)(bytesTX[(tx->CCR & DMA_CCR_MINC) ? i : 0]);
+        if(bytesRX)
+            bytesRX[(rx->CCR & DMA_CCR_MINC) ? i : 0] = reply;
+    }
+
+    if(instance->device && instance->device->release)
+        (*instance->device->release)();
+
+    //signal the completion of both channels (RX last, as on the bus), and restart a circular transfer
+    channelTransferred(tx, instance->channelTX);
+    if(rx)
+        channelTransferred(rx, instance->channelRX);
+
+    if(tx->CCR & DMA_CCR_CIRC)
+        hostSchedule(event, (uint64_t)length * instance->byteCycles, 0, transferEnded);
+}
+
+/**
+ * @brief Set the transfer complete flags of a DMA channel, and raise its interrupt if enabled
+ *
+ * @param channel		Channel registers
+ * @param channelNumber	Channel number (LL_DMA_CHANNEL_x)
+ */
+static void channelTransferred(DMA_Channel_TypeDef* channel, uint32_t channelNumber){
+    DMA1->ISR |= ((DMA_ISR_GIF1 | DMA_ISR_TCIF1) << ((channelNumber - 1U) * DMA_CHANNEL_FLAGS));
+    if(!(channel->CCR & DMA_CCR_CIRC))
+        channel->CNDTR = 0;
+
+    if(!(channel->CCR & DMA_CCR_TCIE))
+        return;
+
+    if(channelNumber == LL_DMA_CHANNEL_2)
+        hostRaiseIRQ(HOST_IRQ_DMA1_CHANNEL2);
+    else if(channelNumber == LL_DMA_CHANNEL_5)
+        hostRaiseIRQ(HOST_IRQ_DMA1_CHANNEL5);
+}
+
+/**
+ * @brief Stop the TIM2 counter at its update event, and raise its interrupt if enabled
+ *
+ * @param event Event fired
+ */
+static void timerUpdated(hostEvent_e event){
+    (void)event;
+
+    TIM2->CR1 &= ~TIM_CR1_CEN;
+    TIM2->SR |= TIM_SR_UIF;
+    if(TIM2->DIER & TIM_DIER_UIE)
+        hostRaiseIRQ(HOST_IRQ_TIM2);
+}
+
+/**
+ * @brief Raise the SysTick interrupt
+ *
+ * @param event Event fired
+ */
+static void sysTickElapsed(hostEvent_e event){
+    (void)event;
+    hostRaiseIRQ(HOST_IRQ_SYSTICK);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file hostDevice.h
+ * @brief Simulation of the peripherals of the host build : SPI transfers via DMA, timer, SysTick, EXTI and interrupts
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The peripherals act on the simulated clock (see stm32f1xx.h) : each one schedules an event when started
+ * (e.g. the end of a DMA transfer), which is fired once the clock reaches it. The events set the peripheral flags,
+ * then raise their interrupts, which are served as soon as they are unmasked (PRIMASK).
+ *
+ * The interrupt handlers are the ones of the vector table, which the harness implements as stm32f1xx_it.c does.
+ * They are served one at a time by priority, SysTick last (the peripherals ones never preempt each other, as configured by main()).
+ * The devices connected to the SPI buses (see hostADXL345.c and hostSSD1306.c) exchange the bytes of each transfer
+ * once it ends, their replies being stored by the reception channel.
+ */
+#ifndef TESTS_HOST_FAKES_HOSTDEVICE_H_
+#define TESTS_HOST_FAKES_HOSTDEVICE_H_
+#include "stm32f1xx.h"
+
+/**
+ * @brief Enumeration of the events scheduled by the peripherals
+ */
+typedef enum{
+    HOST_EVENT_SYSTICK = 0,	///< SysTick period elapsed
+    HOST_EVENT_SPI1,		///< End of the SPI1 DMA transfer
+    HOST_EVENT_SPI2,		///< End of the SPI2 DMA transfer
+    HOST_EVENT_TIM2,		///< TIM2 update event (end of the one-pulse delay)
+    HOST_EVENT_SENSOR,		///< Next sample measured by the accelerometer (see hostADXL345.c)
+    HOST_NB_EVENTS
+}hostEvent_e;
+
+/**
+ * @brief Enumeration of the interrupts simulated, by decreasing priority
+ */
+typedef enum{
+    HOST_IRQ_EXTI0 = 0,		///< EXTI line 0 (ADXL345 INT1)
+    HOST_IRQ_DMA1_CHANNEL2,	///< DMA1 channel 2 (SPI1 reception)
+    HOST_IRQ_DMA1_CHANNEL5,	///< DMA1 channel 5 (SPI2 transmission)
+    HOST_IRQ_TIM2,			///< TIM2 update
+    HOST_IRQ_SYSTICK,		///< SysTick (lowest priority)
+    HOST_NB_IRQS
+}hostIRQ_e;
+
+/**
+ * @brief Event handler prototype
+ *
+ * @param event Event fired
+ */
+typedef void (*hostEventHandler)(hostEvent_e event);
+
+/**
+ * @brief Structure defining a device connected to an SPI bus
+ */
+typedef struct{
+    void	(*select)();				///< Called when a transfer starts (chip selected)
+    uint8_t	(*exchange)(uint8_t byte);	///< Called for each byte of the transfer, returns the byte shifted back
+    void	(*release)();				///< Called when the transfer ends (chip released)
+}hostSPIdevice_t;
+
+//vector table (implemented by the harness)
+void SysTick_Handler(void);
+void EXTI0_IRQHandler(void);
+void DMA1_Channel2_IRQHandler(void);
+void DMA1_Channel5_IRQHandler(void);
+void TIM2_IRQHandler(void);
+
+void hostSchedule(hostEvent_e event, uint64_t delay, uint64_t period, hostEventHandler handler);
+void hostCancel(hostEvent_e event);
+void hostRaiseIRQ(hostIRQ_e irq);
+void hostEnableSysTick();
+void hostSPIattach(SPI_TypeDef* spi, const hostSPIdevice_t* device);
+void hostSPIstart(SPI_TypeDef* spi);
+void hostSPIstop(SPI_TypeDef* spi);
+void hostTimerStart(TIM_TypeDef* timer);
+void hostSetInputPin(GPIO_TypeDef* port, uint32_t pin, uint8_t level);
+
+#endif /* TESTS_HOST_FAKES_HOSTDEVICE_H_ */
@@ -0,0 +1,215 @@
+/**
+ * @file hostSSD1306.c
+ * @brief Model of the SSD1306 screen connected to SPI2, decoding the commands and storing the data in its RAM
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * The data/command pin is sampled when a transfer starts : the bytes are either commands (with their parameters),
+ * or data written in the RAM at the current column and page, in horizontal addressing mode.
+ * The column wraps to the start of the column window after its end, moving to the next page of the page window.
+ *
+ * The RAM is stored as the drivers framebuffer : page by page, then column by column.
+ *
+ * Not modelled : the reset pin (the panel is reset once, by hostSSD1306initialise()), the page and vertical addressing modes,
+ * the scrolling, the remaps and the display settings (only stored as commands).
+ */
+#include "hostSSD1306.h"
+#include "main.h"
+#include "SSD1306_registers.h"
+
+//definitions
+#define MAX_PARAMETERS		6U		///< Highest number of parameters of a command
+
+//SPI device functions
+static void selected();
+static uint8_t exchanged(uint8_t byte);
+static void released();
+
+//tool functions
+static uint8_t parametersCount(uint8_t command);
+static void executeCommand();
+static void writeData(uint8_t byte);
+
+//state variables
+static const hostSPIdevice_t SSD1306_DEVICE = {selected, exchanged, released};	///< SPI device connected to SPI2
+static uint8_t				_ram[HOST_SSD_NB_PAGES * HOST_SSD_NB_COLUMNS];	///< Display RAM
+static hostSSD1306callback	_dataWritten = NULL;	///< Function called once a data transfer ended
+static uint8_t				_data = 0;				///< Flag indicating the current transfer holds data (commands otherwise)
+static uint8_t				_command[MAX_PARAMETERS + 1U];	///< Command being received (command byte and parameters)
+static uint8_t				_commandLength = 0;		///< Number of bytes of the command received so far
+static uint8_t				_columns[2];			///< Column window (start and end)
+static uint8_t				_pages[2];				///< Page window (start and end)
+static uint8_t				_column = 0;			///< Column written with the next data byte
+static uint8_t				_page = 0;				///< Page written with the next data byte
+static uint8_t				_displayOn = 0;			///< Flag indicating the display is on
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Reset the screen and connect it to SPI2
+ *
+ * @param dataWritten Function to call once a data transfer ended (NULL if none)
+ */
+void hostSSD1306initialise(hostSSD1306callback dataWritten){
+    for(uint16_t i = 0 ; i < sizeof(_ram) ; i++)
+        _ram[i] = 0;
+
+    _dataWritten = dataWritten;
+    _commandLength = 0;
+    _columns[0] = _pages[0] = 0;
+    _columns[1] = HOST_SSD_NB_COLUMNS - 1U;
+    _pages[1] = HOST_SSD_NB_PAGES - 1U;
+    _column = _page = 0;
+    _displayOn = 0;
+
+    hostSPIattach(SPI2, &SSD1306_DEVICE);
+}
+
+/**
+ * @brief Get the display RAM
+ *
+ * @return RAM (page by page, then column by column)
+ */
+const uint8_t* hostSSD1306getRAM(){
+    return (_ram);
+}
+
+/**
+ * @brief Check if the display has been switched on
+ *
+ * @retval 0 Display off
+ * @retval 1 Display on
+ */
+uint8_t hostSSD1306isDisplayOn(){
+    return (_displayOn);
+}
+
+
+/********************************************************************************************************************************************/
+/********************************************************************************************************************************************/
+
+
+/**
+ * @brief Start a transfer (chip selected), sampling the data/command pin
+ */
+static void selected(){
+    _data = ((SSD1306_DC_GPIO_Port->ODR & SSD1306_DC_Pin) == SSD1306_DC_Pin);
+}
+
+/**
+ * @brief Handle a byte of the current transfer
+ *
+ * @param byte Byte received
+ * @return 0xFF (the screen never replies)
+ */
+static uint8_t exchanged(uint8_t byte){
+    if(_data){
+        writeData(byte);
+        return (0xFFU);
+    }
+
+    //gather the command with its parameters, then execute it
+    _command[_commandLength++] = byte;
+    if(_commandLength > parametersCount(_command[0])){
+        executeCommand();
+        _commandLength = 0;
+    }
+
+    return (0xFFU);
+}
+
+/**
+ * @brief End a transfer (chip released)
+ */
+static void released(){
+    if(_data && _dataWritten)
+        (*_dataWritten)();
+}
+
+/**
+ * @brief Get the number of parameters following a command byte
+ *
+ * @param command Command byte
+ * @return Number of parameters
+ */
+static uint8_t parametersCount(uint8_t command){
+    switch(command){
+        case MEMORY_ADDR_MODE:
+        case CONTRAST_CONTROL:
+        case CHG_PUMP_REGULATOR:
+        case MUX_RATIO:
+        case DISPLAY_OFFSET:
+        case CLOCK_DIVIDE_RATIO:
+        case PRECHARGE_PERIOD:
+        case HARDWARE_CONFIG:
+        case VCOMH_DESELECT_LVL:
+            return (1U);
+
+        case COLUMN_ADDRESS:
+        case PAGE_ADDRESS:
+        case SCROLL_VER_AREA:
+            return (2U);
+
+        case SCROLL_BOTH_RIGHT:
+        case SCROLL_BOTH_LEFT:
+            return (5U);
+
+        case SCROLL_HOR_RIGHT:
+        case SCROLL_HOR_LEFT:
+            return (6U);
+
+        default:
+            return (0);
+    }
+}
+
+/**
+ * @brief Execute the command received (only the addressing ones and the display switch are applied)
+ */
+static void executeCommand(){
+    switch(_command[0]){
+        case COLUMN_ADDRESS:
+            _columns[0] = (uint8_t)(_command[1] % HOST_SSD_NB_COLUMNS);
+            _columns[1] = (uint8_t)(_command[2] % HOST_SSD_NB_COLUMNS);
+            _column = _columns[0];
+            break;
+
+        case PAGE_ADDRESS:
+            _pages[0] = (uint8_t)(_command[1] % HOST_SSD_NB_PAGES);
+            _pages[1] = (uint8_t)(_command[2] % HOST_SSD_NB_PAGES);
+            _page = _pages[0];
+            break;
+
+        case DISPLAY_ON:
+            _displayOn = 1;
+            break;
+
+        case DISPLAY_OFF:
+            _displayOn = 0;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Write a data byte at the current position, then move to the next one in the windows
+ *
+ * @param byte Data byte
+ */
+static void writeData(uint8_t byte){
+    _ram[(_page * HOST_SSD_NB_COLUMNS) + _column] = byte;
+
+    if(_column < _columns[1]){
+        _column++;
+        return;
+    }
+
+    _column = _columns[0];
+    _page = ((_page < _pages[1]) ? (uint8_t)(_page + 1U) : _pages[0]);
+}
@@ -0,0 +1,23 @@
+/**
+ * @file hostSSD1306.h
+ * @brief Model of the SSD1306 screen connected to SPI2, decoding the commands and storing the data in its RAM
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_HOSTSSD1306_H_
+#define TESTS_HOST_FAKES_HOSTSSD1306_H_
+#include "hostDevice.h"
+
+#define HOST_SSD_NB_COLUMNS	128U	///< Number of columns of the screen
+#define HOST_SSD_NB_PAGES	8U		///< Number of pages of the screen (8 pixels high each)
+
+/**
+ * @brief Prototype of the function called once a data transfer ended
+ */
+typedef void (*hostSSD1306callback)();
+
+void hostSSD1306initialise(hostSSD1306callback dataWritten);
+const uint8_t* hostSSD1306getRAM();
+uint8_t hostSSD1306isDisplayOn();
+
+#endif /* TESTS_HOST_FAKES_HOSTSSD1306_H_ */
@@ -0,0 +1,252 @@
+/**
+ * @file stm32f1xx.h
+ * @brief Host replacement of the STM32F1 device header, with the peripherals backed by RAM
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ *
+ * @details
+ * Only the registers and bits used by the drivers built for the host are declared.
+ * The peripherals are plain variables (see hostDevice.c) : writing a register only stores the value.
+ * The fake LL functions which start the hardware (SPI DMA requests, timer counter, SysTick) hand over
+ * to the peripherals simulation of hostDevice.h, which carries out the transfers and raises the interrupts.
+ *
+ * Everything follows a simulated clock, advanced by a fixed budget for each function call of the drivers (HOST_CALL_CYCLES)
+ * and each access through the fake LL functions (HOST_ACCESS_CYCLES). The DWT cycle counter reads it.
+ * The durations measured are therefore the same on every host and every run, and only depend on the code paths taken.
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_H_
+#define TESTS_HOST_FAKES_STM32F1XX_H_
+#include <stdint.h>
+
+//standard headers which the drivers get through the toolchain ones pulled in by the CMSIS and LL headers
+#include <stddef.h>
+#include <assert.h>
+
+//simulated clock budgets (in cycles)
+#define HOST_CALL_CYCLES	24U		///< Cycles spent for each function call of the drivers (prologue, epilogue and an average body)
+#define HOST_ACCESS_CYCLES	3U		///< Cycles spent for each peripheral register access through the fake LL functions
+#define HOST_IRQ_CYCLES		12U		///< Cycles spent to enter an interrupt handler (Cortex-M3 exception latency)
+
+typedef struct{
+    volatile uint32_t CRL;
+    volatile uint32_t CRH;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t BRR;
+    volatile uint32_t LCKR;
+}GPIO_TypeDef;
+
+typedef struct{
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SR;
+    volatile uint32_t DR;
+    volatile uint32_t CRCPR;
+    volatile uint32_t RXCRCR;
+    volatile uint32_t TXCRCR;
+    volatile uint32_t I2SCFGR;
+}SPI_TypeDef;
+
+typedef struct{
+    volatile uint32_t CCR;
+    volatile uint32_t CNDTR;
+    volatile uint32_t CPAR;
+    volatile uint32_t CMAR;
+    uint32_t RESERVED;
+}DMA_Channel_TypeDef;
+
+//same layout as the hardware : the channels follow the interrupt registers
+typedef struct{
+    volatile uint32_t ISR;
+    volatile uint32_t IFCR;
+    DMA_Channel_TypeDef CHANNEL[7];
+}DMA_TypeDef;
+
+typedef struct{
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+}TIM_TypeDef;
+
+typedef struct{
+    volatile uint32_t SR;
+    volatile uint32_t DR;
+    volatile uint32_t BRR;
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t CR3;
+    volatile uint32_t GTPR;
+}USART_TypeDef;
+
+typedef struct{
+    volatile uint32_t DR[43];	///< Backup data registers, indexed by LL_RTC_BKP_DRx
+}BKP_TypeDef;
+
+typedef struct{
+    volatile uint32_t KR;
+    volatile uint32_t PR;
+    volatile uint32_t RLR;
+    volatile uint32_t SR;
+}IWDG_TypeDef;
+
+typedef struct{
+    volatile uint32_t IMR;
+    volatile uint32_t EMR;
+    volatile uint32_t RTSR;
+    volatile uint32_t FTSR;
+    volatile uint32_t SWIER;
+    volatile uint32_t PR;
+}EXTI_TypeDef;
+
+typedef struct{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+}DWT_Type;
+
+typedef struct{
+    volatile uint32_t DHCSR;
+    volatile uint32_t DCRSR;
+    volatile uint32_t DCRDR;
+    volatile uint32_t DEMCR;
+}CoreDebug_Type;
+
+typedef struct{
+    volatile uint32_t IDCODE;
+    volatile uint32_t CR;
+}DBGMCU_TypeDef;
+
+typedef struct{
+    volatile union{
+        uint8_t		u8;
+        uint16_t	u16;
+        uint32_t	u32;
+    }PORT[32];
+    volatile uint32_t TER;
+    volatile uint32_t TPR;
+    volatile uint32_t TCR;
+}ITM_Type;
+
+//peripherals instances (see hostDevice.c)
+extern GPIO_TypeDef		hostGPIOA, hostGPIOB, hostGPIOC;
+extern SPI_TypeDef		hostSPI1, hostSPI2;
+extern DMA_TypeDef		hostDMA1;
+extern TIM_TypeDef		hostTIM2;
+extern USART_TypeDef	hostUSART2;
+extern BKP_TypeDef		hostBKP;
+extern IWDG_TypeDef		hostIWDG;
+extern EXTI_TypeDef		hostEXTI;
+extern CoreDebug_Type	hostCoreDebug;
+extern DBGMCU_TypeDef	hostDBGMCU;
+extern ITM_Type			hostITM;
+extern uint32_t			hostPRIMASK;
+extern uint32_t			hostExclusiveMonitor;
+extern uint32_t			SystemCoreClock;
+
+DWT_Type* hostDWT();
+void hostSpend(uint32_t cycles);
+uint64_t hostCycles();
+void hostServeInterrupts();
+void hostWaitForInterrupt();
+
+#define GPIOA		(&hostGPIOA)
+#define GPIOB		(&hostGPIOB)
+#define GPIOC		(&hostGPIOC)
+#define SPI1		(&hostSPI1)
+#define SPI2		(&hostSPI2)
+#define DMA1		(&hostDMA1)
+#define TIM2		(&hostTIM2)
+#define USART2		(&hostUSART2)
+#define BKP			(&hostBKP)
+#define IWDG		(&hostIWDG)
+#define EXTI		(&hostEXTI)
+#define CoreDebug	(&hostCoreDebug)
+#define DBGMCU		(&hostDBGMCU)
+#define ITM			(&hostITM)
+#define DWT			(hostDWT())
+
+//registers bits
+#define DMA_ISR_GIF1					0x00000001U
+#define DMA_ISR_TCIF1					0x00000002U
+#define DMA_ISR_HTIF1					0x00000004U
+#define DMA_ISR_TEIF1					0x00000008U
+#define DMA_IFCR_CGIF1					0x00000001U
+#define DMA_CCR_EN						0x00000001U
+#define DMA_CCR_TCIE					0x00000002U
+#define DMA_CCR_TEIE					0x00000008U
+#define DMA_CCR_CIRC					0x00000020U
+#define DMA_CCR_MINC					0x00000080U
+#define SPI_CR1_SPE						0x00000040U
+#define SPI_CR2_RXDMAEN					0x00000001U
+#define SPI_CR2_TXDMAEN					0x00000002U
+#define SPI_SR_TXE						0x00000002U
+#define SPI_SR_OVR						0x00000040U
+#define SPI_SR_BSY						0x00000080U
+#define TIM_CR1_CEN						0x00000001U
+#define TIM_DIER_UIE					0x00000001U
+#define TIM_SR_UIF						0x00000001U
+#define USART_CR3_DMAT					0x00000080U
+#define DWT_CTRL_CYCCNTENA_Msk			0x00000001U
+#define CoreDebug_DEMCR_TRCENA_Msk		0x01000000U
+#define DBGMCU_CR_DBG_SLEEP				0x00000001U
+#define ITM_TCR_ITMENA_Msk				0x00000001U
+
+//core intrinsics (the exclusive monitor is cleared when an interrupt handler is entered, as on the target)
+static inline uint32_t __LDREXW(volatile uint32_t* address){
+    hostExclusiveMonitor = 1U;
+    return (*address);
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t* address){
+    if(!hostExclusiveMonitor)
+        return (1U);
+
+    hostExclusiveMonitor = 0;
+    *address = value;
+    return (0);
+}
+
+static inline void __CLREX(){
+    hostExclusiveMonitor = 0;
+}
+
+static inline void __DMB(){
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline uint8_t __CLZ(uint32_t value){
+    return (value ? (uint8_t)__builtin_clz(value) : 32U);
+}
+
+static inline uint32_t __get_PRIMASK(){
+    return (hostPRIMASK);
+}
+
+static inline void __set_PRIMASK(uint32_t priMask){
+    hostPRIMASK = priMask;
+    hostServeInterrupts();
+}
+
+static inline void __disable_irq(){
+    hostPRIMASK = 1U;
+}
+
+static inline void __enable_irq(){
+    hostPRIMASK = 0;
+    hostServeInterrupts();
+}
+
+static inline void __WFI(){
+    hostWaitForInterrupt();
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_H_ */
@@ -0,0 +1,16 @@
+/**
+ * @file stm32f1xx_ll_cortex.h
+ * @brief Host replacement of the Cortex-M3 core LL driver
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_CORTEX_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_CORTEX_H_
+#include "hostDevice.h"
+
+static inline void LL_SYSTICK_EnableIT(){
+    hostSpend(HOST_ACCESS_CYCLES);
+    hostEnableSysTick();
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_CORTEX_H_ */
@@ -0,0 +1,78 @@
+/**
+ * @file stm32f1xx_ll_dma.h
+ * @brief Host replacement of the DMA LL driver (the registers are stored, the transfers are started by the SPI DMA requests)
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_DMA_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_DMA_H_
+#include "stm32f1xx.h"
+
+#define LL_DMA_CHANNEL_1			1U
+#define LL_DMA_CHANNEL_2			2U
+#define LL_DMA_CHANNEL_3			3U
+#define LL_DMA_CHANNEL_4			4U
+#define LL_DMA_CHANNEL_5			5U
+#define LL_DMA_CHANNEL_6			6U
+#define LL_DMA_CHANNEL_7			7U
+#define LL_DMA_MODE_NORMAL			0U
+#define LL_DMA_MODE_CIRCULAR		DMA_CCR_CIRC
+#define LL_DMA_MEMORY_NOINCREMENT	0U
+#define LL_DMA_MEMORY_INCREMENT		DMA_CCR_MINC
+
+static inline void LL_DMA_EnableChannel(DMA_TypeDef* DMAx, uint32_t Channel){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CCR |= DMA_CCR_EN;
+}
+
+static inline void LL_DMA_DisableChannel(DMA_TypeDef* DMAx, uint32_t Channel){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CCR &= ~DMA_CCR_EN;
+}
+
+static inline uint32_t LL_DMA_IsEnabledChannel(DMA_TypeDef* DMAx, uint32_t Channel){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return ((DMAx->CHANNEL[Channel - 1U].CCR & DMA_CCR_EN) == DMA_CCR_EN);
+}
+
+static inline void LL_DMA_SetMode(DMA_TypeDef* DMAx, uint32_t Channel, uint32_t Mode){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CCR = (DMAx->CHANNEL[Channel - 1U].CCR & ~DMA_CCR_CIRC) | Mode;
+}
+
+static inline void LL_DMA_SetMemoryIncMode(DMA_TypeDef* DMAx, uint32_t Channel, uint32_t MemoryOrM2MDstIncMode){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CCR = (DMAx->CHANNEL[Channel - 1U].CCR & ~DMA_CCR_MINC) | MemoryOrM2MDstIncMode;
+}
+
+static inline void LL_DMA_SetDataLength(DMA_TypeDef* DMAx, uint32_t Channel, uint32_t NbData){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CNDTR = NbData;
+}
+
+static inline void LL_DMA_SetMemoryAddress(DMA_TypeDef* DMAx, uint32_t Channel, uint32_t MemoryAddress){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CMAR = MemoryAddress;
+}
+
+static inline void LL_DMA_SetPeriphAddress(DMA_TypeDef* DMAx, uint32_t Channel, uint32_t PeriphAddress){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CPAR = PeriphAddress;
+}
+
+static inline void LL_DMA_EnableIT_TC(DMA_TypeDef* DMAx, uint32_t Channel){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CCR |= DMA_CCR_TCIE;
+}
+
+static inline void LL_DMA_DisableIT_TC(DMA_TypeDef* DMAx, uint32_t Channel){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CCR &= ~DMA_CCR_TCIE;
+}
+
+static inline void LL_DMA_EnableIT_TE(DMA_TypeDef* DMAx, uint32_t Channel){
+    hostSpend(HOST_ACCESS_CYCLES);
+    DMAx->CHANNEL[Channel - 1U].CCR |= DMA_CCR_TEIE;
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_DMA_H_ */
@@ -0,0 +1,26 @@
+/**
+ * @file stm32f1xx_ll_exti.h
+ * @brief Host replacement of the EXTI LL driver
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_EXTI_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_EXTI_H_
+#include "stm32f1xx.h"
+
+#define LL_EXTI_LINE_0	(1U << 0)
+#define LL_EXTI_LINE_10	(1U << 10)
+#define LL_EXTI_LINE_11	(1U << 11)
+
+static inline uint32_t LL_EXTI_IsActiveFlag_0_31(uint32_t ExtiLine){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return ((EXTI->PR & ExtiLine) == ExtiLine);
+}
+
+//the pending register is cleared by writing ones
+static inline void LL_EXTI_ClearFlag_0_31(uint32_t ExtiLine){
+    hostSpend(HOST_ACCESS_CYCLES);
+    EXTI->PR &= ~ExtiLine;
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_EXTI_H_ */
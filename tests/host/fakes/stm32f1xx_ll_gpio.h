@@ -0,0 +1,48 @@
+/**
+ * @file stm32f1xx_ll_gpio.h
+ * @brief Host replacement of the GPIO LL driver (pins are plain bit masks)
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_GPIO_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_GPIO_H_
+#include "stm32f1xx.h"
+
+#define LL_GPIO_PIN_0	(1U << 0)
+#define LL_GPIO_PIN_1	(1U << 1)
+#define LL_GPIO_PIN_2	(1U << 2)
+#define LL_GPIO_PIN_3	(1U << 3)
+#define LL_GPIO_PIN_4	(1U << 4)
+#define LL_GPIO_PIN_5	(1U << 5)
+#define LL_GPIO_PIN_6	(1U << 6)
+#define LL_GPIO_PIN_7	(1U << 7)
+#define LL_GPIO_PIN_8	(1U << 8)
+#define LL_GPIO_PIN_9	(1U << 9)
+#define LL_GPIO_PIN_10	(1U << 10)
+#define LL_GPIO_PIN_11	(1U << 11)
+#define LL_GPIO_PIN_12	(1U << 12)
+#define LL_GPIO_PIN_13	(1U << 13)
+#define LL_GPIO_PIN_14	(1U << 14)
+#define LL_GPIO_PIN_15	(1U << 15)
+
+static inline void LL_GPIO_SetOutputPin(GPIO_TypeDef* GPIOx, uint32_t PinMask){
+    hostSpend(HOST_ACCESS_CYCLES);
+    GPIOx->ODR |= PinMask;
+}
+
+static inline void LL_GPIO_ResetOutputPin(GPIO_TypeDef* GPIOx, uint32_t PinMask){
+    hostSpend(HOST_ACCESS_CYCLES);
+    GPIOx->ODR &= ~PinMask;
+}
+
+static inline uint32_t LL_GPIO_IsOutputPinSet(GPIO_TypeDef* GPIOx, uint32_t PinMask){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return ((GPIOx->ODR & PinMask) == PinMask);
+}
+
+static inline uint32_t LL_GPIO_IsInputPinSet(GPIO_TypeDef* GPIOx, uint32_t PinMask){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return ((GPIOx->IDR & PinMask) == PinMask);
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_GPIO_H_ */
@@ -0,0 +1,18 @@
+/**
+ * @file stm32f1xx_ll_iwdg.h
+ * @brief Host replacement of the independent watchdog LL driver
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_IWDG_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_IWDG_H_
+#include "stm32f1xx.h"
+
+#define LL_IWDG_KEY_RELOAD	0x0000AAAAU
+
+static inline void LL_IWDG_ReloadCounter(IWDG_TypeDef* IWDGx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    IWDGx->KR = LL_IWDG_KEY_RELOAD;
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_IWDG_H_ */
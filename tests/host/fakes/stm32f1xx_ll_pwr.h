@@ -0,0 +1,11 @@
+/**
+ * @file stm32f1xx_ll_pwr.h
+ * @brief Host replacement of the power control LL driver (nothing used by the drivers built for the host)
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_PWR_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_PWR_H_
+#include "stm32f1xx.h"
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_PWR_H_ */
@@ -0,0 +1,23 @@
+/**
+ * @file stm32f1xx_ll_rtc.h
+ * @brief Host replacement of the RTC LL driver (backup registers only)
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_RTC_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_RTC_H_
+#include "stm32f1xx.h"
+
+#define LL_RTC_BKP_DR1	1U
+
+static inline void LL_RTC_BKP_SetRegister(BKP_TypeDef* BKPx, uint32_t BackupRegister, uint32_t Data){
+    hostSpend(HOST_ACCESS_CYCLES);
+    BKPx->DR[BackupRegister] = Data;
+}
+
+static inline uint32_t LL_RTC_BKP_GetRegister(BKP_TypeDef* BKPx, uint32_t BackupRegister){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return (BKPx->DR[BackupRegister]);
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_RTC_H_ */
@@ -0,0 +1,64 @@
+/**
+ * @file stm32f1xx_ll_spi.h
+ * @brief Host replacement of the SPI LL driver (the DMA transfers are carried out by hostDevice.c)
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_SPI_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_SPI_H_
+#include "hostDevice.h"
+
+static inline void LL_SPI_Enable(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    SPIx->CR1 |= SPI_CR1_SPE;
+}
+
+static inline void LL_SPI_Disable(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    SPIx->CR1 &= ~SPI_CR1_SPE;
+}
+
+static inline void LL_SPI_EnableDMAReq_TX(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    SPIx->CR2 |= SPI_CR2_TXDMAEN;
+    hostSPIstart(SPIx);
+}
+
+static inline void LL_SPI_DisableDMAReq_TX(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    SPIx->CR2 &= ~SPI_CR2_TXDMAEN;
+    hostSPIstop(SPIx);
+}
+
+static inline void LL_SPI_EnableDMAReq_RX(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    SPIx->CR2 |= SPI_CR2_RXDMAEN;
+}
+
+static inline void LL_SPI_DisableDMAReq_RX(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    SPIx->CR2 &= ~SPI_CR2_RXDMAEN;
+}
+
+static inline uint32_t LL_SPI_IsActiveFlag_TXE(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return ((SPIx->SR & SPI_SR_TXE) == SPI_SR_TXE);
+}
+
+static inline uint32_t LL_SPI_IsActiveFlag_BSY(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return ((SPIx->SR & SPI_SR_BSY) == SPI_SR_BSY);
+}
+
+static inline void LL_SPI_ClearFlag_OVR(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    SPIx->SR &= ~SPI_SR_OVR;
+}
+
+//the DMA registers hold 32 bits addresses : the host build is linked so that the ones of the drivers fit (see CMakeLists.txt)
+static inline uint32_t LL_SPI_DMA_GetRegAddr(SPI_TypeDef* SPIx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return ((uint32_t)(uintptr_t)&SPIx->DR);
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_SPI_H_ */
@@ -0,0 +1,27 @@
+/**
+ * @file stm32f1xx_ll_tim.h
+ * @brief Host replacement of the timers LL driver
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_TIM_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_TIM_H_
+#include "hostDevice.h"
+
+static inline void LL_TIM_EnableCounter(TIM_TypeDef* TIMx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    TIMx->CR1 |= TIM_CR1_CEN;
+    hostTimerStart(TIMx);
+}
+
+static inline void LL_TIM_EnableIT_UPDATE(TIM_TypeDef* TIMx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    TIMx->DIER |= TIM_DIER_UIE;
+}
+
+static inline void LL_TIM_ClearFlag_UPDATE(TIM_TypeDef* TIMx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    TIMx->SR &= ~TIM_SR_UIF;
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_TIM_H_ */
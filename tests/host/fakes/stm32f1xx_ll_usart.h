@@ -0,0 +1,22 @@
+/**
+ * @file stm32f1xx_ll_usart.h
+ * @brief Host replacement of the USART LL driver
+ * @author Gilles Henrard
+ * @date 14/10/2026
+ */
+#ifndef TESTS_HOST_FAKES_STM32F1XX_LL_USART_H_
+#define TESTS_HOST_FAKES_STM32F1XX_LL_USART_H_
+#include "stm32f1xx.h"
+
+static inline void LL_USART_EnableDMAReq_TX(USART_TypeDef* USARTx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    USARTx->CR3 |= USART_CR3_DMAT;
+}
+
+//the DMA registers hold 32 bits addresses (the telemetry transfers are not simulated, see hostDevice.c)
+static inline uint32_t LL_USART_DMA_GetRegAddr(USART_TypeDef* USARTx){
+    hostSpend(HOST_ACCESS_CYCLES);
+    return ((uint32_t)(uintptr_t)&USARTx->DR);
+}
+
+#endif /* TESTS_HOST_FAKES_STM32F1XX_LL_USART_H_ */
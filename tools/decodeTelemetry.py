@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+#############################################################################################################################
+# file:  decodeTelemetry.py
+# date:  14/10/2026
+# brief: Decode the raw samples telemetry stream sent by the inclinometer over USART2 (see Core/Src/telemetry/telemetry.c)
+#
+# usage: decodeTelemetry.py --port /dev/ttyUSB0 [--baud 460800] [--output samples.csv]
+#        decodeTelemetry.py --input capture.bin [--output samples.csv]
+#
+#        Each sample is written as a CSV line : frame sequence, timestamp (ms), sample index in the frame, X, Y, Z (raw LSB).
+#        Frames lost (sequence gaps) and corrupted (bad CRC) are counted and reported on stderr.
+#        Reading from a serial port requires pyserial.
+#############################################################################################################################
+import argparse
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+SAMPLES_PER_FRAME = 16
+NB_AXIS = 3
+FRAME_SIZE = 2 + 2 + 4 + (SAMPLES_PER_FRAME * NB_AXIS * 2) + 2
+HEADER = struct.Struct("<HI")
+SAMPLES = struct.Struct("<" + "h" * (SAMPLES_PER_FRAME * NB_AXIS))
+CRC = struct.Struct("<H")
+
+
+def crc16_ccitt_false(data):
+    """Compute the CRC-16/CCITT-FALSE of a buffer (polynomial 0x1021, initial value 0xFFFF)"""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class Decoder:
+    """Resynchronise on the frames in a byte stream, and decode the samples of the valid ones"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.expectedSequence = None
+        self.nbFrames = 0
+        self.nbLost = 0
+        self.nbCorrupted = 0
+
+    def feed(self, data):
+        """Add bytes received, and yield (sequence, timestamp_ms, index, x, y, z) for each sample decoded"""
+        self.buffer += data
+
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                #keep the last byte, in case it is the first half of a synchronisation word
+                del self.buffer[:-1]
+                return
+            if len(self.buffer) - start < FRAME_SIZE:
+                del self.buffer[:start]
+                return
+
+            frame = bytes(self.buffer[start:start + FRAME_SIZE])
+            (crc,) = CRC.unpack_from(frame, FRAME_SIZE - 2)
+            if crc16_ccitt_false(frame[2:FRAME_SIZE - 2]) != crc:
+                #not a frame (or a corrupted one), look for the next synchronisation word
+                self.nbCorrupted += 1
+                del self.buffer[:start + 1]
+                continue
+
+            del self.buffer[:start + FRAME_SIZE]
+            sequence, timestamp = HEADER.unpack_from(frame, 2)
+            if self.expectedSequence is not None:
+                self.nbLost += (sequence - self.expectedSequence) & 0xFFFF
+            self.expectedSequence = (sequence + 1) & 0xFFFF
+            self.nbFrames += 1
+
+            values = SAMPLES.unpack_from(frame, 8)
+            for index in range(SAMPLES_PER_FRAME):
+                axis = index * NB_AXIS
+                yield (sequence, timestamp, index) + values[axis:axis + NB_AXIS]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the inclinometer raw samples telemetry stream")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port on which the stream is received")
+    source.add_argument("--input", help="binary capture of the stream ('-' for stdin)")
+    parser.add_argument("--baud", type=int, default=460800, help="serial port baud rate (default: 460800)")
+    parser.add_argument("--output", help="CSV file in which write the samples (default: stdout)")
+    args = parser.parse_args()
+
+    if args.port:
+        import serial
+        stream = serial.Serial(args.port, args.baud, timeout=1)
+    elif args.input == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.input, "rb")
+
+    output = open(args.output, "w") if args.output else sys.stdout
+    output.write("sequence,timestamp_ms,index,x,y,z\n")
+
+    decoder = Decoder()
+    try:
+        while True:
+            data = stream.read(4096)
+            if not data:
+                if args.port:
+                    continue
+                break
+            for sample in decoder.feed(data):
+                output.write(",".join(str(value) for value in sample) + "\n")
+    except KeyboardInterrupt:
+        pass
+    finally:
+        output.flush()
+        print(f"{decoder.nbFrames} frames decoded, {decoder.nbLost} lost, {decoder.nbCorrupted} CRC mismatches", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()